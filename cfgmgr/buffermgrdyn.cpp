@@ -1,6 +1,7 @@
 #include <fstream>
 #include <iostream>
 #include <string.h>
+#include <cmath>
 #include "logger.h"
 #include "dbconnector.h"
 #include "producerstatetable.h"
@@ -48,7 +49,13 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         m_applPortTable(applDb, APP_PORT_TABLE_NAME),
         m_portInitDone(false),
         m_firstTimeCalculateBufferPool(true),
-        m_mmuSizeNumber(0)
+        m_mmuSizeNumber(0),
+        m_headroomCalculatorSupported(false),
+        m_headroomCalculatorValidated(false),
+        m_headroomParam(),
+        m_stateAsicTable(stateDb, ASIC_TABLE_NAME),
+        m_cfgLosslessTrafficPatternTable(cfgDb, LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
+        m_bufferPoolCheckPending(false)
 {
     SWSS_LOG_ENTER();
 
@@ -85,6 +92,9 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         return;
     }
 
+    // The headroom plugins of these vendors share the formula of the in-process calculator
+    m_headroomCalculatorSupported = (platform == "mellanox" || platform == "vs");
+
     // Init timer
     auto interv = timespec { .tv_sec = BUFFERMGR_TIMER_PERIOD, .tv_nsec = 0 };
     m_buffermgrPeriodtimer = new SelectableTimer(interv);
@@ -274,13 +284,173 @@ string BufferMgrDynamic::getPgPoolMode()
 }
 
 // Meta flows which are called by main flows
-void BufferMgrDynamic::calculateHeadroomSize(const string &speed, const string &cable, const string &port_mtu, const string &gearbox_model, buffer_profile_t &headroom)
+void BufferMgrDynamic::calculateHeadroomSize(const string &speed, const string &cable, const string &port_mtu, const string &threshold, const string &gearbox_model, buffer_profile_t &headroom)
+{
+    auto profileName = getDynamicProfileName(speed, cable, port_mtu, threshold, gearbox_model);
+    buffer_headroom_t result;
+
+    auto memo = m_headroomLookup.find(profileName);
+    if (memo != m_headroomLookup.end())
+    {
+        result = memo->second;
+    }
+    else
+    {
+        bool calculated = m_headroomCalculatorSupported && calculateHeadroomInProcess(speed, cable, port_mtu, result);
+
+        if (!calculated || !m_headroomCalculatorValidated)
+        {
+            buffer_headroom_t pluginResult;
+            calculateHeadroomByPlugin(profileName, speed, cable, port_mtu, pluginResult);
+
+            if (!calculated)
+            {
+                result = pluginResult;
+            }
+            else if (!pluginResult.size.empty())
+            {
+                m_headroomCalculatorValidated = true;
+                if (pluginResult.xon != result.xon || pluginResult.xoff != result.xoff || pluginResult.size != result.size)
+                {
+                    SWSS_LOG_ERROR("Headroom calculated in-process for %s (xon %s xoff %s size %s) differs from the plugin (xon %s xoff %s size %s), using the plugin from now on",
+                                   profileName.c_str(),
+                                   result.xon.c_str(), result.xoff.c_str(), result.size.c_str(),
+                                   pluginResult.xon.c_str(), pluginResult.xoff.c_str(), pluginResult.size.c_str());
+                    m_headroomCalculatorSupported = false;
+                    result = pluginResult;
+                }
+            }
+        }
+
+        if (!result.size.empty())
+        {
+            m_headroomLookup[profileName] = result;
+        }
+    }
+
+    headroom.xon = result.xon;
+    headroom.xoff = result.xoff;
+    headroom.size = result.size;
+    headroom.xon_offset = result.xon_offset;
+}
+
+bool BufferMgrDynamic::loadHeadroomParameters()
+{
+    if (m_headroomParam.ready)
+    {
+        return true;
+    }
+
+    // Only one key should exist in each of the tables
+    vector<string> keys;
+    vector<FieldValueTuple> asicInfo, trafficPattern;
+
+    m_stateAsicTable.getKeys(keys);
+    if (keys.empty() || !m_stateAsicTable.get(keys[0], asicInfo))
+    {
+        return false;
+    }
+
+    keys.clear();
+    m_cfgLosslessTrafficPatternTable.getKeys(keys);
+    if (keys.empty() || !m_cfgLosslessTrafficPatternTable.get(keys[0], trafficPattern))
+    {
+        return false;
+    }
+
+    map<string, double> values;
+    for (auto &fv : asicInfo)
+    {
+        values[fvField(fv)] = atof(fvValue(fv).c_str());
+    }
+    for (auto &fv : trafficPattern)
+    {
+        values[fvField(fv)] = atof(fvValue(fv).c_str());
+    }
+
+    for (auto field : {"cell_size", "pipeline_latency", "mac_phy_delay", "peer_response_time", "mtu", "small_packet_percentage"})
+    {
+        if (values.find(field) == values.end())
+        {
+            SWSS_LOG_INFO("Headroom parameter %s isn't available yet", field);
+            return false;
+        }
+    }
+
+    m_headroomParam.cell_size = values["cell_size"];
+    m_headroomParam.pipeline_latency = values["pipeline_latency"] * 1024;
+    m_headroomParam.mac_phy_delay = values["mac_phy_delay"] * 1024;
+    m_headroomParam.peer_response_time = values["peer_response_time"] * 1024;
+    m_headroomParam.lossless_mtu = values["mtu"];
+    m_headroomParam.small_packet_percentage = values["small_packet_percentage"];
+    m_headroomParam.ready = true;
+
+    return true;
+}
+
+// Same formula as buffer_headroom_<vendor>.lua of the supported vendors
+bool BufferMgrDynamic::calculateHeadroomInProcess(const string &speed, const string &cable, const string &port_mtu, buffer_headroom_t &headroom)
+{
+    if (!loadHeadroomParameters() || cable.size() < 2)
+    {
+        return false;
+    }
+
+    const double speedOfLight = 198000000;
+    const double minimalPacketSize = 64;
+    auto &param = m_headroomParam;
+
+    double portSpeed = atof(speed.c_str());
+    // Strip the unit of the cable length, like "5m"
+    double cableLength = atof(cable.substr(0, cable.size() - 1).c_str());
+    double portMtu = atof(port_mtu.c_str());
+    double gearboxDelay = atof(m_identifyGearboxDelay.c_str());
+
+    double pipelineLatency = param.pipeline_latency;
+    double speedOverhead = 0;
+
+    // Adjustment for 400G
+    if (portSpeed == 400000)
+    {
+        pipelineLatency = 37 * 1024;
+        speedOverhead = portMtu;
+    }
+
+    double worstCaseFactor;
+    if (param.cell_size > 2 * minimalPacketSize)
+    {
+        worstCaseFactor = param.cell_size / minimalPacketSize;
+    }
+    else
+    {
+        worstCaseFactor = (2 * param.cell_size) / (1 + param.cell_size);
+    }
+
+    double cellOccupancy = (100 - param.small_packet_percentage + param.small_packet_percentage * worstCaseFactor) / 100;
+    double bytesOnGearbox = portSpeed * gearboxDelay / (8 * 1024);
+    double bytesOnCable = 2 * cableLength * portSpeed * 1000000000 / speedOfLight / (8 * 1024);
+    double propagationDelay = portMtu + bytesOnCable + 2 * bytesOnGearbox + param.mac_phy_delay + param.peer_response_time;
+
+    // Calculate the xoff and xon and then round up at 1024 bytes
+    double xoff = ceil((param.lossless_mtu + propagationDelay * cellOccupancy) / 1024) * 1024;
+    double xon = ceil(pipelineLatency / 1024) * 1024;
+    double size = ceil((xoff + xon + speedOverhead) / 1024) * 1024;
+
+    headroom.xon = to_string(static_cast<uint64_t>(xon));
+    headroom.xoff = to_string(static_cast<uint64_t>(xoff));
+    headroom.size = to_string(static_cast<uint64_t>(size));
+    headroom.xon_offset.clear();
+
+    return true;
+}
+
+void BufferMgrDynamic::calculateHeadroomByPlugin(const string &profile_name, const string &speed, const string &cable, const string &port_mtu, buffer_headroom_t &headroom)
 {
     // Call vendor-specific lua plugin to calculate the xon, xoff, xon_offset, size and threshold
     vector<string> keys = {};
     vector<string> argv = {};
 
-    keys.emplace_back(headroom.name);
+    keys.emplace_back(profile_name);
     argv.emplace_back(speed);
     argv.emplace_back(cable);
     argv.emplace_back(port_mtu);
@@ -369,6 +539,8 @@ void BufferMgrDynamic::recalculateSharedBufferPool()
 
 void BufferMgrDynamic::checkSharedBufferPoolSize()
 {
+    m_bufferPoolCheckPending = false;
+
     // PortInitDone indicates all steps of port initialization has been done
     // Only after that does the buffer pool size update starts
     if (!m_portInitDone)
@@ -403,6 +575,13 @@ void BufferMgrDynamic::checkSharedBufferPoolSize()
         recalculateSharedBufferPool();
 }
 
+// Each run of buffer_pool_<vendor>.lua walks all the buffer tables, so the check
+// is deferred to the end of the batch of updates which requests it
+void BufferMgrDynamic::scheduleSharedBufferPoolSizeCheck()
+{
+    m_bufferPoolCheckPending = true;
+}
+
 // For buffer pool, only size can be updated on-the-fly
 void BufferMgrDynamic::updateBufferPoolToDb(const string &name, const buffer_pool_t &pool)
 {
@@ -498,7 +677,7 @@ task_process_status BufferMgrDynamic::allocateProfile(const string &speed, const
 
         // Call vendor-specific lua plugin to calculate the xon, xoff, xon_offset, size
         // Pay attention, the threshold can contain valid value
-        calculateHeadroomSize(speed, cable, mtu, gearbox_model, profile);
+        calculateHeadroomSize(speed, cable, mtu, threshold, gearbox_model, profile);
 
         profile.threshold = threshold;
         profile.dynamic_calculated = true;
@@ -746,7 +925,7 @@ task_process_status BufferMgrDynamic::refreshPriorityGroupsForPort(const string
 
     if (isHeadroomUpdated)
     {
-        checkSharedBufferPoolSize();
+        scheduleSharedBufferPoolSizeCheck();
     }
     else
     {
@@ -830,7 +1009,7 @@ task_process_status BufferMgrDynamic::doRemovePgTask(const string &pg_key, const
     SWSS_LOG_NOTICE("Remove BUFFER_PG %s (profile %s, %s)", pg_key.c_str(), bufferPg.running_profile_name.c_str(), bufferPg.configured_profile_name.c_str());
 
     // recalculate pool size
-    checkSharedBufferPoolSize();
+    scheduleSharedBufferPoolSizeCheck();
 
     if (!portInfo.speed.empty() && !portInfo.cable_length.empty())
         portInfo.state = PORT_READY;
@@ -895,7 +1074,7 @@ task_process_status BufferMgrDynamic::doUpdateStaticProfileTask(buffer_profile_t
         updateBufferProfileToDb(profileName, profile);
     }
 
-    checkSharedBufferPoolSize();
+    scheduleSharedBufferPoolSizeCheck();
 
     return task_process_status::task_success;
 }
@@ -1128,7 +1307,7 @@ task_process_status BufferMgrDynamic::handlePortTable(KeyOpFieldsValuesTuple &tu
         else if (admin_status_updated)
         {
             SWSS_LOG_INFO("Recalculate shared buffer pool size due to port %s's admin_status updated", port.c_str());
-            checkSharedBufferPoolSize();
+            scheduleSharedBufferPoolSizeCheck();
         }
     }
 
@@ -1653,6 +1832,11 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    if (m_bufferPoolCheckPending)
+    {
+        checkSharedBufferPoolSize();
+    }
 }
 
 void BufferMgrDynamic::doTask(SelectableTimer &timer)
@@ -16,6 +16,9 @@ namespace swss {
 
 #define BUFFERMGR_TIMER_PERIOD 10
 
+#define ASIC_TABLE_NAME                     "ASIC_TABLE"
+#define LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME "LOSSLESS_TRAFFIC_PATTERN"
+
 typedef struct {
     bool ingress;
     bool dynamic_size;
@@ -86,6 +89,25 @@ typedef struct {
 //    std::string profile_name;
 } port_info_t;
 
+typedef struct {
+    std::string xon;
+    std::string xon_offset;
+    std::string xoff;
+    std::string size;
+} buffer_headroom_t;
+
+// Parameters of the headroom formula, fetched from
+// STATE_DB.ASIC_TABLE and CONFIG_DB.LOSSLESS_TRAFFIC_PATTERN
+typedef struct {
+    bool ready;
+    double cell_size;
+    double pipeline_latency;
+    double mac_phy_delay;
+    double peer_response_time;
+    double lossless_mtu;
+    double small_packet_percentage;
+} headroom_param_t;
+
 //TODO:
 //add map to store all configured PGs
 //add map to store all configured profiles
@@ -107,6 +129,9 @@ typedef std::map<std::string, buffer_pg_t> buffer_pg_lookup_t;
 typedef std::map<std::string, buffer_pg_lookup_t> port_pg_lookup_t;
 //map from gearbox model to gearbox delay
 typedef std::map<std::string, std::string> gearbox_delay_t;
+//map from dynamic profile name to the headroom calculated for it
+//the name identifies speed, cable length, mtu, threshold and gearbox model
+typedef std::map<std::string, buffer_headroom_t> headroom_lookup_t;
 
 class BufferMgrDynamic : public Orch
 {
@@ -186,6 +211,21 @@ private:
     std::string m_bufferpoolSha;
     std::string m_checkHeadroomSha;
 
+    // Headroom calculator
+    // The formula of the known vendors' headroom plugin is calculated in-process,
+    // it is validated against the plugin once, which is used for the other vendors
+    // Results are memoized, the inputs of the formula are static
+    bool m_headroomCalculatorSupported;
+    bool m_headroomCalculatorValidated;
+    headroom_param_t m_headroomParam;
+    headroom_lookup_t m_headroomLookup;
+    Table m_stateAsicTable;
+    Table m_cfgLosslessTrafficPatternTable;
+
+    // Set by the updates which affect the shared buffer pool size
+    // The pool is recalculated once the whole batch of updates is handled
+    bool m_bufferPoolCheckPending;
+
     // Parameters for headroom generation
     std::string m_mmuSize;
     unsigned long m_mmuSizeNumber;
@@ -209,8 +249,12 @@ private:
     void updateBufferPgToDb(const std::string &key, const std::string &profile, bool add);
 
     // Meta flows
-    void calculateHeadroomSize(const std::string &speed, const std::string &cable, const std::string &port_mtu, const std::string &gearbox_model, buffer_profile_t &headroom);
+    void calculateHeadroomSize(const std::string &speed, const std::string &cable, const std::string &port_mtu, const std::string &threshold, const std::string &gearbox_model, buffer_profile_t &headroom);
+    bool loadHeadroomParameters();
+    bool calculateHeadroomInProcess(const std::string &speed, const std::string &cable, const std::string &port_mtu, buffer_headroom_t &headroom);
+    void calculateHeadroomByPlugin(const std::string &profile_name, const std::string &speed, const std::string &cable, const std::string &port_mtu, buffer_headroom_t &headroom);
     void checkSharedBufferPoolSize();
+    void scheduleSharedBufferPoolSizeCheck();
     void recalculateSharedBufferPool();
     task_process_status allocateProfile(const std::string &speed, const std::string &cable, const std::string &mtu, const std::string &threshold, const std::string &gearbox_model, std::string &profile_name);
     void releaseProfile(const std::string &profile_name);
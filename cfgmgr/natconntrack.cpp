@@ -0,0 +1,281 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netlink/netlink.h>
+#include <netlink/attr.h>
+#include <netlink/msg.h>
+#include <netlink/netfilter/ct.h>
+#include <linux/netfilter/nfnetlink.h>
+#include <linux/netfilter/nfnetlink_conntrack.h>
+#include <linux/netfilter/nf_conntrack_common.h>
+#include <linux/netfilter/nf_conntrack_tcp.h>
+
+#include "logger.h"
+#include "natconntrack.h"
+
+using namespace std;
+using namespace swss;
+
+static bool setCtAddr(struct nfnl_ct *ct, int repl, bool src, const string &ip)
+{
+    struct nl_addr *addr = NULL;
+    int err;
+
+    if ((err = nl_addr_parse(ip.c_str(), AF_INET, &addr)) < 0)
+    {
+        SWSS_LOG_ERROR("Invalid conntrack address %s, error '%s'", ip.c_str(), nl_geterror(err));
+        return false;
+    }
+
+    err = src ? nfnl_ct_set_src(ct, repl, addr) : nfnl_ct_set_dst(ct, repl, addr);
+    nl_addr_put(addr);
+
+    return (err >= 0);
+}
+
+/* Same attributes as the conntrack tool sends for --src-nat/--dst-nat */
+static int putNatAttrs(struct nl_msg *msg, int type, const string &ip, uint16_t port)
+{
+    struct nlattr *nat, *proto;
+    struct in_addr addr;
+
+    if (inet_pton(AF_INET, ip.c_str(), &addr) != 1)
+    {
+        return -NLE_INVAL;
+    }
+
+    if (!(nat = nla_nest_start(msg, type)))
+    {
+        return -NLE_MSGSIZE;
+    }
+    NLA_PUT_U32(msg, CTA_NAT_V4_MINIP, addr.s_addr);
+    NLA_PUT_U32(msg, CTA_NAT_V4_MAXIP, addr.s_addr);
+
+    if (port)
+    {
+        if (!(proto = nla_nest_start(msg, CTA_NAT_PROTO)))
+        {
+            return -NLE_MSGSIZE;
+        }
+        NLA_PUT_U16(msg, CTA_PROTONAT_PORT_MIN, htons(port));
+        NLA_PUT_U16(msg, CTA_PROTONAT_PORT_MAX, htons(port));
+        nla_nest_end(msg, proto);
+    }
+    nla_nest_end(msg, nat);
+
+    return 0;
+
+nla_put_failure:
+    return -NLE_MSGSIZE;
+}
+
+static int putTcpStateAttrs(struct nl_msg *msg, uint8_t state)
+{
+    struct nlattr *info, *tcp;
+
+    if (!(info = nla_nest_start(msg, CTA_PROTOINFO)))
+    {
+        return -NLE_MSGSIZE;
+    }
+    if (!(tcp = nla_nest_start(msg, CTA_PROTOINFO_TCP)))
+    {
+        return -NLE_MSGSIZE;
+    }
+    NLA_PUT_U8(msg, CTA_PROTOINFO_TCP_STATE, state);
+    nla_nest_end(msg, tcp);
+    nla_nest_end(msg, info);
+
+    return 0;
+
+nla_put_failure:
+    return -NLE_MSGSIZE;
+}
+
+NatConntrackBatch::NatConntrackBatch()
+{
+    int err = 0;
+
+    m_nl_sock = nl_socket_alloc();
+    if (!m_nl_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket alloc failed");
+    }
+    else if ((err = nl_connect(m_nl_sock, NETLINK_NETFILTER)) < 0)
+    {
+        SWSS_LOG_ERROR("Netlink socket connect failed, error '%s'", nl_geterror(err));
+        nl_socket_free(m_nl_sock);
+        m_nl_sock = NULL;
+    }
+}
+
+NatConntrackBatch::~NatConntrackBatch()
+{
+    for (auto msg : m_msgs)
+    {
+        nlmsg_free(msg);
+    }
+
+    if (m_nl_sock)
+    {
+        nl_socket_free(m_nl_sock);
+    }
+}
+
+void NatConntrackBatch::addEntry(const NatConntrackEntry &entry)
+{
+    queueMessage(entry, true);
+}
+
+void NatConntrackBatch::refreshEntry(const NatConntrackEntry &entry)
+{
+    queueMessage(entry, false);
+}
+
+void NatConntrackBatch::queueMessage(const NatConntrackEntry &entry, bool create)
+{
+    struct nfnl_ct *ct = nfnl_ct_alloc();
+    struct nl_msg  *msg = NULL;
+    int             err = 0;
+
+    if (!ct)
+    {
+        SWSS_LOG_ERROR("Failed to allocate conntrack object");
+        return;
+    }
+
+    nfnl_ct_set_family(ct, AF_INET);
+    nfnl_ct_set_proto(ct, entry.protocol);
+    nfnl_ct_set_timeout(ct, entry.timeout);
+
+    if (!setCtAddr(ct, 0, true, entry.src_ip) || !setCtAddr(ct, 0, false, entry.dst_ip))
+    {
+        nfnl_ct_put(ct);
+        return;
+    }
+    nfnl_ct_set_src_port(ct, 0, entry.src_port);
+    nfnl_ct_set_dst_port(ct, 0, entry.dst_port);
+
+    if (create)
+    {
+        /* The kernel wants both tuples on creation, the reply tuple is the
+         * inverted original one and gets translated by the NAT attributes */
+        if (!setCtAddr(ct, 1, true, entry.dst_ip) || !setCtAddr(ct, 1, false, entry.src_ip))
+        {
+            nfnl_ct_put(ct);
+            return;
+        }
+        nfnl_ct_set_src_port(ct, 1, entry.dst_port);
+        nfnl_ct_set_dst_port(ct, 1, entry.src_port);
+        nfnl_ct_set_status(ct, IPS_ASSURED);
+
+        err = nfnl_ct_build_add_request(ct, NLM_F_CREATE | NLM_F_EXCL, &msg);
+    }
+    else
+    {
+        err = nfnl_ct_build_add_request(ct, 0, &msg);
+    }
+    nfnl_ct_put(ct);
+
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Failed to build conntrack message for src %s:%u, dst %s:%u, error '%s'",
+                       entry.src_ip.c_str(), entry.src_port, entry.dst_ip.c_str(), entry.dst_port, nl_geterror(err));
+        return;
+    }
+
+    if (create)
+    {
+        if (!entry.snat_ip.empty())
+        {
+            err = putNatAttrs(msg, CTA_NAT_SRC, entry.snat_ip, entry.snat_port);
+        }
+        if ((err == 0) && !entry.dnat_ip.empty())
+        {
+            err = putNatAttrs(msg, CTA_NAT_DST, entry.dnat_ip, entry.dnat_port);
+        }
+        if ((err == 0) && (entry.protocol == IPPROTO_TCP) && entry.established)
+        {
+            err = putTcpStateAttrs(msg, TCP_CONNTRACK_ESTABLISHED);
+        }
+
+        if (err < 0)
+        {
+            SWSS_LOG_ERROR("Failed to build conntrack NAT attributes for src %s:%u, dst %s:%u, error '%s'",
+                           entry.src_ip.c_str(), entry.src_port, entry.dst_ip.c_str(), entry.dst_port, nl_geterror(err));
+            nlmsg_free(msg);
+            return;
+        }
+    }
+
+    m_msgs.push_back(msg);
+}
+
+bool NatConntrackBatch::flush()
+{
+    bool   rc = true;
+    size_t sent = 0;
+    int    err;
+
+    if (m_msgs.empty())
+    {
+        return true;
+    }
+
+    if (!m_nl_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket null pointer, dropping %zu conntrack messages", m_msgs.size());
+        for (auto msg : m_msgs)
+        {
+            nlmsg_free(msg);
+        }
+        m_msgs.clear();
+        return false;
+    }
+
+    SWSS_LOG_INFO("Sending %zu conntrack messages", m_msgs.size());
+
+    while (sent < m_msgs.size())
+    {
+        size_t window = min(m_msgs.size() - sent, static_cast<size_t>(NAT_CONNTRACK_BATCH_WINDOW));
+        size_t pending = 0;
+
+        for (size_t i = sent; i < sent + window; i++)
+        {
+            if ((err = nl_send_auto(m_nl_sock, m_msgs[i])) < 0)
+            {
+                SWSS_LOG_ERROR("Netlink send message failed, error '%s'", nl_geterror(err));
+                rc = false;
+                continue;
+            }
+            pending++;
+        }
+
+        /* Acks come back in the order of the requests */
+        while (pending--)
+        {
+            err = nl_wait_for_ack(m_nl_sock);
+            if (err == -NLE_EXIST)
+            {
+                SWSS_LOG_INFO("Conntrack entry already exists");
+            }
+            else if (err == -NLE_OBJ_NOTFOUND)
+            {
+                SWSS_LOG_INFO("Conntrack entry to refresh does not exist");
+            }
+            else if (err < 0)
+            {
+                SWSS_LOG_ERROR("Conntrack request failed, error '%s'", nl_geterror(err));
+                rc = false;
+            }
+        }
+
+        sent += window;
+    }
+
+    for (auto msg : m_msgs)
+    {
+        nlmsg_free(msg);
+    }
+    m_msgs.clear();
+
+    return rc;
+}
@@ -0,0 +1,63 @@
+#ifndef __NATCONNTRACK__
+#define __NATCONNTRACK__
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+struct nl_sock;
+struct nl_msg;
+
+namespace swss {
+
+/* Max conntrack messages in flight before their acks are collected,
+ * keeps the acks within the netlink socket receive buffer */
+#define NAT_CONNTRACK_BATCH_WINDOW   64
+
+/* Conntrack entry of a static NAT/NAPT entry, the original direction tuple
+ * with the source and/or destination translation applied to it */
+struct NatConntrackEntry
+{
+    uint8_t      protocol = 0;
+    std::string  src_ip;
+    uint16_t     src_port = 0;
+    std::string  dst_ip;
+    uint16_t     dst_port = 0;
+    std::string  snat_ip;               // Empty if the source is not translated
+    uint16_t     snat_port = 0;
+    std::string  dnat_ip;               // Empty if the destination is not translated
+    uint16_t     dnat_port = 0;
+    uint32_t     timeout = 0;
+    bool         established = false;   // TCP state of the entry
+};
+
+/* Queues conntrack entry changes as ctnetlink messages and sends them to the
+ * kernel in one go, instead of running the conntrack tool once per entry */
+class NatConntrackBatch
+{
+public:
+    NatConntrackBatch();
+    ~NatConntrackBatch();
+
+    /* Queue the creation of the entry, fails in the kernel if it exists */
+    void addEntry(const NatConntrackEntry &entry);
+    /* Queue the refresh of the timeout of an existing entry */
+    void refreshEntry(const NatConntrackEntry &entry);
+    /* Send the queued messages, returns false if any of them failed */
+    bool flush();
+
+    size_t size() const
+    {
+        return m_msgs.size();
+    }
+
+private:
+    struct nl_sock *m_nl_sock;
+    std::vector<struct nl_msg *> m_msgs;
+
+    void queueMessage(const NatConntrackEntry &entry, bool create);
+};
+
+}
+
+#endif /* __NATCONNTRACK__ */
@@ -15,6 +15,7 @@
  */
 
 #include <string.h>
+#include <netinet/in.h>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
@@ -357,6 +358,10 @@ void NatMgr::flushAllNatEntries(void)
 {
     std::string res;
     const std::string cmds = std::string("") + CONNTRACK_CMD + FLUSH;
+
+    /* Send the queued conntrack entries first, to keep the order of the changes */
+    m_conntrackBatch.flush();
+
     int ret = swss::exec(cmds, res);
 
     if (ret)
@@ -453,253 +458,200 @@ void NatMgr::updateDynamicTwiceNaptConnTrackTimeout(string key, int timeout)
                   prototype.c_str(), src_ip.to_string().c_str(), src_l4_port, dst_ip.to_string().c_str(), dst_l4_port, timeout);
 }
 
-/* To Add a dummy conntrack entry for the Static Single NAT entry in the kernel */
-void NatMgr::addConntrackStaticSingleNatEntry(const string &key)
+/* To get the protocol number of the conntrack entry from the config key protocol */
+static uint8_t getConntrackProtocol(const string &prototype)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD; 
-    int timeout = NAT_TIMEOUT_MAX;
-
-    if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
-    {
-        SWSS_LOG_INFO("Add static NAT conntrack entry with src-ip %s, timeout %d",
-                      m_staticNatEntry[key].local_ip.c_str(), timeout);
-
-        cmds += (" -I -n " + key + ":1 -g 127.0.0.1:127" + " -p udp -t " + to_string(timeout) +
-                 " --src " + m_staticNatEntry[key].local_ip + " --sport 1 --dst 127.0.0.1 --dport 127 -u ASSURED " + REDIRECT_TO_DEV_NULL);
-    }
-    else if (m_staticNatEntry[key].nat_type == SNAT_NAT_TYPE)
-    {
-        SWSS_LOG_INFO("Add static NAT conntrack entry with src-ip %s, timeout %d",
-                      key.c_str(), timeout);
+    return static_cast<uint8_t>((prototype == to_upper(IP_PROTOCOL_TCP)) ? IPPROTO_TCP : IPPROTO_UDP);
+}
 
-        cmds += (" -I -n " + m_staticNatEntry[key].local_ip + ":1 -g 127.0.0.1:127" + " -p udp -t " + to_string(timeout) +
-                 " --src " + key + " --sport 1 --dst 127.0.0.1 --dport 127 -u ASSURED " + REDIRECT_TO_DEV_NULL);
-    }
+/* To get the dummy conntrack entry of the Static Single NAT entry */
+NatConntrackEntry NatMgr::getConntrackStaticSingleNatEntry(const string &key)
+{
+    NatConntrackEntry entry;
 
-    int ret = swss::exec(cmds, res);
+    entry.protocol  = IPPROTO_UDP;
+    entry.src_port  = 1;
+    entry.dst_ip    = "127.0.0.1";
+    entry.dst_port  = 127;
+    entry.snat_port = 1;
+    entry.dnat_ip   = "127.0.0.1";
+    entry.dnat_port = 127;
+    entry.timeout   = NAT_TIMEOUT_MAX;
 
-    if (ret)
+    if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
+        entry.src_ip  = m_staticNatEntry[key].local_ip;
+        entry.snat_ip = key;
     }
     else
     {
-        SWSS_LOG_INFO("Added the static NAT conntrack entry");
+        entry.src_ip  = key;
+        entry.snat_ip = m_staticNatEntry[key].local_ip;
     }
+
+    return entry;
 }
 
-/* To Add a dummy conntrack entry for the Static Twice NAT entry in the kernel */
-void NatMgr::addConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
+/* To get the dummy conntrack entry of the Static Twice NAT entry */
+NatConntrackEntry NatMgr::getConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
-    int timeout = NAT_TIMEOUT_MAX;
-
-    SWSS_LOG_INFO("Add static Twice NAT conntrack entry with src-ip %s, dst-ip %s, timeout %u",
-                  snatKey.c_str(), dnatKey.c_str(), timeout);
+    NatConntrackEntry entry;
+
+    entry.protocol  = IPPROTO_UDP;
+    entry.src_ip    = snatKey;
+    entry.src_port  = 1;
+    entry.dst_ip    = dnatKey;
+    entry.dst_port  = 1;
+    entry.snat_ip   = m_staticNatEntry[snatKey].local_ip;
+    entry.snat_port = 1;
+    entry.dnat_ip   = m_staticNatEntry[dnatKey].local_ip;
+    entry.dnat_port = 1;
+    entry.timeout   = NAT_TIMEOUT_MAX;
+
+    return entry;
+}
 
-    cmds += (" -I -n " + m_staticNatEntry[snatKey].local_ip + ":1" + " -g " + m_staticNatEntry[dnatKey].local_ip + ":1"
-             +  " -p udp" + " -t " + to_string(timeout) + " --src " + snatKey + " --sport 1" + " --dst " + dnatKey
-             +  " --dport 1" + " -u ASSURED " + REDIRECT_TO_DEV_NULL);
+/* To get the dummy conntrack entry of the Static Single NAPT entry */
+NatConntrackEntry NatMgr::getConntrackStaticSingleNaptEntry(const string &key)
+{
+    NatConntrackEntry entry;
+    vector<string>    keys = tokenize(key, config_db_key_delimiter);
 
-    int ret = swss::exec(cmds, res);
+    entry.protocol    = getConntrackProtocol(keys[1]);
+    entry.dst_ip      = "127.0.0.1";
+    entry.dst_port    = 127;
+    entry.dnat_ip     = "127.0.0.1";
+    entry.dnat_port   = 127;
+    entry.timeout     = NAT_TIMEOUT_MAX;
+    entry.established = true;
 
-    if (ret)
+    if (m_staticNaptEntry[key].nat_type == DNAT_NAT_TYPE)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
+        entry.src_ip    = m_staticNaptEntry[key].local_ip;
+        entry.src_port  = static_cast<uint16_t>(stoi(m_staticNaptEntry[key].local_port));
+        entry.snat_ip   = keys[0];
+        entry.snat_port = static_cast<uint16_t>(stoi(keys[2]));
     }
     else
     {
-        SWSS_LOG_INFO("Added the static Twice NAT conntrack entry");
+        entry.src_ip    = keys[0];
+        entry.src_port  = static_cast<uint16_t>(stoi(keys[2]));
+        entry.snat_ip   = m_staticNaptEntry[key].local_ip;
+        entry.snat_port = static_cast<uint16_t>(stoi(m_staticNaptEntry[key].local_port));
     }
+
+    return entry;
 }
 
-/* To Add a dummy conntrack entry for the Static NAPT entry in the kernel,
- * so that the port number is reserved and the same port is not allocated by the stack for any other dynamic entry */
-void NatMgr::addConntrackStaticSingleNaptEntry(const string &key)
+/* To get the dummy conntrack entry of the Static Twice NAPT entry */
+NatConntrackEntry NatMgr::getConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
 {
-    int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, state, cmds = std::string("") + CONNTRACK_CMD;
-    vector<string> keys = tokenize(key, config_db_key_delimiter);
-
-    if (keys[1] == to_upper(IP_PROTOCOL_UDP))
-    {
-        prototype = IP_PROTOCOL_UDP;
-        state = "";
-    }
-    else if (keys[1] == to_upper(IP_PROTOCOL_TCP))
-    {
-        prototype = IP_PROTOCOL_TCP;
-        state = " --state ESTABLISHED ";
-    }
+    NatConntrackEntry entry;
+    vector<string>    snatKeys = tokenize(snatKey, config_db_key_delimiter);
+    vector<string>    dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
+
+    entry.protocol    = getConntrackProtocol(snatKeys[1]);
+    entry.src_ip      = snatKeys[0];
+    entry.src_port    = static_cast<uint16_t>(stoi(snatKeys[2]));
+    entry.dst_ip      = dnatKeys[0];
+    entry.dst_port    = static_cast<uint16_t>(stoi(dnatKeys[2]));
+    entry.snat_ip     = m_staticNaptEntry[snatKey].local_ip;
+    entry.snat_port   = static_cast<uint16_t>(stoi(m_staticNaptEntry[snatKey].local_port));
+    entry.dnat_ip     = m_staticNaptEntry[dnatKey].local_ip;
+    entry.dnat_port   = static_cast<uint16_t>(stoi(m_staticNaptEntry[dnatKey].local_port));
+    entry.timeout     = NAT_TIMEOUT_MAX;
+    entry.established = true;
+
+    return entry;
+}
 
-    if (m_staticNaptEntry[key].nat_type == DNAT_NAT_TYPE)
-    {
+/* To Add a dummy conntrack entry for the Static Single NAT entry in the kernel */
+void NatMgr::addConntrackStaticSingleNatEntry(const string &key)
+{
+    NatConntrackEntry entry = getConntrackStaticSingleNatEntry(key);
 
-        SWSS_LOG_INFO("Add static NAPT conntrack entry with protocol %s, src-ip %s, src-port %s, timeout %d",
-                      prototype.c_str(), m_staticNaptEntry[key].local_ip.c_str(), m_staticNaptEntry[key].local_port.c_str(), timeout);
+    SWSS_LOG_INFO("Add static NAT conntrack entry with src-ip %s, timeout %u",
+                  entry.src_ip.c_str(), entry.timeout);
 
-        cmds += (" -I -n " + keys[0] + ":" + keys[2] + " -g 127.0.0.1:127" + " -p " + prototype + " -t " + to_string(timeout) +
-                 " --src " + m_staticNaptEntry[key].local_ip + " --sport " + m_staticNaptEntry[key].local_port + " --dst 127.0.0.1 --dport 127 -u ASSURED " 
-                 + state + REDIRECT_TO_DEV_NULL);
-    }
-    else if (m_staticNaptEntry[key].nat_type == SNAT_NAT_TYPE)
-    {
-        SWSS_LOG_INFO("Add static NAPT conntrack entry with protocol %s, src-ip %s, src-port %s, timeout %d",
-                      prototype.c_str(), keys[0].c_str(), keys[2].c_str(), timeout);
+    m_conntrackBatch.addEntry(entry);
+}
 
-        cmds += (" -I -n " + m_staticNaptEntry[key].local_ip + ":" + m_staticNaptEntry[key].local_port + " -g 127.0.0.1:127" + " -p " + prototype + " -t " + to_string(timeout) +
-                 " --src " + keys[0] + " --sport " + keys[2] + " --dst 127.0.0.1 --dport 127 -u ASSURED " +  state + REDIRECT_TO_DEV_NULL);
-    }
+/* To Add a dummy conntrack entry for the Static Twice NAT entry in the kernel */
+void NatMgr::addConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
+{
+    NatConntrackEntry entry = getConntrackStaticTwiceNatEntry(snatKey, dnatKey);
 
-    int ret = swss::exec(cmds, res);
+    SWSS_LOG_INFO("Add static Twice NAT conntrack entry with src-ip %s, dst-ip %s, timeout %u",
+                  snatKey.c_str(), dnatKey.c_str(), entry.timeout);
 
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Added the static NAPT conntrack entry");
-    }
+    m_conntrackBatch.addEntry(entry);
 }
 
-/* To Add a dummy conntrack entry for the Static Twice NAPT entry in the kernel */
-void NatMgr::addConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
+/* To Add a dummy conntrack entry for the Static NAPT entry in the kernel,
+ * so that the port number is reserved and the same port is not allocated by the stack for any other dynamic entry */
+void NatMgr::addConntrackStaticSingleNaptEntry(const string &key)
 {
-    int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, state, cmds = std::string("") + CONNTRACK_CMD;
-    vector<string> snatKeys = tokenize(snatKey, config_db_key_delimiter);
-    vector<string> dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
+    NatConntrackEntry entry = getConntrackStaticSingleNaptEntry(key);
 
-    if (snatKeys[1] == to_upper(IP_PROTOCOL_UDP))
-    {
-        prototype = IP_PROTOCOL_UDP;
-        state = "";
-    }
-    else if (snatKeys[1] == to_upper(IP_PROTOCOL_TCP))
-    {
-        prototype = IP_PROTOCOL_TCP;
-        state = " --state ESTABLISHED ";
-    }
+    SWSS_LOG_INFO("Add static NAPT conntrack entry with protocol %u, src-ip %s, src-port %u, timeout %u",
+                  entry.protocol, entry.src_ip.c_str(), entry.src_port, entry.timeout);
 
-    SWSS_LOG_DEBUG("Add static Twice NAPT conntrack entry with protocol %s, src-ip %s, src-port %s, dst-ip %s, dst-port %s, timeout %u",
-                   prototype.c_str(), snatKeys[0].c_str(), snatKeys[2].c_str(), dnatKeys[0].c_str(), dnatKeys[2].c_str(), timeout);
+    m_conntrackBatch.addEntry(entry);
+}
 
-    cmds += (" -I -n " + m_staticNaptEntry[snatKey].local_ip + ":" + m_staticNaptEntry[snatKey].local_port + " -g " + m_staticNaptEntry[dnatKey].local_ip + ":"
-             + m_staticNaptEntry[dnatKey].local_port +  " -p " + prototype + " -t " + to_string(timeout)
-             + " --src " + snatKeys[0] + " --sport " + snatKeys[2] + " --dst " + dnatKeys[0] + " --dport " + dnatKeys[2] + " -u ASSURED " 
-             +  state + REDIRECT_TO_DEV_NULL);
+/* To Add a dummy conntrack entry for the Static Twice NAPT entry in the kernel */
+void NatMgr::addConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
+{
+    NatConntrackEntry entry = getConntrackStaticTwiceNaptEntry(snatKey, dnatKey);
 
-    int ret = swss::exec(cmds, res);
+    SWSS_LOG_DEBUG("Add static Twice NAPT conntrack entry with protocol %u, src-ip %s, src-port %u, dst-ip %s, dst-port %u, timeout %u",
+                   entry.protocol, entry.src_ip.c_str(), entry.src_port, entry.dst_ip.c_str(), entry.dst_port, entry.timeout);
 
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-    }
-    else
-    {
-        SWSS_LOG_INFO("Added the static Twice NAPT conntrack entry");
-    }
+    m_conntrackBatch.addEntry(entry);
 }
 
 /* To Update a dummy conntrack entry for the Static Single NAT entry in the kernel */
 void NatMgr::updateConntrackStaticSingleNatEntry(const string &key)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
-    int timeout = NAT_TIMEOUT_MAX;
+    NatConntrackEntry entry = getConntrackStaticSingleNatEntry(key);
 
-    if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
-    {
-        SWSS_LOG_INFO("Update static NAT conntrack entry with src-ip %s, timeout %d",
-                      m_staticNatEntry[key].local_ip.c_str(), timeout);
+    SWSS_LOG_INFO("Update static NAT conntrack entry with src-ip %s, timeout %u",
+                  entry.src_ip.c_str(), entry.timeout);
 
-        cmds += (" -U --src " + m_staticNatEntry[key].local_ip + " -p udp -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-    }
-    else if (m_staticNatEntry[key].nat_type == SNAT_NAT_TYPE)
-    {
-        SWSS_LOG_INFO("Update static NAT conntrack entry with src-ip %s, timeout %d",
-                      key.c_str(), timeout);
-
-        cmds += (" -U --src " + key + " -p udp -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-    }
-
-    swss::exec(cmds, res);
+    m_conntrackBatch.refreshEntry(entry);
 }
 
 /* To Update a dummy conntrack entry for the Static Twice NAT entry in the kernel */
 void NatMgr::updateConntrackStaticTwiceNatEntry(const string &snatKey, const string &dnatKey)
 {
-    std::string res, cmds = std::string("") + CONNTRACK_CMD;
-    int timeout = NAT_TIMEOUT_MAX;
+    NatConntrackEntry entry = getConntrackStaticTwiceNatEntry(snatKey, dnatKey);
 
     SWSS_LOG_INFO("Update static Twice NAT conntrack entry with src-ip %s, dst-ip %s, timeout %u",
-                  snatKey.c_str(), dnatKey.c_str(), timeout);
-   
-    cmds += (" -U --src " + snatKey + " -p udp -t " + to_string(timeout) + " --dst " + dnatKey + REDIRECT_TO_DEV_NULL);
+                  snatKey.c_str(), dnatKey.c_str(), entry.timeout);
 
-    swss::exec(cmds, res);
+    m_conntrackBatch.refreshEntry(entry);
 }
 
 /* To update a dummy conntrack entry for the Static NAPT entry in the kernel */
 void NatMgr::updateConntrackStaticSingleNaptEntry(const string &key)
 {
-    int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
-    vector<string> keys = tokenize(key, config_db_key_delimiter);
-
-    if (keys[1] == to_upper(IP_PROTOCOL_UDP))
-    {
-        prototype = IP_PROTOCOL_UDP;
-    }
-    else if (keys[1] == to_upper(IP_PROTOCOL_TCP))
-    {
-        prototype = IP_PROTOCOL_TCP;
-    }
+    NatConntrackEntry entry = getConntrackStaticSingleNaptEntry(key);
 
-    if (m_staticNaptEntry[key].nat_type == DNAT_NAT_TYPE)
-    {
-
-        SWSS_LOG_INFO("Update static NAPT conntrack entry with protocol %s, src-ip %s, src-port %s, timeout %d",
-                      prototype.c_str(), m_staticNaptEntry[key].local_ip.c_str(), m_staticNaptEntry[key].local_port.c_str(), timeout);
- 
-        cmds += (" -U --src " + m_staticNaptEntry[key].local_ip + " -p " + prototype + " --sport " + m_staticNaptEntry[key].local_port + " -t " 
-                 + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-    }
-    else if (m_staticNaptEntry[key].nat_type == SNAT_NAT_TYPE)
-    {
-        SWSS_LOG_INFO("Update static NAPT conntrack entry with protocol %s, src-ip %s, src-port %s, timeout %d",
-                      prototype.c_str(), keys[0].c_str(), keys[2].c_str(), timeout);
+    SWSS_LOG_INFO("Update static NAPT conntrack entry with protocol %u, src-ip %s, src-port %u, timeout %u",
+                  entry.protocol, entry.src_ip.c_str(), entry.src_port, entry.timeout);
 
-        cmds += (" -U --src " + keys[0] + " -p " + prototype + " --sport " + keys[2] + " -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-    }
-
-    swss::exec(cmds, res);
+    m_conntrackBatch.refreshEntry(entry);
 }
 
 /* To Update a dummy conntrack entry for the Static Twice NAPT entry in the kernel */
 void NatMgr::updateConntrackStaticTwiceNaptEntry(const string &snatKey, const string &dnatKey)
 {
-    int timeout = NAT_TIMEOUT_MAX;
-    std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
-    vector<string> snatKeys = tokenize(snatKey, config_db_key_delimiter);
-    vector<string> dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
-
-    if (snatKeys[1] == to_upper(IP_PROTOCOL_UDP))
-    {
-        prototype = IP_PROTOCOL_UDP;
-    }
-    else if (snatKeys[1] == to_upper(IP_PROTOCOL_TCP))
-    {
-        prototype = IP_PROTOCOL_TCP;
-    }
+    NatConntrackEntry entry = getConntrackStaticTwiceNaptEntry(snatKey, dnatKey);
 
-    SWSS_LOG_DEBUG("Update static Twice NAPT conntrack entry with protocol %s, src-ip %s, src-port %s, dst-ip %s, dst-port %s, timeout %u",
-                   prototype.c_str(), snatKeys[0].c_str(), snatKeys[2].c_str(), dnatKeys[0].c_str(), dnatKeys[2].c_str(), timeout);
+    SWSS_LOG_DEBUG("Update static Twice NAPT conntrack entry with protocol %u, src-ip %s, src-port %u, dst-ip %s, dst-port %u, timeout %u",
+                   entry.protocol, entry.src_ip.c_str(), entry.src_port, entry.dst_ip.c_str(), entry.dst_port, entry.timeout);
 
-    cmds += (" -U --src " + snatKeys[0] + " --dst " + dnatKeys[0] + " -p udp " + " --sport " + snatKeys[2] + " --dport " + dnatKeys[2]
-             + " -p udp -t " + to_string(timeout) + REDIRECT_TO_DEV_NULL);
-
-    swss::exec(cmds, res);
+    m_conntrackBatch.refreshEntry(entry);
 }
 
 /* To Delete conntrack entry for Static Single NAT entry */
@@ -707,6 +659,8 @@ void NatMgr::deleteConntrackStaticSingleNatEntry(const string &key)
 {
     std::string res, cmds = std::string("") + CONNTRACK_CMD;
 
+    m_conntrackBatch.flush();
+
     if (m_staticNatEntry[key].nat_type == DNAT_NAT_TYPE)
     {
         SWSS_LOG_INFO("Delete static NAT conntrack entry with src-ip %s", m_staticNatEntry[key].local_ip.c_str());
@@ -737,6 +691,8 @@ void NatMgr::deleteConntrackStaticTwiceNatEntry(const string &snatKey, const str
 {
     std::string res, cmds = std::string("") + CONNTRACK_CMD;
 
+    m_conntrackBatch.flush();
+
     SWSS_LOG_INFO("Delete static Twice NAT conntrack entry with src-ip %s and dst-ip %s", snatKey.c_str(), dnatKey.c_str());
 
     cmds += (" -D -s " + snatKey + " -d " + dnatKey + REDIRECT_TO_DEV_NULL);
@@ -759,6 +715,8 @@ void NatMgr::deleteConntrackStaticSingleNaptEntry(const string &key)
     std::string res, prototype, cmds = std::string("") + CONNTRACK_CMD;
     vector<string> keys = tokenize(key, config_db_key_delimiter);
 
+    m_conntrackBatch.flush();
+
     if (keys[1] == to_upper(IP_PROTOCOL_UDP))
     {
         prototype = IP_PROTOCOL_UDP;
@@ -802,6 +760,8 @@ void NatMgr::deleteConntrackStaticTwiceNaptEntry(const string &snatKey, const st
     vector<string> snatKeys = tokenize(snatKey, config_db_key_delimiter);
     vector<string> dnatKeys = tokenize(dnatKey, config_db_key_delimiter);
 
+    m_conntrackBatch.flush();
+
     if (snatKeys[1] == to_upper(IP_PROTOCOL_UDP))
     {
         prototype = IP_PROTOCOL_UDP;
@@ -833,6 +793,8 @@ void NatMgr::deleteConntrackDynamicEntries(const string &ip_range)
 {
     std::string res, cmds;
 
+    m_conntrackBatch.flush();
+
     uint32_t ipv4_addr_low, ipv4_addr_high, ip, setIp;
     char ipAddr[INET_ADDRSTRLEN];
 
@@ -881,6 +843,30 @@ void NatMgr::deleteConntrackDynamicEntries(const string &ip_range)
     }
 }
 
+/* To apply the rules of a table in a single iptables-restore transaction,
+ * so that either all the rules or none of them are applied */
+bool NatMgr::applyIptablesRules(const string &table, const vector<string> &rules)
+{
+    std::string res;
+    std::string cmds = std::string("") + IPTABLES_RESTORE_CMD + " --noflush <<'EOF'\n*" + table + "\n";
+
+    for (const auto &rule : rules)
+    {
+        cmds += rule + "\n";
+    }
+    cmds += "COMMIT\nEOF";
+
+    int ret = swss::exec(cmds, res);
+
+    if (ret)
+    {
+        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
+        return false;
+    }
+
+    return true;
+}
+
 /* Iptable rules are added in the mangles table, to support use of Loopback IP as NAT Public IP which is a typical use-case in DC scenarios. The way it works is that:
  *
  * *	The mangle table rules are processed first before the nat table rules.
@@ -899,28 +885,18 @@ bool NatMgr::setMangleIptablesRules(const string &opCmd, const string &interface
      * iptables -t mangle -opCmd PREROUTING -i port -j MARK --set-mark nat_zone
      * iptables -t mangle -opCmd POSTROUTING -o port -j MARK --set-mark nat_zone
      */
-    std::string res;
-    int ret;
-
     if (nat_zone.empty())
     {
         SWSS_LOG_INFO("Nat zone is empty");
         return false;
     }
 
-    const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t mangle " + "-" + opCmd + " PREROUTING -i " + interface + " -j MARK --set-mark " + nat_zone + " && "
-          + IPTABLES_CMD + " -t mangle " + "-" + opCmd + " POSTROUTING -o " + interface + " -j MARK --set-mark " + nat_zone ;
-
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
+    const vector<string> rules = {
+        "-" + opCmd + " PREROUTING -i " + interface + " -j MARK --set-mark " + nat_zone,
+        "-" + opCmd + " POSTROUTING -o " + interface + " -j MARK --set-mark " + nat_zone
+    };
 
-    return true;
+    return applyIptablesRules("mangle", rules);
 }
 
 /* To Add arbitrary value for DNAT rule incase of fullcone */
@@ -929,22 +905,13 @@ bool NatMgr::setFullConeDnatIptablesRule(const string &opCmd)
     /* This rule in the PREROUTING chain should be the default rule at the end of the list
      * iptables -t nat -[A/D] PREROUTING -j DNAT --fullcone
      */
-    std::string res;
-    int ret;
-
     /* In case of fullcone, the --to-destination is ignored by the stack, giving an aribitrary value so that 
      * iptables doesn't fail for PREROUTING/DNAT rule */
-    const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + " -j DNAT --to-destination 1.1.1.1 --fullcone";
-        
-    ret = swss::exec(cmds, res);
+    const vector<string> rules = {
+        "-" + opCmd + " PREROUTING " + " -j DNAT --to-destination 1.1.1.1 --fullcone"
+    };
 
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
-    return true;
+    return applyIptablesRules("nat", rules);
 }
 
 /* To Add or Delete the Iptables rules for Static NAT entry */
@@ -956,42 +923,23 @@ bool NatMgr::setStaticNatIptablesRules(const string &opCmd, const string &interf
      * iptables -t nat -opCmd PREROUTING -m mark --mark zone-value -j DNAT -d external_ip --to-destination internal_ip
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -j SNAT -s internal_ip --to-source external_ip
      */
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
+    vector<string> rules;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
     if (nat_type == DNAT_NAT_TYPE)
     {
-        const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + markStr + " -j DNAT -d " + external_ip + " --to-destination " + internal_ip + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + internal_ip + " --to-source " + external_ip ;
-        
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        rules.push_back("-" + opCmd + " PREROUTING " + markStr + " -j DNAT -d " + external_ip + " --to-destination " + internal_ip);
+        rules.push_back("-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + internal_ip + " --to-source " + external_ip);
     }
     else
     {
-        const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING" + " -j DNAT -d " + internal_ip + " --to-destination " + external_ip + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -j SNAT -s " + external_ip + " --to-source " + internal_ip ;
-
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        rules.push_back("-" + opCmd + " PREROUTING" + " -j DNAT -d " + internal_ip + " --to-destination " + external_ip);
+        rules.push_back("-" + opCmd + " POSTROUTING" + " -j SNAT -s " + external_ip + " --to-source " + internal_ip);
     }
 
-    return true;
+    return applyIptablesRules("nat", rules);
 }
 
 /* To Add or Delete the Iptables rules for Static NAPT entry */
@@ -1004,46 +952,27 @@ bool NatMgr::setStaticNaptIptablesRules(const string &opCmd, const string &inter
      * iptables -t nat -opCmd PREROUTING -m mark --mark zone-value -p prototype -j DNAT -d external_ip --dport external_port --to-destination internal_ip:internal_port
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -p prototype -j SNAT -s internal_ip --sport internal_port --to-source external_ip:external_port
      */
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
+    vector<string> rules;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
     if (nat_type == DNAT_NAT_TYPE)
     {
-        const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + markStr + " -p " + prototype + " -j DNAT -d " + external_ip + " --dport " + external_port + " --to-destination " 
-          + internal_ip + ":" + internal_port + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + internal_ip + " --sport " + internal_port + " --to-source " 
-          + external_ip + ":" + external_port;
-
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        rules.push_back("-" + opCmd + " PREROUTING " + markStr + " -p " + prototype + " -j DNAT -d " + external_ip + " --dport " + external_port + " --to-destination " 
+                        + internal_ip + ":" + internal_port);
+        rules.push_back("-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + internal_ip + " --sport " + internal_port + " --to-source " 
+                        + external_ip + ":" + external_port);
     }
     else
     {
-        const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING" + " -p " + prototype + " -j DNAT -d " + internal_ip + " --dport " + internal_port + " --to-destination "
-          + external_ip + ":" + external_port + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -p " + prototype + " -j SNAT -s " + external_ip + " --sport " + external_port + " --to-source "
-          + internal_ip + ":" + internal_port;
-
-        ret = swss::exec(cmds, res);
-
-        if (ret)
-        {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-            return false;
-        }
+        rules.push_back("-" + opCmd + " PREROUTING" + " -p " + prototype + " -j DNAT -d " + internal_ip + " --dport " + internal_port + " --to-destination "
+                        + external_ip + ":" + external_port);
+        rules.push_back("-" + opCmd + " POSTROUTING" + " -p " + prototype + " -j SNAT -s " + external_ip + " --sport " + external_port + " --to-source "
+                        + internal_ip + ":" + internal_port);
     }
 
-    return true;
+    return applyIptablesRules("nat", rules);
 }
 
 /* To Add or Delete the Iptables rules for Static Twice NAT entry */
@@ -1060,31 +989,22 @@ bool NatMgr::setStaticTwiceNatIptablesRules(const string &opCmd, const string &i
      * iptables -t nat -opCmd POSTROUTING -m mark --mark zone-value -j SNAT -s translated_dst --to-source dst -d src 
      */
 
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
-    const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING -j DNAT -d " + translated_src_ip
-          + " --to-destination " + src_ip + " -s " + translated_dest_ip + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + markStr + " -j DNAT -d " + dest_ip
-          + " --to-destination " + translated_dest_ip + " -s " + src_ip + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -j SNAT -s " + src_ip
-          + " --to-source " + translated_src_ip + " -d " + translated_dest_ip + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + translated_dest_ip
-          + " --to-source " + dest_ip + " -d " + src_ip;
-
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
-
-    return true;
+    const vector<string> rules = {
+        "-" + opCmd + " PREROUTING -j DNAT -d " + translated_src_ip
+          + " --to-destination " + src_ip + " -s " + translated_dest_ip,
+        "-" + opCmd + " PREROUTING " + markStr + " -j DNAT -d " + dest_ip
+          + " --to-destination " + translated_dest_ip + " -s " + src_ip,
+        "-" + opCmd + " POSTROUTING -j SNAT -s " + src_ip
+          + " --to-source " + translated_src_ip + " -d " + translated_dest_ip,
+        "-" + opCmd + " POSTROUTING " + markStr + " -j SNAT -s " + translated_dest_ip
+          + " --to-source " + dest_ip + " -d " + src_ip
+    };
+
+    return applyIptablesRules("nat", rules);
 }
 
 /* To Add or Delete the Iptables rules for Static Twice NAPT entry */
@@ -1106,31 +1026,22 @@ bool NatMgr::setStaticTwiceNaptIptablesRules(const string &opCmd, const string &
      * -d src --dport src_l4_port
      */
 
-    std::string res;
     std::string markStr = std::string("");
-    int ret;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
-    const std::string cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING -p " + prototype + " -j DNAT -d " + translated_src_ip + " --dport " + translated_src_port 
-          + " --to-destination " + src_ip + ":" + src_port + " -s " + translated_dest_ip + " --sport " + translated_dest_port + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " PREROUTING " + markStr + " -p " + prototype + " -j DNAT -d " + dest_ip + " --dport " + dest_port
-          + " --to-destination " + translated_dest_ip + ":" + translated_dest_port + " -s " + src_ip + " --sport " + src_port + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p " + prototype + " -j SNAT -s " + src_ip + " --sport " + src_port
-          + " --to-source " + translated_src_ip + ":" + translated_src_port + " -d " + translated_dest_ip + " --dport " + translated_dest_port + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + translated_dest_ip + " --sport " + translated_dest_port
-          + " --to-source " + dest_ip + ":" + dest_port + " -d " + src_ip + " --dport " +src_port;
-
-    ret = swss::exec(cmds, res);
-
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
-
-    return true;
+    const vector<string> rules = {
+        "-" + opCmd + " PREROUTING -p " + prototype + " -j DNAT -d " + translated_src_ip + " --dport " + translated_src_port 
+          + " --to-destination " + src_ip + ":" + src_port + " -s " + translated_dest_ip + " --sport " + translated_dest_port,
+        "-" + opCmd + " PREROUTING " + markStr + " -p " + prototype + " -j DNAT -d " + dest_ip + " --dport " + dest_port
+          + " --to-destination " + translated_dest_ip + ":" + translated_dest_port + " -s " + src_ip + " --sport " + src_port,
+        "-" + opCmd + " POSTROUTING -p " + prototype + " -j SNAT -s " + src_ip + " --sport " + src_port
+          + " --to-source " + translated_src_ip + ":" + translated_src_port + " -d " + translated_dest_ip + " --dport " + translated_dest_port,
+        "-" + opCmd + " POSTROUTING " + markStr + " -p " + prototype + " -j SNAT -s " + translated_dest_ip + " --sport " + translated_dest_port
+          + " --to-source " + dest_ip + ":" + dest_port + " -d " + src_ip + " --dport " +src_port
+    };
+
+    return applyIptablesRules("nat", rules);
 }
 
 /* To Add or Delete the Iptables rules for Dynamic NAT/NAPT without ACLs */
@@ -1145,12 +1056,12 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
      * iptables -t nat -opCmd POSTROUTING -p udp -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      * iptables -t nat -opCmd POSTROUTING -p icmp -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      */
-    std::string res, cmd;
+    std::string cmd;
     std::string externalString = EMPTY_STRING;
     std::string fullcone = EMPTY_STRING;
     std::string prototype = EMPTY_STRING;
-    std::string cmds = std::string("");
     std::string markStr = std::string("");
+    vector<string> rules;
 
     markStr = " -m mark --mark " + m_natZoneInterfaceInfo[interface];
 
@@ -1168,13 +1079,12 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
     if (key.empty())
     {
         /* Rules for Single NAT */
-        cmds = std::string("")
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p tcp -j SNAT " + markStr + " --to-source " 
-          + externalString + fullcone + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p udp -j SNAT " + markStr + " --to-source " 
-          + externalString + fullcone + " && "
-          + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p icmp -j SNAT " + markStr + " --to-source " 
-          + externalString + fullcone;
+        rules.push_back("-" + opCmd + " POSTROUTING -p tcp -j SNAT " + markStr + " --to-source " 
+                        + externalString + fullcone);
+        rules.push_back("-" + opCmd + " POSTROUTING -p udp -j SNAT " + markStr + " --to-source " 
+                        + externalString + fullcone);
+        rules.push_back("-" + opCmd + " POSTROUTING -p icmp -j SNAT " + markStr + " --to-source " 
+                        + externalString + fullcone);
     }
     else
     {
@@ -1200,33 +1110,24 @@ bool NatMgr::setDynamicNatIptablesRulesWithoutAcl(const string &opCmd, const str
             }
 
             /* Rules for Double NAT */
-            cmds = std::string("")
-              + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + " --to-source "
-              + externalString + " -d " + keys[0] + " --dport " + keys[2] + fullcone + " && "
-              + IPTABLES_CMD + " -t nat " + "-" + cmd + " PREROUTING " + prototype + " -j DNAT -d " + m_staticNaptEntry[key].local_ip + " --dport "
-              + m_staticNaptEntry[key].local_port + " --to-destination " + keys[0] + ":" + keys[2] + " && "
-              + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT -s " + keys[0] + " --sport "
-              + keys[2] + " --to-source " + m_staticNaptEntry[key].local_ip + ":" + m_staticNaptEntry[key].local_port;
+            rules.push_back("-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + " --to-source "
+                            + externalString + " -d " + keys[0] + " --dport " + keys[2] + fullcone);
+            rules.push_back("-" + cmd + " PREROUTING " + prototype + " -j DNAT -d " + m_staticNaptEntry[key].local_ip + " --dport "
+                            + m_staticNaptEntry[key].local_port + " --to-destination " + keys[0] + ":" + keys[2]);
+            rules.push_back("-" + opCmd + " POSTROUTING " + prototype + " -j SNAT -s " + keys[0] + " --sport "
+                            + keys[2] + " --to-source " + m_staticNaptEntry[key].local_ip + ":" + m_staticNaptEntry[key].local_port);
         }
         else
         {   
             /* Rules for Double NAT */ 
-            cmds = std::string("")
-              + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + " --to-source "
-              + externalString + " -d " + key + fullcone + " && "
-              + IPTABLES_CMD + " -t nat " + "-" + cmd + " PREROUTING" + " -j DNAT -d " + m_staticNatEntry[key].local_ip + " --to-destination " + key + " && "
-              + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -j SNAT -s " + key + " --to-source " + m_staticNatEntry[key].local_ip ;
+            rules.push_back("-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + " --to-source "
+                            + externalString + " -d " + key + fullcone);
+            rules.push_back("-" + cmd + " PREROUTING" + " -j DNAT -d " + m_staticNatEntry[key].local_ip + " --to-destination " + key);
+            rules.push_back("-" + opCmd + " POSTROUTING" + " -j SNAT -s " + key + " --to-source " + m_staticNatEntry[key].local_ip);
         }
     }
 
-    int ret = swss::exec(cmds, res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
-
-    return true;
+    return applyIptablesRules("nat", rules);
 }
 
 /* To Add or Delete the Iptables rules for Dynamic NAT/NAPT with ACLs */
@@ -1247,12 +1148,12 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
      * iptables -t nat -opCmd POSTROUTING -p icmp srcIpAddressString -j SNAT -m mark --mark zone-value --to-source external_ip:external_port_range --fullcone
      */
 
-    std::string res, cmd;
+    std::string cmd;
     std::string srcIpAddressString = EMPTY_STRING, dstIpAddressString = EMPTY_STRING;
     std::string srcPortString = EMPTY_STRING, dstPortString = EMPTY_STRING;
     std::string externalString = EMPTY_STRING, fullcone = EMPTY_STRING;
     std::string prototype = EMPTY_STRING;
-    std::string cmds = std::string("");
+    vector<string> rules;
     vector<string> keys;
     std::string markStr = std::string("");
 
@@ -1336,36 +1237,39 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
             if (key.empty())
             {
                 /* Rules for Single NAT */
-                cmds = std::string("")
-                   + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + dstIpAddressString 
-                   + srcPortString + dstPortString + " -j RETURN" + " && "
-                   + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + dstIpAddressString
-                   + srcPortString + dstPortString + " -j RETURN" + " && "
-                   + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + dstIpAddressString
-                   + " -j RETURN";
+                rules = {
+                    "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + dstIpAddressString 
+                      + srcPortString + dstPortString + " -j RETURN",
+                    "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + dstIpAddressString
+                      + srcPortString + dstPortString + " -j RETURN",
+                    "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + dstIpAddressString
+                      + " -j RETURN"
+                };
             }
             else
             {
                 /* Rules for Double NAT */
                 if (keys.size() > 1)
                 {
-                    cmds = std::string("")
-                       + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + " -d " + keys[0]
-                       + srcPortString + " --dport " + keys[2] + " -j RETURN" + " && "
-                       + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + " -d " + keys[0]
-                       + srcPortString + " --dport " + keys[2] + " -j RETURN" + " && "
-                       + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + " -d " + keys[0]
-                       + " -j RETURN";
+                    rules = {
+                        "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + " -d " + keys[0]
+                          + srcPortString + " --dport " + keys[2] + " -j RETURN",
+                        "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + " -d " + keys[0]
+                          + srcPortString + " --dport " + keys[2] + " -j RETURN",
+                        "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + " -d " + keys[0]
+                          + " -j RETURN"
+                    };
                 }
                 else
                 {
-                    cmds = std::string("")
-                       + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + " -d " + keys[0]
-                       + srcPortString + " -j RETURN" + " && "
-                       + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + " -d " + keys[0]
-                       + srcPortString + " -j RETURN" + " && "
-                       + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + " -d " + keys[0]
-                       + " -j RETURN";
+                    rules = {
+                        "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + " -d " + keys[0]
+                          + srcPortString + " -j RETURN",
+                        "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + " -d " + keys[0]
+                          + srcPortString + " -j RETURN",
+                        "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + " -d " + keys[0]
+                          + " -j RETURN"
+                    };
                 }
 
             }
@@ -1376,25 +1280,28 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
             if (key.empty())
             {
                 /* Rule for Single NAT */
-                cmds = std::string("")
-                  + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
-                  + dstIpAddressString + srcPortString + dstPortString + " -j RETURN";
+                rules = {
+                    "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
+                      + dstIpAddressString + srcPortString + dstPortString + " -j RETURN"
+                };
             }
             else
             {
                 if (keys.size() > 1)
                 {
                     /* Rules for Double NAT */
-                    cmds = std::string("")
-                      + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
-                      + " -d " + keys[0] + srcPortString + " --dport " + keys[2] + " -j RETURN";
+                    rules = {
+                        "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
+                          + " -d " + keys[0] + srcPortString + " --dport " + keys[2] + " -j RETURN"
+                    };
                 }
                 else
                 {
                     /* Rules for Double NAT */
-                    cmds = std::string("")
-                      + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
-                      + " -d " + keys[0] + srcPortString + " -j RETURN";
+                    rules = {
+                        "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
+                          + " -d " + keys[0] + srcPortString + " -j RETURN"
+                    };
                 }
             }
         }
@@ -1407,19 +1314,21 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
             /* Rules for all ip protocols */
             if (natAclRuleId.ip_protocol == "None")
             {
-                cmds = std::string("")
-                   + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + dstIpAddressString + srcPortString + dstPortString 
-                   + " -j SNAT " + markStr + " --to-source " + externalString + fullcone + " && "
-                   + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + dstIpAddressString + srcPortString + dstPortString
-                   + " -j SNAT " + markStr + " --to-source " + externalString + fullcone + " && "
-                   + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + dstIpAddressString + srcPortString + dstPortString 
-                   + " -j SNAT " + markStr + " --to-source " + externalString + fullcone;
+                rules = {
+                    "-" + opCmd + " POSTROUTING -p tcp" + srcIpAddressString + dstIpAddressString + srcPortString + dstPortString 
+                      + " -j SNAT " + markStr + " --to-source " + externalString + fullcone,
+                    "-" + opCmd + " POSTROUTING -p udp" + srcIpAddressString + dstIpAddressString + srcPortString + dstPortString
+                      + " -j SNAT " + markStr + " --to-source " + externalString + fullcone,
+                    "-" + opCmd + " POSTROUTING -p icmp" + srcIpAddressString + dstIpAddressString + srcPortString + dstPortString 
+                      + " -j SNAT " + markStr + " --to-source " + externalString + fullcone
+                };
             }
             else
             {
-                cmds = std::string("")
-                  + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
-                  + dstIpAddressString + srcPortString + dstPortString + " -j SNAT " + markStr + " --to-source " + externalString + fullcone;
+                rules = {
+                    "-" + opCmd + " POSTROUTING -p " + natAclRuleId.ip_protocol + srcIpAddressString
+                      + dstIpAddressString + srcPortString + dstPortString + " -j SNAT " + markStr + " --to-source " + externalString + fullcone
+                };
             }
         }
         else
@@ -1427,35 +1336,30 @@ bool NatMgr::setDynamicNatIptablesRulesWithAcl(const string &opCmd, const string
             if (keys.size() > 1)
             {
                 /* Rules for Double NAT */
-                cmds = std::string("")
-                  + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + srcIpAddressString + srcPortString 
-                  + " --to-source " + externalString + " -d " + keys[0] + " --dport " + keys[2] + fullcone + " && "
-                  + IPTABLES_CMD + " -t nat " + "-" + cmd + " PREROUTING " + prototype + " -j DNAT -d " + m_staticNaptEntry[key].local_ip + " --dport "
-                  + m_staticNaptEntry[key].local_port + srcIpAddressString + srcPortString + " --to-destination " + keys[0] + ":" + keys[2] + " && "
-                  + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT -s " + key[0] + " --sport "
-                  + keys[2] + " --to-source " + m_staticNaptEntry[key].local_ip + ":" + m_staticNaptEntry[key].local_port;
+                rules = {
+                    "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + srcIpAddressString + srcPortString 
+                      + " --to-source " + externalString + " -d " + keys[0] + " --dport " + keys[2] + fullcone,
+                    "-" + cmd + " PREROUTING " + prototype + " -j DNAT -d " + m_staticNaptEntry[key].local_ip + " --dport "
+                      + m_staticNaptEntry[key].local_port + srcIpAddressString + srcPortString + " --to-destination " + keys[0] + ":" + keys[2],
+                    "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT -s " + key[0] + " --sport "
+                      + keys[2] + " --to-source " + m_staticNaptEntry[key].local_ip + ":" + m_staticNaptEntry[key].local_port
+                };
             }
             else
             {
                 /* Rules for Double NAT */
-                cmds = std::string("")
-                  + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + srcIpAddressString 
-                  + " --to-source " + externalString + " -d " + key + fullcone + " && "
-                  + IPTABLES_CMD + " -t nat " + "-" + cmd + " PREROUTING" + " -j DNAT -d " + m_staticNatEntry[key].local_ip + srcIpAddressString
-                  + " --to-destination " + key + " && "
-                  + IPTABLES_CMD + " -t nat " + "-" + opCmd + " POSTROUTING" + " -j SNAT -s " + key + " --to-source " + m_staticNatEntry[key].local_ip ;
+                rules = {
+                    "-" + opCmd + " POSTROUTING " + prototype + " -j SNAT " + markStr + srcIpAddressString 
+                      + " --to-source " + externalString + " -d " + key + fullcone,
+                    "-" + cmd + " PREROUTING" + " -j DNAT -d " + m_staticNatEntry[key].local_ip + srcIpAddressString
+                      + " --to-destination " + key,
+                    "-" + opCmd + " POSTROUTING" + " -j SNAT -s " + key + " --to-source " + m_staticNatEntry[key].local_ip
+                };
             }
         }
     }
 
-    int ret = swss::exec(cmds, res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmds.c_str(), ret);
-        return false;
-    }
-
-    return true;
+    return applyIptablesRules("nat", rules);
 }
 
 /* To add/remove a DNAT Pool entry from Nat Pool */
@@ -5802,6 +5706,7 @@ void NatMgr::doTask(SelectableTimer &timer)
     {
         SWSS_LOG_INFO("Calling doNatRefreshTimerTask");
         doNatRefreshTimerTask();
+        m_conntrackBatch.flush();
     }
     else
     {
@@ -8196,6 +8101,8 @@ void NatMgr::doTask(Consumer &consumer)
         SWSS_LOG_ERROR("Unknown config table %s ", table_name.c_str());
         throw runtime_error("NatMgr doTask failure.");
     }
+
+    m_conntrackBatch.flush();
 }
 
 /* To parse the timeout notifications */
@@ -23,6 +23,7 @@
 #include "orch.h"
 #include "notificationproducer.h"
 #include "timer.h"
+#include "natconntrack.h"
 #include <unistd.h>
 #include <set>
 #include <map>
@@ -275,6 +276,7 @@ private:
     natAclRule_map_t         m_natAclRuleInfo;
     natDnatPool_map_t        m_natDnatPoolInfo;
     SelectableTimer          *m_natRefreshTimer;
+    NatConntrackBatch        m_conntrackBatch;
 
     /* Declare doTask related fucntions */
     void doTask(Consumer &consumer);
@@ -308,6 +310,10 @@ private:
     void deleteConntrackStaticTwiceNatEntry(const std::string &snatKey, const std::string &dnatKey);
     void deleteConntrackStaticTwiceNaptEntry(const std::string &snatKey, const std::string &dnatKey);
     void deleteConntrackDynamicEntries(const std::string &ip_range);
+    NatConntrackEntry getConntrackStaticSingleNatEntry(const std::string &key);
+    NatConntrackEntry getConntrackStaticSingleNaptEntry(const std::string &key);
+    NatConntrackEntry getConntrackStaticTwiceNatEntry(const std::string &snatKey, const std::string &dnatKey);
+    NatConntrackEntry getConntrackStaticTwiceNaptEntry(const std::string &snatKey, const std::string &dnatKey);
     void updateDynamicSingleNatConnTrackTimeout(std::string key, int timeout);
     void updateDynamicSingleNaptConnTrackTimeout(std::string key, int timeout);
     void updateDynamicTwiceNatConnTrackTimeout(std::string key, int timeout);
@@ -366,6 +372,7 @@ private:
     bool isGlobalIpMatching(const std::string &intf_keys, const std::string &global_ip);
     bool getIpEnabledIntf(const std::string &global_ip, std::string &interface);
     void setNaptPoolIpTable(const std::string &opCmd, const std::string &nat_ip, const std::string &nat_port);
+    bool applyIptablesRules(const std::string &table, const std::vector<std::string> &rules);
     bool setFullConeDnatIptablesRule(const std::string &opCmd);
     bool setMangleIptablesRules(const std::string &opCmd, const std::string &interface, const std::string &nat_zone);
     bool setStaticNatIptablesRules(const std::string &opCmd, const std::string &interface, const std::string &external_ip, const std::string &internal_ip, const std::string &nat_type);
@@ -1,5 +1,9 @@
 #include <string>
+#include <cstring>
+#include <stdexcept>
+#include <net/if.h>
 #include <netinet/in.h>
+#include <linux/neighbour.h>
 #include <netlink/route/link.h>
 #include <netlink/route/neighbour.h>
 #include <netlink/route/link/vxlan.h>
@@ -11,7 +15,6 @@
 #include "ipaddress.h"
 #include "netmsg.h"
 #include "macaddress.h"
-#include "exec.h"
 #include "fdbsync.h"
 #include "warm_restart.h"
 #include "errno.h"
@@ -22,11 +25,20 @@ using namespace swss;
 #define VXLAN_BR_IF_NAME_PREFIX    "Brvxlan"
 
 FdbSync::FdbSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *config_db) :
-    m_fdbTable(pipelineAppDB, APP_VXLAN_FDB_TABLE_NAME),
-    m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME),
+    m_pipeline(pipelineAppDB),
+    m_fdbTable(pipelineAppDB, APP_VXLAN_FDB_TABLE_NAME, true),
+    m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME, true),
     m_fdbStateTable(stateDb, STATE_FDB_TABLE_NAME),
     m_cfgEvpnNvoTable(config_db, CFG_VXLAN_EVPN_NVO_TABLE_NAME)
 {
+    m_nlSock = nl_socket_alloc();
+    if (!m_nlSock || nl_connect(m_nlSock, NETLINK_ROUTE) < 0)
+    {
+        SWSS_LOG_ERROR("Unable to open netlink socket for kernel FDB updates");
+        throw std::runtime_error("Unable to open netlink socket for kernel FDB updates");
+    }
+    m_kernelBatch.reserve(FDBSYNC_KERNEL_BATCH_SIZE);
+
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "fdbsyncd", "swss", DEFAULT_FDBSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
     {
@@ -41,6 +53,184 @@ FdbSync::~FdbSync()
     {
         delete m_AppRestartAssist;
     }
+
+    if (m_nlSock)
+    {
+        nl_socket_free(m_nlSock);
+    }
+}
+
+void FdbSync::setPending(unordered_map<string, m_pending_entry> &pending, string key,
+                         string op, vector<FieldValueTuple> fvVector)
+{
+    /* Only the latest change of a key is written */
+    auto &entry = pending[key];
+    entry.op = op;
+    entry.fvVector = fvVector;
+
+    if (m_fdbPending.size() + m_imetPending.size() >= FDBSYNC_MAX_PENDING_ENTRIES)
+    {
+        flushPending();
+    }
+}
+
+void FdbSync::flushPending()
+{
+    auto write = [](ProducerStateTable &table, unordered_map<string, m_pending_entry> &pending) {
+        for (auto &it : pending)
+        {
+            if (it.second.op == SET_COMMAND)
+            {
+                table.set(it.first, it.second.fvVector);
+            }
+            else
+            {
+                table.del(it.first);
+            }
+        }
+        pending.clear();
+    };
+
+    write(m_fdbTable, m_fdbPending);
+    write(m_imetTable, m_imetPending);
+
+    /* The tables are buffered, also covers the writes of the warm restart reconciliation */
+    m_pipeline->flush();
+    flushKernelMacs();
+}
+
+void FdbSync::queueKernelMac(int nlmsg_type, string mac, string ifname, string vlan,
+                             short fdb_type, string vtep)
+{
+    unsigned int ifindex = if_nametoindex(ifname.c_str());
+    if (!ifindex)
+    {
+        SWSS_LOG_INFO("Interface %s not found for MAC %s vlan %s", ifname.c_str(), mac.c_str(), vlan.c_str());
+        return;
+    }
+
+    struct rtnl_neigh *neigh = rtnl_neigh_alloc();
+    struct nl_addr *lladdr = NULL;
+    struct nl_addr *dst = NULL;
+    struct nl_msg *msg = NULL;
+    int ret;
+
+    rtnl_neigh_set_family(neigh, AF_BRIDGE);
+    rtnl_neigh_set_ifindex(neigh, ifindex);
+    rtnl_neigh_set_vlan(neigh, stoi(vlan));
+
+    if ((ret = nl_addr_parse(mac.c_str(), AF_LLC, &lladdr)) == 0)
+    {
+        rtnl_neigh_set_lladdr(neigh, lladdr);
+    }
+
+    if (vtep.empty())
+    {
+        /* Same as "bridge fdb <op> ... master <type>" */
+        rtnl_neigh_set_flags(neigh, NTF_MASTER);
+        rtnl_neigh_set_state(neigh, (fdb_type == FDB_TYPE_DYNAMIC) ? NUD_REACHABLE : NUD_NOARP);
+    }
+    else if ((ret = nl_addr_parse(vtep.c_str(), AF_INET, &dst)) == 0)
+    {
+        rtnl_neigh_set_flags(neigh, NTF_SELF);
+        rtnl_neigh_set_dst(neigh, dst);
+    }
+
+    if (ret == 0)
+    {
+        if (nlmsg_type == RTM_NEWNEIGH)
+        {
+            ret = rtnl_neigh_build_add_request(neigh, NLM_F_CREATE | NLM_F_REPLACE, &msg);
+        }
+        else
+        {
+            ret = rtnl_neigh_build_delete_request(neigh, 0, &msg);
+        }
+    }
+
+    if (ret == 0)
+    {
+        /* Sets the sequence number and asks for an ack */
+        nl_complete_msg(m_nlSock, msg);
+
+        struct nlmsghdr *hdr = nlmsg_hdr(msg);
+        size_t len = NLMSG_ALIGN(hdr->nlmsg_len);
+        if (m_kernelBatch.size() + len > FDBSYNC_KERNEL_BATCH_SIZE)
+        {
+            flushKernelMacs();
+        }
+
+        const char *data = reinterpret_cast<const char *>(hdr);
+        m_kernelBatch.insert(m_kernelBatch.end(), data, data + hdr->nlmsg_len);
+        m_kernelBatch.resize(m_kernelBatch.size() + len - hdr->nlmsg_len, 0);
+        m_kernelBatchCount++;
+
+        SWSS_LOG_INFO("Queued kernel FDB %s MAC %s dev %s vlan %s",
+                      (nlmsg_type == RTM_NEWNEIGH) ? "replace" : "del",
+                      mac.c_str(), ifname.c_str(), vlan.c_str());
+        nlmsg_free(msg);
+    }
+    else
+    {
+        SWSS_LOG_ERROR("Failed to build kernel FDB update MAC %s dev %s vlan %s: %s",
+                       mac.c_str(), ifname.c_str(), vlan.c_str(), nl_geterror(ret));
+    }
+
+    nl_addr_put(lladdr);
+    nl_addr_put(dst);
+    rtnl_neigh_put(neigh);
+}
+
+void FdbSync::flushKernelMacs()
+{
+    if (!m_kernelBatchCount)
+    {
+        return;
+    }
+
+    int ret = nl_sendto(m_nlSock, m_kernelBatch.data(), m_kernelBatch.size());
+    if (ret < 0)
+    {
+        SWSS_LOG_ERROR("Failed to send %u kernel FDB updates: %s", m_kernelBatchCount, nl_geterror(ret));
+    }
+
+    /* The kernel handles the messages while sending, each of them is acked */
+    uint32_t acked = 0;
+    while (ret >= 0 && acked < m_kernelBatchCount)
+    {
+        struct sockaddr_nl nla;
+        unsigned char *buf = NULL;
+
+        int len = nl_recv(m_nlSock, &nla, &buf, NULL);
+        if (len <= 0)
+        {
+            SWSS_LOG_ERROR("Failed to receive kernel FDB update acks, %u of %u: %s",
+                           acked, m_kernelBatchCount, nl_geterror(len));
+            free(buf);
+            break;
+        }
+
+        struct nlmsghdr *hdr = reinterpret_cast<struct nlmsghdr *>(buf);
+        while (nlmsg_ok(hdr, len))
+        {
+            if (hdr->nlmsg_type == NLMSG_ERROR)
+            {
+                struct nlmsgerr *err = reinterpret_cast<struct nlmsgerr *>(nlmsg_data(hdr));
+                if (err->error)
+                {
+                    SWSS_LOG_INFO("Kernel FDB update seq %u failed: %s", hdr->nlmsg_seq, strerror(-err->error));
+                }
+                acked++;
+            }
+            hdr = nlmsg_next(hdr, &len);
+        }
+        free(buf);
+    }
+
+    SWSS_LOG_INFO("Sent %u kernel FDB updates", m_kernelBatchCount);
+
+    m_kernelBatch.clear();
+    m_kernelBatchCount = 0;
 }
 
 void FdbSync::processCfgEvpnNvo()
@@ -175,26 +365,16 @@ void FdbSync::macDelVxlanEntry(string auxkey, struct m_fdb_info *info)
 {
     std::string vtep = m_mac[auxkey].vtep;
 
-    const std::string cmds = std::string("")
-        + " bridge fdb del " + info->mac + " dev " 
-        + m_mac[auxkey].ifname + " dst " + vtep + " vlan " + info->vid.substr(4);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-    if (ret != 0)
-    {
-        SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-    }
-
-    SWSS_LOG_INFO("Success cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    /* Same as "bridge fdb del <mac> dev <vxlan dev> dst <vtep> vlan <vid>" */
+    queueKernelMac(RTM_DELNEIGH, info->mac, m_mac[auxkey].ifname, info->vid.substr(4),
+                   FDB_TYPE_DYNAMIC, vtep);
 
     return;
 }
 
 void FdbSync::updateLocalMac (struct m_fdb_info *info)
 {
-    char *op;
-    char *type;
+    int op;
     string port_name = "";
     string key = info->vid + ":" + info->mac;
     short fdb_type;    /*dynamic or static*/
@@ -202,7 +382,7 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
     if (info->op_type == FDB_OPER_ADD)
     {
         macUpdateCache(info);
-        op = "replace";
+        op = RTM_NEWNEIGH;
         port_name = info->port_name;
         fdb_type = info->type;
         /* Check if this vlan+key is also learned by vxlan neighbor then delete learned on */
@@ -215,7 +395,7 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
     }
     else
     {
-        op = "del";
+        op = RTM_DELNEIGH;
         port_name = m_fdb_mac[key].port_name;
         fdb_type = m_fdb_mac[key].type;
         m_fdb_mac.erase(key);
@@ -227,30 +407,13 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
         return;
     }
 
-    if (fdb_type == FDB_TYPE_DYNAMIC)
-    {
-        type = "dynamic";
-    }
-    else
-    {
-        type = "static";
-    }
-
-    const std::string cmds = std::string("")
-        + " bridge fdb " + op + " " + info->mac + " dev " 
-        + port_name + " master " + type + " vlan " + info->vid.substr(4);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-
-    SWSS_LOG_INFO("cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    queueKernelMac(op, info->mac, port_name, info->vid.substr(4), fdb_type);
 
     return;
 }
 
 void FdbSync::addLocalMac(string key, string op)
 {
-    char *type;
     string port_name = "";
     string mac = "";
     string vlan = "";
@@ -276,27 +439,8 @@ void FdbSync::addLocalMac(string key, string op)
             return;
         }
 
-        if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
-        {
-            type = "dynamic";
-        }
-        else
-        {
-            type = "static";
-        }
-
-        const std::string cmds = std::string("")
-                + " bridge fdb " + op + " " + mac + " dev "
-                + port_name + " master " + type  + " vlan " + vlan;
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-        }
-
-        SWSS_LOG_INFO("Config triggered cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        queueKernelMac((op == "del") ? RTM_DELNEIGH : RTM_NEWNEIGH, mac, port_name, vlan,
+                       m_fdb_mac[key].type);
     }
     return;
 }
@@ -311,7 +455,6 @@ void FdbSync::addLocalMac(string key, string op)
 void FdbSync::macRefreshStateDB(int vlan, string kmac)
 {
     string key = "Vlan" + to_string(vlan) + ":" + kmac;
-    char *type;
     string port_name = "";
 
     SWSS_LOG_INFO("Refreshing Vlan:%d MAC route MAC:%s Key %s", vlan, kmac.c_str(), key.c_str());
@@ -325,27 +468,7 @@ void FdbSync::macRefreshStateDB(int vlan, string kmac)
             return;
         }
 
-        if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
-        {
-            type = "dynamic";
-        }
-        else
-        {
-            type = "static";
-        }
-
-        const std::string cmds = std::string("")
-            + " bridge fdb " + "replace" + " " + kmac + " dev "
-            + port_name + " master " + type  + " vlan " + to_string(vlan);
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-        }
-
-        SWSS_LOG_INFO("Refreshing cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        queueKernelMac(RTM_NEWNEIGH, kmac, port_name, to_string(vlan), m_fdb_mac[key].type);
     }
     return;
 }
@@ -399,7 +522,7 @@ void FdbSync::imetAddRoute(struct in_addr vtep, string vlan_str, uint32_t vni)
         return;
     }
     
-    m_imetTable.set(key, fvVector);
+    setPending(m_imetPending, key, SET_COMMAND, fvVector);
     return;
 }
 
@@ -428,7 +551,7 @@ void FdbSync::imetDelRoute(struct in_addr vtep, string vlan_str, uint32_t vni)
         return;
     }
     
-    m_imetTable.del(key);
+    setPending(m_imetPending, key, DEL_COMMAND);
     return;
 }
 
@@ -455,7 +578,7 @@ void FdbSync::macDelVxlanDB(string key)
     }
     
     SWSS_LOG_INFO("VXLAN_FDB_TABLE: DEL_KEY %s vtep:%s type:%s", key.c_str(), vtep.c_str(), type.c_str());
-    m_fdbTable.del(key);
+    setPending(m_fdbPending, key, DEL_COMMAND);
     return;
 
 }
@@ -484,7 +607,7 @@ void FdbSync::macAddVxlan(string key, struct in_addr vtep, string type, uint32_t
     }
     
     SWSS_LOG_INFO("VXLAN_FDB_TABLE: ADD_KEY %s vtep:%s type:%s", key.c_str(), svtep.c_str(), type.c_str());
-    m_fdbTable.set(key, fvVector);
+    setPending(m_fdbPending, key, SET_COMMAND, fvVector);
 
     return;
 }
@@ -2,7 +2,10 @@
 #define __FDBSYNC__
 
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <arpa/inet.h>
+#include <netlink/netlink.h>
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "subscriberstatetable.h"
@@ -12,6 +15,12 @@
 // The timeout value (in seconds) for fdbsyncd reconcilation logic
 #define DEFAULT_FDBSYNC_WARMSTART_TIMER 30
 
+// Number of pending APPL_DB entries which triggers a flush
+#define FDBSYNC_MAX_PENDING_ENTRIES 1024
+
+// Size of the netlink datagram carrying the batched kernel FDB updates
+#define FDBSYNC_KERNEL_BATCH_SIZE (32 * 1024)
+
 namespace swss {
 
 enum FDB_OP_TYPE {
@@ -64,11 +73,15 @@ public:
 
     void processCfgEvpnNvo();
 
+    /* Writes the pending APPL_DB and kernel updates */
+    void flushPending();
+
     bool m_reconcileDone = false;
 
     bool m_isEvpnNvoExist = false;
 
 private:
+    RedisPipeline *m_pipeline;
     ProducerStateTable m_fdbTable;
     ProducerStateTable m_imetTable;
     SubscriberStateTable m_fdbStateTable;
@@ -120,6 +133,27 @@ private:
     };
     std::unordered_map<int, intf> m_intf_info;
 
+    /* Latest APPL_DB change of each key, until flushPending() */
+    struct m_pending_entry
+    {
+        std::string op;
+        std::vector<FieldValueTuple> fvVector;
+    };
+    std::unordered_map<std::string, m_pending_entry> m_fdbPending;
+    std::unordered_map<std::string, m_pending_entry> m_imetPending;
+
+    void setPending(std::unordered_map<std::string, m_pending_entry> &pending, std::string key,
+                    std::string op, std::vector<FieldValueTuple> fvVector = {});
+
+    /* Kernel FDB updates, sent together in one netlink datagram */
+    struct nl_sock *m_nlSock = nullptr;
+    std::vector<char> m_kernelBatch;
+    uint32_t m_kernelBatchCount = 0;
+
+    void queueKernelMac(int nlmsg_type, std::string mac, std::string ifname, std::string vlan,
+                        short fdb_type, std::string vtep = "");
+    void flushKernelMacs();
+
     void addLocalMac(std::string key, std::string op);
     void macAddVxlan(std::string key, struct in_addr vtep, std::string type, uint32_t vni, std::string intf_name);
     void macDelVxlan(std::string auxkey);
@@ -92,6 +92,9 @@ int main(int argc, char **argv)
                         }
                     }
                 }
+
+                /* Changes of the events handled above are written together */
+                sync.flushPending();
             }
         }
         catch (const std::exception& e)
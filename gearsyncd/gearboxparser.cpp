@@ -26,6 +26,7 @@ void GearboxParser::notifyGearboxConfigDone(bool success)
     std::vector<swss::FieldValueTuple> attrs = { finish_notice };
 
     p->set("GearboxConfigDone", attrs);
+    flush();
 }
 
 bool GearboxParser::parse()
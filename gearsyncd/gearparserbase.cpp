@@ -25,7 +25,22 @@ GearParserBase::init()
     m_writeToDb = false;
     m_rootInit = false;
     m_applDb = std::unique_ptr<swss::DBConnector>{new swss::DBConnector(APPL_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0)};
-    m_producerStateTable = std::unique_ptr<swss::ProducerStateTable>{new swss::ProducerStateTable(m_applDb.get(), APP_GEARBOX_TABLE_NAME)};
+    m_pipeline = getApplPipeline(m_applDb.get());
+    m_producerStateTable = std::unique_ptr<swss::ProducerStateTable>{new swss::ProducerStateTable(m_pipeline.get(), APP_GEARBOX_TABLE_NAME, true)};
+}
+
+std::shared_ptr<swss::RedisPipeline>
+GearParserBase::getApplPipeline(swss::DBConnector *db)
+{
+    static std::weak_ptr<swss::RedisPipeline> shared;
+
+    std::shared_ptr<swss::RedisPipeline> pipeline = shared.lock();
+    if (!pipeline)
+    {
+        pipeline = std::make_shared<swss::RedisPipeline>(db);
+        shared = pipeline;
+    }
+    return pipeline;
 }
 
 GearParserBase::GearParserBase() 
@@ -18,6 +18,7 @@
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redispipeline.h"
 #include <string>
 #include <memory>
 #include <vector>
@@ -41,6 +42,7 @@ public:
     void setConfigPath(std::string &path) {m_cfgPath = path;}
     const std::string getConfigPath() {return m_cfgPath;}
     std::unique_ptr<swss::ProducerStateTable> &getProducerStateTable() {return m_producerStateTable;}
+    void flush() {m_pipeline->flush();}
 
 protected:
     bool writeToDb(std::string &key, std::vector<swss::FieldValueTuple> &attrs);
@@ -48,9 +50,13 @@ protected:
 
 private:
     void init();
+    static std::shared_ptr<swss::RedisPipeline> getApplPipeline(swss::DBConnector *db);
     std::unique_ptr<swss::DBConnector> m_cfgDb;
     std::unique_ptr<swss::DBConnector> m_applDb;
     std::unique_ptr<swss::DBConnector> m_stateDb;
+    // Shared by the gearbox parser and the PHY parsers it creates, the writes
+    // are sent in batches and flushed once the config is done
+    std::shared_ptr<swss::RedisPipeline> m_pipeline;
     std::unique_ptr<swss::ProducerStateTable> m_producerStateTable;
     std::string m_cfgPath;
     bool m_writeToDb;
@@ -20,6 +20,7 @@
 #include <map>
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redispipeline.h"
 #include "warm_restart.h"
 #include "gearboxparser.h"
 #include "gearboxutils.h"
@@ -48,6 +49,7 @@ static void notifyGearboxConfigDone(ProducerStateTable &p, bool success)
     std::vector<FieldValueTuple> attrs = { finish_notice };
 
     p.set("GearboxConfigDone", attrs);
+    p.flush();
 }
 
 int main(int argc, char **argv)
@@ -76,7 +78,8 @@ int main(int argc, char **argv)
 
     DBConnector cfgDb(CONFIG_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     DBConnector applDb(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
-    ProducerStateTable producerStateTable(&applDb, APP_GEARBOX_TABLE_NAME);
+    RedisPipeline pipeline(&applDb);
+    ProducerStateTable producerStateTable(&pipeline, APP_GEARBOX_TABLE_NAME, true);
 
     WarmStart::initialize("gearsyncd", "swss");
     WarmStart::checkWarmStart("gearsyncd", "swss");
@@ -35,139 +35,63 @@
 using namespace swss;
 using namespace std;
 
-void MclagLink::getOidToPortNameMap(std::unordered_map<std::string, std:: string> & port_map)
+std::string MclagLink::getFdbKey(unsigned int vid, const std::string &mac)
 {
-    auto hash = p_counters_db->hgetall("COUNTERS_PORT_NAME_MAP");
+    std::string key = to_string(vid) + ":" + mac;
 
-    for (auto it = hash.begin(); it != hash.end(); ++it)
-        port_map.insert(pair<string, string>(it->second, it->first));
+    /* MAC addresses are exchanged with iccpd in the upper case ASIC_DB format */
+    transform(key.begin(), key.end(), key.begin(), ::toupper);
 
-    return;
+    return key;
 }
 
-void MclagLink::getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: string> *oid_map)
+void MclagLink::processStateFdb()
 {
-    std::string bridge_port_id;
-    size_t pos1 = 0;
+    std::deque<KeyOpFieldsValuesTuple> entries;
 
-    auto keys = p_asic_db->keys("ASIC_STATE:SAI_OBJECT_TYPE_BRIDGE_PORT:*");
+    p_state_fdb_tbl->pops(entries);
 
-    for (auto& key : keys)
+    for (auto& entry : entries)
     {
-        pos1 = key.find("oid:", 0);
-        bridge_port_id = key.substr(pos1);
+        const std::string& key = kfvKey(entry);
+        const std::string& op = kfvOp(entry);
 
-        auto hash = p_asic_db->hgetall(key);
-        auto attr_port_id = hash.find("SAI_BRIDGE_PORT_ATTR_PORT_ID");
-        if (attr_port_id == hash.end())
+        /*key format: Vlan<vid>:<mac>*/
+        size_t pos = key.find(":");
+        if (pos == key.npos || key.compare(0, 4, "Vlan") != 0)
         {
-            attr_port_id = hash.find("SAI_BRIDGE_PORT_ATTR_TUNNEL_ID");
-            if (attr_port_id == hash.end())
-                continue;
+            SWSS_LOG_DEBUG("Ignore state fdb entry with unexpected key %s", key.c_str());
+            continue;
         }
 
-        oid_map->insert(pair<string, string>(bridge_port_id, attr_port_id->second));
-    }
-
-    return;
-}
-
-void MclagLink::getVidByBvid(std::string &bvid, std::string &vlanid)
-{
-    std::string pre = "ASIC_STATE:SAI_OBJECT_TYPE_VLAN:";
-    std::string key = pre + bvid;
+        unsigned int vid = (unsigned int)atoi(key.substr(4, pos - 4).c_str());
+        std::string mac = key.substr(pos + 1);
+        transform(mac.begin(), mac.end(), mac.begin(), ::toupper);
 
-    auto hash = p_asic_db->hgetall(key.c_str());
-
-    auto attr_vlan_id = hash.find("SAI_VLAN_ATTR_VLAN_ID");
-    if (attr_vlan_id == hash.end())
-        return;
+        std::string fdb_key = getFdbKey(vid, mac);
 
-    vlanid = attr_vlan_id->second;
-    return;
-}
-
-void MclagLink::getFdbSet(std::set<mclag_fdb> *fdb_set)
-{
-    string bvid;
-    string bri_port_id;
-    string port_name;
-    string mac;
-    string type;
-    string vlanid;
-    int vid;
-    size_t pos1 = 0;
-    size_t pos2 = 0;
-    std::unordered_map<std::string, std:: string> oid_to_portname_map;
-    std::map<std::string, std:: string> brPortId_to_attrPortId_map;
-    std::map<std::string, std::string>::iterator brPortId_to_attrPortId_it;
-
-    auto keys = p_asic_db->keys("ASIC_STATE:SAI_OBJECT_TYPE_FDB_ENTRY:*");
-
-    for (auto& key : keys)
-    {
-        /*get vid*/
-        pos1 = key.find("vlan", 0);
-        if (pos1 != key.npos)
+        if (op == SET_COMMAND)
         {
-            pos1 = pos1 + 7;
-            pos2 = key.find(",", pos1) - 2;
-            vlanid = key.substr(pos1, pos2 - pos1 + 1);
-        }
-        else
-        {
-            pos1 = key.find("oid:", 0);
-            pos2 = key.find(",", 0) - 2;
-            bvid = key.substr(pos1, pos2 - pos1 + 1);
-            getVidByBvid(bvid, vlanid);
-        }
+            mclag_fdb fdb(mac, vid, "", "dynamic");
 
-        vid = atoi(vlanid.c_str());
-        /*get mac*/
-        pos1 = key.find("mac", 0) + 6;
-        pos2 = key.find(",", pos1) - 2;
-        mac = key.substr(pos1, pos2 - pos1 + 1);
+            for (auto& fv : kfvFieldsValues(entry))
+            {
+                if (fvField(fv) == "port")
+                    fdb.port_name = fvValue(fv);
+                else if (fvField(fv) == "type")
+                    fdb.type = fvValue(fv);
+            }
 
-        /*get type*/
-        auto hash = p_asic_db->hgetall(key);
-        auto type_it = hash.find("SAI_FDB_ENTRY_ATTR_TYPE");
-        if (type_it == hash.end())
-        {
-            continue;
+            SWSS_LOG_DEBUG("Read one fdb entry(MAC:%s, vid:%d, port_name:%s, type:%s) from STATE_DB.",
+                            mac.c_str(), vid, fdb.port_name.c_str(), fdb.type.c_str());
+            m_fdb_view[fdb_key] = fdb;
         }
-
-        if (memcmp(type_it->second.c_str(), "SAI_FDB_ENTRY_TYPE_DYNAMIC", type_it->second.length()) == 0)
-            type = "dynamic";
         else
-            type = "static";
-
-        /*get port name*/
-        getOidToPortNameMap(oid_to_portname_map);
-        getBridgePortIdToAttrPortIdMap(&brPortId_to_attrPortId_map);
-        auto brPortId_it = hash.find("SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID");
-        if (brPortId_it == hash.end())
-        {
-            continue;
-        }
-        bri_port_id = brPortId_it->second;
-
-        brPortId_to_attrPortId_it = brPortId_to_attrPortId_map.find(bri_port_id);
-        if (brPortId_to_attrPortId_it == brPortId_to_attrPortId_map.end())
         {
-            continue;
+            m_fdb_view.erase(fdb_key);
         }
 
-        auto oid_to_portName_it = oid_to_portname_map.find(brPortId_to_attrPortId_it->second);
-        if (oid_to_portName_it == oid_to_portname_map.end())
-        {
-            continue;
-        }
-
-        port_name = oid_to_portName_it->second;
-
-        /*insert set*/
-        SWSS_LOG_DEBUG("Read one fdb entry(MAC:%s, vid:%d, port_name:%s, type:%s) from ASIC_DB and insert new_set.", mac.c_str(), vid, port_name.c_str(), type.c_str());
-        fdb_set->insert(mclag_fdb(mac, vid, port_name, type));
+        m_fdb_dirty.insert(fdb_key);
     }
 
     return;
@@ -363,7 +287,8 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
     short count = 0;
     int index = 0;
     int exist = 0;
-    set <mclag_fdb>::iterator it;
+    string old_key;
+    mclag_fdb_map::iterator it;
 
     cur = msg;
     count = (short)(msg_len / sizeof(struct mclag_fdb_info));
@@ -382,7 +307,8 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
         else
             fdb.type = "dynamic";
 
-        if ((it = find(p_old_fdb->begin(), p_old_fdb->end(), fdb)) == p_old_fdb->end())
+        old_key = getFdbKey(fdb.vid, fdb.mac);
+        if ((it = p_old_fdb->find(old_key)) == p_old_fdb->end())
             exist = 0;
         else
             exist = 1;
@@ -404,27 +330,21 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
 
             if (exist == 0)
             {
-                p_old_fdb->insert(fdb);
+                p_old_fdb->emplace(old_key, fdb);
                 SWSS_LOG_DEBUG("Insert node(portname =%s, mac =%s, vid =%d, type =%s) into old_fdb_set",
                                 fdb.port_name.c_str(), fdb.mac.c_str(), fdb.vid, fdb.type.c_str());
             }
             else
             {
-                if (it->port_name == fdb.port_name && it->type == fdb.type)
+                if (it->second.port_name == fdb.port_name && it->second.type == fdb.type)
                 {
                     SWSS_LOG_DEBUG("All items of mac is same (mac =%s, vid =%d, portname :%s ==> %s, type:%s ==>%s), return.",
-                                fdb.mac.c_str(), fdb.vid, it->port_name.c_str(), fdb.port_name.c_str(), it->type.c_str(), fdb.type.c_str());
+                                fdb.mac.c_str(), fdb.vid, it->second.port_name.c_str(), fdb.port_name.c_str(), it->second.type.c_str(), fdb.type.c_str());
                     return;
                 }
                 SWSS_LOG_DEBUG("Modify node(mac =%s, vid =%d, portname :%s ==> %s, type:%s ==>%s)",
-                                fdb.mac.c_str(), fdb.vid, it->port_name.c_str(), fdb.port_name.c_str(), it->type.c_str(), fdb.type.c_str());
-                p_old_fdb->erase(it);
-                p_old_fdb->insert(fdb);
-                #if 0
-                fdb_entry = &(*it);
-                fdb_entry->port_name = fdb.port_name;
-                fdb_entry->type = fdb.type;
-                #endif
+                                fdb.mac.c_str(), fdb.vid, it->second.port_name.c_str(), fdb.port_name.c_str(), it->second.type.c_str(), fdb.type.c_str());
+                it->second = fdb;
             }
 
             p_fdb_tbl->set(fdb_key, attrs);
@@ -435,7 +355,7 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
             if (exist)
             {
                 SWSS_LOG_DEBUG("Erase node(portname =%s, mac =%s, vid =%d, type =%s) from old_fdb_set",
-                                it->port_name.c_str(), it->mac.c_str(), it->vid, it->type.c_str());
+                                it->second.port_name.c_str(), it->second.mac.c_str(), it->second.vid, it->second.type.c_str());
                 p_old_fdb->erase(it);
             }
             p_fdb_tbl->del(fdb_key);
@@ -446,115 +366,108 @@ void MclagLink::setFdbEntry(char *msg, int msg_len)
     return;
 }
 
-ssize_t  MclagLink::getFdbChange(char *msg_buf)
+ssize_t MclagLink::sendFdbInfo(char *msg_buf, size_t &infor_len, const mclag_fdb &fdb, short op_type)
 {
-    set <mclag_fdb> new_fdb;
-    set <mclag_fdb> del_fdb;
-    set <mclag_fdb> add_fdb;
     struct mclag_fdb_info info;
     mclag_msg_hdr_t * msg_head = NULL;
-    ssize_t write = 0;
-    size_t infor_len = 0;
-    char *infor_start = msg_buf;
-    set <mclag_fdb> *p_new_fdb = &new_fdb;
+    ssize_t write = 1;
 
-    del_fdb.clear();
-    add_fdb.clear();
-    p_new_fdb->clear();
+    if (MCLAG_MAX_SEND_MSG_LEN - infor_len < sizeof(struct mclag_fdb_info))
+    {
+        msg_head = reinterpret_cast<mclag_msg_hdr_t *>(static_cast<void *>(msg_buf));
+        msg_head->version = 1;
+        msg_head->msg_len = (unsigned short)infor_len;
+        msg_head->msg_type = MCLAG_SYNCD_MSG_TYPE_FDB_OPERATION;
+
+        SWSS_LOG_DEBUG("Mclagsycnd send msg to iccpd, msg_len =%d, msg_type =%d",
+                        msg_head->msg_len, msg_head->msg_type);
+        write = ::write(m_connection_socket, msg_buf, msg_head->msg_len);
+        if (write <= 0)
+            return write;
+
+        infor_len = sizeof(mclag_msg_hdr_t);
+    }
 
-    infor_len = infor_len + sizeof(mclag_msg_hdr_t);
+    SWSS_LOG_DEBUG("Notify iccpd to %s fdb_entry:mac:%s, vid:%d, portname:%s, type:%s",
+                    op_type == MCLAG_FDB_OPER_ADD ? "add" : "del",
+                    fdb.mac.c_str(), fdb.vid, fdb.port_name.c_str(), fdb.type.c_str());
+    memset(&info, 0, sizeof(struct mclag_fdb_info));
+    info.op_type = op_type;
+    memcpy(info.mac, fdb.mac.c_str(), std::min(fdb.mac.length(), sizeof(info.mac) - 1));
+    info.vid = fdb.vid;
+    memcpy(info.port_name, fdb.port_name.c_str(), std::min(fdb.port_name.length(), sizeof(info.port_name) - 1));
+    if (fdb.type == "dynamic")
+        info.type = MCLAG_FDB_TYPE_DYNAMIC;
+    else
+        info.type = MCLAG_FDB_TYPE_STATIC;
 
-    getFdbSet(p_new_fdb);
+    memcpy((char*)(msg_buf + infor_len), (char*)&info, sizeof(struct mclag_fdb_info));
+    infor_len = infor_len + sizeof(struct mclag_fdb_info);
+
+    return write;
+}
 
-    set_difference(p_old_fdb->begin(), p_old_fdb->end(), p_new_fdb->begin(),
-                   p_new_fdb->end(), inserter(del_fdb, del_fdb.begin()));
-    set_difference(p_new_fdb->begin(), p_new_fdb->end(), p_old_fdb->begin(),
-                   p_old_fdb->end(), inserter(add_fdb, add_fdb.begin()));
+/*
+ * Only the entries changed in STATE_DB since the last request are compared
+ * against the set already known to iccpd, instead of diffing the whole FDB.
+ */
+ssize_t  MclagLink::getFdbChange(char *msg_buf)
+{
+    vector<mclag_fdb> del_fdb;
+    vector<mclag_fdb> add_fdb;
+    mclag_msg_hdr_t * msg_head = NULL;
+    ssize_t write = 0;
+    size_t infor_len = 0;
+    char *infor_start = msg_buf;
 
-    p_old_fdb->swap(*p_new_fdb);
+    infor_len = infor_len + sizeof(mclag_msg_hdr_t);
 
-    /*Remove the same item from del set, this may be MAC move*/
-    auto itdel = del_fdb.begin();
-    while (itdel != del_fdb.end())
+    for (auto& key : m_fdb_dirty)
     {
-        auto ittmp = itdel;
-        itdel++;
-        for (auto itadd = add_fdb.begin(); itadd != add_fdb.end(); itadd++)
+        auto new_it = m_fdb_view.find(key);
+        auto old_it = p_old_fdb->find(key);
+
+        if (new_it == m_fdb_view.end())
         {
-            if (ittmp->mac == itadd->mac && ittmp->vid == itadd->vid)
+            if (old_it != p_old_fdb->end())
             {
-                SWSS_LOG_DEBUG("Mac move: mac %s, vid %d, portname %s, type %s",
-                        ittmp->mac.c_str(), ittmp->vid, ittmp->port_name.c_str(), ittmp->type.c_str());
-                del_fdb.erase(ittmp);
-                break;
+                del_fdb.push_back(old_it->second);
+                p_old_fdb->erase(old_it);
             }
+            continue;
         }
-    }
 
-    for (auto it = del_fdb.begin(); it != del_fdb.end(); it++)
-    {
-        if (MCLAG_MAX_SEND_MSG_LEN - infor_len < sizeof(struct mclag_fdb_info))
+        if (old_it == p_old_fdb->end())
         {
-            msg_head = reinterpret_cast<mclag_msg_hdr_t *>(static_cast<void *>(infor_start));
-            msg_head->version = 1;
-            msg_head->msg_len = (unsigned short)infor_len;
-            msg_head->msg_type = MCLAG_SYNCD_MSG_TYPE_FDB_OPERATION;
-
-            SWSS_LOG_DEBUG("Mclagsycnd send msg to iccpd, msg_len =%d, msg_type =%d",
-                            msg_head->msg_len, msg_head->msg_type);
-            write = ::write(m_connection_socket, infor_start, msg_head->msg_len);
-            if (write <= 0)
-                return write;
-
-            infor_len = sizeof(mclag_msg_hdr_t);
+            add_fdb.push_back(new_it->second);
+            p_old_fdb->emplace(key, new_it->second);
+            continue;
         }
-        SWSS_LOG_DEBUG("Notify iccpd to del fdb_entry:mac:%s, vid:%d, portname:%s, type:%s",
-                        it->mac.c_str(), it->vid, it->port_name.c_str(), it->type.c_str());
-        memset(&info, 0, sizeof(struct mclag_fdb_info));
-        info.op_type = MCLAG_FDB_OPER_DEL;
-        memcpy(info.mac, it->mac.c_str(), it->mac.length());
-        info.vid = it->vid;
-        memcpy(info.port_name, it->port_name.c_str(), it->port_name.length());
-        if (memcmp(it->type.c_str(), "SAI_FDB_ENTRY_TYPE_DYNAMIC", it->type.length()) == 0)
-            info.type = MCLAG_FDB_TYPE_DYNAMIC;
-        else
-            info.type = MCLAG_FDB_TYPE_STATIC;
 
-        memcpy((char*)(infor_start + infor_len), (char*)&info, sizeof(struct mclag_fdb_info));
-        infor_len = infor_len + sizeof(struct mclag_fdb_info);
+        if (old_it->second.port_name != new_it->second.port_name)
+        {
+            /*Only the add is sent for a mac move*/
+            SWSS_LOG_DEBUG("Mac move: mac %s, vid %d, portname %s, type %s",
+                    old_it->second.mac.c_str(), old_it->second.vid, old_it->second.port_name.c_str(), old_it->second.type.c_str());
+            add_fdb.push_back(new_it->second);
+        }
+        old_it->second = new_it->second;
     }
 
-    for (auto it = add_fdb.begin(); it != add_fdb.end(); it++)
+    m_fdb_dirty.clear();
+
+    for (auto& fdb : del_fdb)
     {
-        if (MCLAG_MAX_SEND_MSG_LEN - infor_len < sizeof(struct mclag_fdb_info))
-        {
-            msg_head = reinterpret_cast<mclag_msg_hdr_t *>(static_cast<void *>(infor_start));
-            msg_head->version = 1;
-            msg_head->msg_len = (unsigned short)infor_len;
-            msg_head->msg_type = MCLAG_SYNCD_MSG_TYPE_FDB_OPERATION;
-
-            /*SWSS_LOG_DEBUG("Mclagsycnd send msg to iccpd, msg_len =%d, msg_type =%d",
-                            msg_head->msg_len, msg_head->msg_type);*/
-            write = ::write(m_connection_socket, infor_start, msg_head->msg_len);
-            if (write <= 0)
-                return write;
-
-            infor_len = sizeof(mclag_msg_hdr_t);
-        }
-        SWSS_LOG_DEBUG("Notify iccpd to add fdb_entry:mac:%s, vid:%d, portname:%s, type:%s",
-                        it->mac.c_str(), it->vid, it->port_name.c_str(), it->type.c_str());
-        memset(&info, 0, sizeof(struct mclag_fdb_info));
-        info.op_type = MCLAG_FDB_OPER_ADD;
-        memcpy(info.mac, it->mac.c_str(), it->mac.length());
-        info.vid = it->vid;
-        memcpy(info.port_name, it->port_name.c_str(), it->port_name.length());
-        if (memcmp(it->type.c_str(), "dynamic", it->type.length()) == 0)
-            info.type = MCLAG_FDB_TYPE_DYNAMIC;
-        else
-            info.type = MCLAG_FDB_TYPE_STATIC;
+        write = sendFdbInfo(infor_start, infor_len, fdb, MCLAG_FDB_OPER_DEL);
+        if (write <= 0)
+            return write;
+    }
 
-        memcpy((char*)(infor_start + infor_len), (char*)&info, sizeof(struct mclag_fdb_info));
-        infor_len = infor_len +  sizeof(struct mclag_fdb_info);
+    for (auto& fdb : add_fdb)
+    {
+        write = sendFdbInfo(infor_start, infor_len, fdb, MCLAG_FDB_OPER_ADD);
+        if (write <= 0)
+            return write;
     }
 
     if (infor_len <= sizeof(mclag_msg_hdr_t)) /*no fdb entry need notifying iccpd*/
@@ -644,6 +557,15 @@ void MclagLink::accept()
         throw system_error(errno, system_category());
 
     SWSS_LOG_NOTICE("New connection accepted from: %s", inet_ntoa(client_addr.sin_addr));
+
+    /*
+     * Entries sent to iccpd before the reconnect are compared again on the next
+     * request, so that the ones removed while iccpd was away are deleted.
+     */
+    for (auto& old_fdb : *p_old_fdb)
+    {
+        m_fdb_dirty.insert(old_fdb.first);
+    }
 }
 
 int MclagLink::getFd()
@@ -33,8 +33,11 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "producerstatetable.h"
+#include "subscriberstatetable.h"
 #include "selectable.h"
 #include "mclagsyncd/mclag.h"
 
@@ -90,6 +93,9 @@ struct mclag_fdb
 
 };
 
+/* FDB entries keyed by "<vid>:<MAC>", see getFdbKey() */
+typedef std::unordered_map<std::string, mclag_fdb> mclag_fdb_map;
+
 class MclagLink : public Selectable {
 public:
     const int MSG_BATCH_SIZE;
@@ -101,19 +107,21 @@ public:
     ProducerStateTable *p_acl_table_tbl;
     ProducerStateTable *p_acl_rule_tbl;
     DBConnector *p_appl_db;
-    DBConnector *p_asic_db; /*redis client access to ASIC_DB*/
-    DBConnector *p_counters_db; /*redis client access to COUNTERS_DB*/
-    std::set <mclag_fdb> *p_old_fdb;
+    SubscriberStateTable *p_state_fdb_tbl; /*local FDB entries published by orchagent in STATE_DB*/
+    mclag_fdb_map *p_old_fdb; /*FDB entries already known to iccpd*/
 
     MclagLink(uint16_t port = MCLAG_DEFAULT_PORT);
     virtual ~MclagLink();
 
-    /* Wait for connection (blocking) */
+    /* Wait for connection (blocking), then resync the entries known to iccpd */
     void accept();
 
     int getFd() override;
     uint64_t readData() override;
 
+    /* Apply STATE_DB FDB_TABLE changes to the local FDB view */
+    void processStateFdb();
+
     /* readMe throws MclagConnectionClosedException when connection is lost */
     class MclagConnectionClosedException : public std::exception
     {
@@ -130,10 +138,13 @@ private:
     int m_server_socket;
     int m_connection_socket;
 
-    void getOidToPortNameMap(std::unordered_map<std::string, std:: string> & port_map);
-    void getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: string> *oid_map);
-    void getVidByBvid(std::string &bvid, std::string &vlanid);
-    void getFdbSet(std::set<mclag_fdb> *fdb_set);
+    /* Current local FDB, kept in sync with STATE_DB FDB_TABLE */
+    mclag_fdb_map m_fdb_view;
+    /* Keys changed in m_fdb_view since the last report to iccpd */
+    std::unordered_set<std::string> m_fdb_dirty;
+
+    static std::string getFdbKey(unsigned int vid, const std::string &mac);
+    ssize_t sendFdbInfo(char *msg_buf, size_t &infor_len, const mclag_fdb &fdb, short op_type);
     void setPortIsolate(char *msg);
     void setPortMacLearnMode(char *msg);
     void setFdbFlush();
@@ -32,8 +32,7 @@ int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("mclagsyncd");
     DBConnector appl_db("APPL_DB", 0);
-    DBConnector asic_db("ASIC_DB", 0);
-    DBConnector counters_db("COUNTERS_DB", 0);
+    DBConnector state_db("STATE_DB", 0);
     ProducerStateTable port_tbl(&appl_db, APP_PORT_TABLE_NAME);
     ProducerStateTable lag_tbl(&appl_db, APP_LAG_TABLE_NAME);
     ProducerStateTable tnl_tbl(&appl_db, APP_VXLAN_TUNNEL_TABLE_NAME);
@@ -43,7 +42,7 @@ int main(int argc, char **argv)
     ProducerStateTable acl_rule_tbl(&appl_db, APP_ACL_RULE_TABLE_NAME);
     map <string, string> isolate;
     RedisPipeline pipeline(&appl_db);
-    set <mclag_fdb> old_fdb;
+    mclag_fdb_map old_fdb;
 
     while (1)
     {
@@ -51,6 +50,7 @@ int main(int argc, char **argv)
         {
             MclagLink mclag;
             Select s;
+            SubscriberStateTable state_fdb_tbl(&state_db, STATE_FDB_TABLE_NAME);
 
             mclag.p_port_tbl = &port_tbl;
             mclag.p_lag_tbl = &lag_tbl;
@@ -60,15 +60,18 @@ int main(int argc, char **argv)
             mclag.p_acl_table_tbl = &acl_table_tbl;
             mclag.p_acl_rule_tbl = &acl_rule_tbl;
             mclag.p_appl_db = &appl_db;
-            mclag.p_asic_db = &asic_db;
-            mclag.p_counters_db = &counters_db;
+            mclag.p_state_fdb_tbl = &state_fdb_tbl;
             mclag.p_old_fdb = &old_fdb;
 
+            /* Load the current local FDB before diffing it against the entries known to iccpd */
+            mclag.processStateFdb();
+
             cout << "Waiting for connection..." << endl;
             mclag.accept();
             cout << "Connected!" << endl;
 
             s.addSelectable(&mclag);
+            s.addSelectable(&state_fdb_tbl);
 
             while (true)
             {
@@ -76,6 +79,12 @@ int main(int argc, char **argv)
 
                 /* Reading MCLAG messages forever (and calling "readData" to read them) */
                 s.select(&temps);
+
+                if (temps == (Selectable *)&state_fdb_tbl)
+                {
+                    mclag.processStateFdb();
+                }
+
                 pipeline.flush();
                 SWSS_LOG_DEBUG("Pipeline flushed");
             }
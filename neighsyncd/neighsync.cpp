@@ -1,5 +1,6 @@
 #include <string>
 #include <netinet/in.h>
+#include <net/ethernet.h>
 #include <netlink/route/link.h>
 #include <netlink/route/neighbour.h>
 
@@ -18,8 +19,10 @@ using namespace std;
 using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
-    m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME)
+    m_pipeline(pipelineAppDB),
+    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true),
+    m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
+    m_stateNeighSyncStatsTable(stateDb, STATE_NEIGH_SYNC_STATS_TABLE_NAME)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
@@ -50,8 +53,68 @@ bool NeighSync::isNeighRestoreDone()
     return false;
 }
 
+void NeighSync::flush()
+{
+    m_pipeline->flush();
+}
+
+void NeighSync::publishStats()
+{
+    std::vector<FieldValueTuple> fvVector;
+    fvVector.emplace_back("entries", to_string(m_neighEntries.size() - m_deletedEntries));
+    fvVector.emplace_back("set", to_string(m_setCount));
+    fvVector.emplace_back("del", to_string(m_delCount));
+    fvVector.emplace_back("suppressed", to_string(m_suppressedCount));
+    m_stateNeighSyncStatsTable.set("neighsyncd", fvVector);
+}
+
+void NeighSync::updateNeighEntry(const NeighKey &key, const MacAddress &mac, int family, bool deleted)
+{
+    auto rc = m_neighEntries.emplace(key, NeighData{mac, family, deleted});
+    auto &data = rc.first->second;
+
+    if (!rc.second)
+    {
+        if (data.deleted && !deleted)
+        {
+            m_deletedEntries--;
+        }
+        else if (!data.deleted && deleted)
+        {
+            m_deletedEntries++;
+        }
+        data = {mac, family, deleted};
+    }
+    else if (deleted)
+    {
+        m_deletedEntries++;
+    }
+
+    /*
+     * Deleted entries are only kept to drop repeated INCOMPLETE/FAILED
+     * notifications; forgetting them merely lets one more delete through.
+     */
+    if (m_deletedEntries > NEIGHSYNC_MAX_DELETED_ENTRIES)
+    {
+        for (auto it = m_neighEntries.begin(); it != m_neighEntries.end();)
+        {
+            if (it->second.deleted)
+            {
+                it = m_neighEntries.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+        m_deletedEntries = 0;
+    }
+}
+
 void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
+    static const MacAddress broadcastMac("ff:ff:ff:ff:ff:ff");
+
     char ipStr[MAX_ADDR_SIZE + 1] = {0};
     char macStr[MAX_ADDR_SIZE + 1] = {0};
     struct rtnl_neigh *neigh = (struct rtnl_neigh *)obj;
@@ -62,21 +125,18 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
         (nlmsg_type != RTM_DELNEIGH))
         return;
 
-    if (rtnl_neigh_get_family(neigh) == AF_INET)
+    int af = rtnl_neigh_get_family(neigh);
+    if (af == AF_INET)
         family = IPV4_NAME;
-    else if (rtnl_neigh_get_family(neigh) == AF_INET6)
+    else if (af == AF_INET6)
         family = IPV6_NAME;
     else
         return;
 
-    key+= LinkCache::getInstance().ifindexToName(rtnl_neigh_get_ifindex(neigh));
-    key+= ":";
-
-    nl_addr2str(rtnl_neigh_get_dst(neigh), ipStr, MAX_ADDR_SIZE);
+    struct nl_addr *dst = rtnl_neigh_get_dst(neigh);
     /* Ignore IPv6 multicast link-local addresses as neighbors */
-    if (family == IPV6_NAME && IN6_IS_ADDR_MC_LINKLOCAL(nl_addr_get_binary_addr(rtnl_neigh_get_dst(neigh))))
+    if (af == AF_INET6 && IN6_IS_ADDR_MC_LINKLOCAL(nl_addr_get_binary_addr(dst)))
         return;
-    key+= ipStr;
 
     int state = rtnl_neigh_get_state(neigh);
     if (state == NUD_NOARP)
@@ -91,23 +151,74 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
 	    delete_key = true;
     }
 
-    nl_addr2str(rtnl_neigh_get_lladdr(neigh), macStr, MAX_ADDR_SIZE);
+    MacAddress mac;
+    struct nl_addr *lladdr = rtnl_neigh_get_lladdr(neigh);
+    if (lladdr && nl_addr_get_len(lladdr) == ETHER_ADDR_LEN)
+    {
+        mac = MacAddress(static_cast<const uint8_t *>(nl_addr_get_binary_addr(lladdr)));
+    }
+    else
+    {
+        nl_addr2str(lladdr, macStr, MAX_ADDR_SIZE);
+        if (!delete_key)
+        {
+            mac = MacAddress(macStr);
+        }
+    }
 
     /* Ignore neighbor entries with Broadcast Mac - Trigger for directed broadcast */
-    if (!delete_key && (MacAddress(macStr) == MacAddress("ff:ff:ff:ff:ff:ff")))
+    if (!delete_key && (mac == broadcastMac))
     {
+        nl_addr2str(dst, ipStr, MAX_ADDR_SIZE);
         SWSS_LOG_INFO("Broadcast Mac recieved, ignoring for %s", ipStr);
         return;
     }
 
+    NeighKey neighKey(rtnl_neigh_get_ifindex(neigh),
+                      string(static_cast<const char *>(nl_addr_get_binary_addr(dst)), nl_addr_get_len(dst)));
+
+    bool warmStartInProgress = m_AppRestartAssist->isWarmStartInProgress();
+
+    /*
+     * NUD state transitions (REACHABLE/STALE/DELAY/PROBE) are reported with the
+     * same MAC over and over; only changes visible to orchagent are published.
+     * During warm start the restart assist does its own reconciliation.
+     */
+    if (!warmStartInProgress)
+    {
+        auto found = m_neighEntries.find(neighKey);
+        if (found != m_neighEntries.end())
+        {
+            const NeighData &data = found->second;
+            if ((delete_key && data.deleted) ||
+                (!delete_key && !data.deleted && data.mac == mac && data.family == af))
+            {
+                m_suppressedCount++;
+                return;
+            }
+        }
+    }
+
+    key+= LinkCache::getInstance().ifindexToName(rtnl_neigh_get_ifindex(neigh));
+    key+= ":";
+
+    nl_addr2str(dst, ipStr, MAX_ADDR_SIZE);
+    key+= ipStr;
+
     std::vector<FieldValueTuple> fvVector;
     FieldValueTuple f("family", family);
+    if (macStr[0] == '\0')
+    {
+        nl_addr2str(lladdr, macStr, MAX_ADDR_SIZE);
+    }
     FieldValueTuple nh("neigh", macStr);
     fvVector.push_back(nh);
     fvVector.push_back(f);
 
+    updateNeighEntry(neighKey, mac, af, delete_key);
+
     // If warmstart is in progress, we take all netlink changes into the cache map
-    if (m_AppRestartAssist->isWarmStartInProgress())
+    if (warmStartInProgress)
     {
         m_AppRestartAssist->insertToMap(APP_NEIGH_TABLE_NAME, key, fvVector, delete_key);
     }
@@ -115,9 +226,11 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     {
         if (delete_key == true)
         {
+            m_delCount++;
             m_neighTable.del(key);
             return;
         }
+        m_setCount++;
         m_neighTable.set(key, fvVector);
     }
 }
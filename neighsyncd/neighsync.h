@@ -1,9 +1,13 @@
 #ifndef __NEIGHSYNC__
 #define __NEIGHSYNC__
 
+#include <map>
+#include <utility>
+
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "netmsg.h"
+#include "macaddress.h"
 #include "warmRestartAssist.h"
 
 // The timeout value (in seconds) for neighsyncd reconcilation logic
@@ -16,6 +20,17 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 120
 
+// Interval (in milliseconds) at which buffered APPL_DB updates are flushed
+#define NEIGHSYNC_FLUSH_INTERVAL_MSEC 50
+
+// Interval (in seconds) at which the publish/suppress counters are written to STATE_DB
+#define NEIGHSYNC_STATS_INTERVAL 10
+
+// Number of deleted entries kept to suppress repeated deletes before they are pruned
+#define NEIGHSYNC_MAX_DELETED_ENTRIES 65536
+
+#define STATE_NEIGH_SYNC_STATS_TABLE_NAME "NEIGH_SYNC_STATS_TABLE"
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -30,15 +45,43 @@ public:
 
     bool isNeighRestoreDone();
 
+    /* Write the buffered APPL_DB updates to redis */
+    void flush();
+
+    /* Write the publish/suppress counters to STATE_DB */
+    void publishStats();
+
     AppRestartAssist *getRestartAssist()
     {
         return m_AppRestartAssist;
     }
 
 private:
+    /* (ifindex, binary destination address) */
+    typedef std::pair<int, std::string> NeighKey;
+
+    /* Last state published to APPL_DB for a kernel neighbor */
+    struct NeighData
+    {
+        MacAddress mac;
+        int family;
+        bool deleted;
+    };
+
+    RedisPipeline *m_pipeline;
     Table m_stateNeighRestoreTable;
+    Table m_stateNeighSyncStatsTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
+
+    std::map<NeighKey, NeighData> m_neighEntries;
+    uint64_t m_deletedEntries = 0;
+
+    uint64_t m_setCount = 0;
+    uint64_t m_delCount = 0;
+    uint64_t m_suppressedCount = 0;
+
+    void updateNeighEntry(const NeighKey &key, const MacAddress &mac, int family, bool deleted);
 };
 
 }
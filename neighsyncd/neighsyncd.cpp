@@ -4,6 +4,7 @@
 #include <chrono>
 #include "logger.h"
 #include "select.h"
+#include "selectabletimer.h"
 #include "netdispatcher.h"
 #include "netlink.h"
 #include "neighsyncd/neighsync.h"
@@ -30,6 +31,14 @@ int main(int argc, char **argv)
         {
             NetLink netlink;
             Select s;
+            SelectableTimer flushTimer(timespec{0, NEIGHSYNC_FLUSH_INTERVAL_MSEC * 1000000});
+            SelectableTimer statsTimer(timespec{NEIGHSYNC_STATS_INTERVAL, 0});
+
+            /*
+             * Pipeline should be flushed right away to deal with state pending
+             * from previous try/catch iterations.
+             */
+            sync.flush();
 
             using namespace std::chrono;
             /*
@@ -66,10 +75,28 @@ int main(int argc, char **argv)
             netlink.dumpRequest(RTM_GETNEIGH);
 
             s.addSelectable(&netlink);
+
+            flushTimer.start();
+            s.addSelectable(&flushTimer);
+            statsTimer.start();
+            s.addSelectable(&statsTimer);
+
             while (true)
             {
                 Selectable *temps;
                 s.select(&temps);
+
+                if (temps == &flushTimer)
+                {
+                    sync.flush();
+                    continue;
+                }
+                else if (temps == &statsTimer)
+                {
+                    sync.publishStats();
+                    continue;
+                }
+
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
@@ -80,6 +107,7 @@ int main(int argc, char **argv)
                     {
                         sync.getRestartAssist()->stopReconcileTimer(s);
                         sync.getRestartAssist()->reconcile();
+                        sync.flush();
                     }
                 }
             }
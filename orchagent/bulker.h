@@ -47,6 +47,32 @@ static inline bool operator==(const sai_inseg_entry_t& a, const sai_inseg_entry_
         ;
 }
 
+static inline bool operator==(const sai_ip_address_t& a, const sai_ip_address_t& b)
+{
+    if (a.addr_family != b.addr_family) return false;
+
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.addr.ip4 == b.addr.ip4;
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        return memcmp(a.addr.ip6, b.addr.ip6, sizeof(a.addr.ip6)) == 0;
+    }
+    else
+    {
+        throw std::invalid_argument("a has invalid addr_family");
+    }
+}
+
+static inline bool operator==(const sai_neighbor_entry_t& a, const sai_neighbor_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.rif_id == b.rif_id
+        && a.ip_address == b.ip_address
+        ;
+}
+
 static inline std::size_t hash_value(const sai_ip_prefix_t& a)
 {
     size_t seed = 0;
@@ -64,6 +90,21 @@ static inline std::size_t hash_value(const sai_ip_prefix_t& a)
     return seed;
 }
 
+static inline std::size_t hash_value(const sai_ip_address_t& a)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, a.addr_family);
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        boost::hash_combine(seed, a.addr.ip4);
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        boost::hash_combine(seed, a.addr.ip6);
+    }
+    return seed;
+}
+
 namespace std
 {
     template <>
@@ -92,6 +133,19 @@ namespace std
         }
     };
 
+    template <>
+    struct hash<sai_neighbor_entry_t>
+    {
+        size_t operator()(const sai_neighbor_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.rif_id);
+            boost::hash_combine(seed, a.ip_address);
+            return seed;
+        }
+    };
+
     template <>
     struct hash<sai_inseg_entry_t>
     {
@@ -126,6 +180,16 @@ typedef sai_status_t (*sai_bulk_set_fdb_entry_attribute_fn)(
         _In_ sai_bulk_op_error_mode_t mode,
         _Out_ sai_status_t *object_statuses);
 
+/*
+ * Not every SAI implements the bulk APIs, the bulk function is then null or
+ * returns SAI_STATUS_NOT_IMPLEMENTED. The bulkers fall back to the per entry
+ * API in that case, and keep using it for the following flushes.
+ */
+static inline bool is_bulk_unsupported(sai_status_t status)
+{
+    return status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+}
+
 template<typename T>
 struct SaiBulkerTraits { };
 
@@ -182,6 +246,31 @@ struct SaiBulkerTraits<sai_mpls_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_inseg_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_neighbor_api_t>
+{
+    using entry_t = sai_neighbor_entry_t;
+    using api_t = sai_neighbor_api_t;
+    using create_entry_fn = sai_create_neighbor_entry_fn;
+    using remove_entry_fn = sai_remove_neighbor_entry_fn;
+    using set_entry_attribute_fn = sai_set_neighbor_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_neighbor_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_neighbor_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_next_hop_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_next_hop_api_t;
+    using create_entry_fn = sai_create_next_hop_fn;
+    using remove_entry_fn = sai_remove_next_hop_fn;
+    using set_entry_attribute_fn = sai_set_next_hop_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -326,7 +415,20 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+            if (remove_entries)
+            {
+                status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            }
+            if (is_bulk_unsupported(status))
+            {
+                SWSS_LOG_INFO("EntityBulker.flush bulk remove is not supported, removing %zu entries one by one\n", count);
+                remove_entries = nullptr;
+                for (size_t ir = 0; ir < count; ir++)
+                {
+                    statuses[ir] = (*serial_remove_entry)(&rs[ir]);
+                }
+            }
             SWSS_LOG_INFO("EntityBulker.flush removing_entries %zu\n", removing_entries.size());
 
             for (size_t ir = 0; ir < count; ir++)
@@ -362,8 +464,21 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
-                , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+            if (create_entries)
+            {
+                status = (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
+                    , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            }
+            if (is_bulk_unsupported(status))
+            {
+                SWSS_LOG_INFO("EntityBulker.flush bulk create is not supported, creating %zu entries one by one\n", count);
+                create_entries = nullptr;
+                for (size_t ir = 0; ir < count; ir++)
+                {
+                    statuses[ir] = (*serial_create_entry)(&rs[ir], cs[ir], tss[ir]);
+                }
+            }
             SWSS_LOG_INFO("EntityBulker.flush creating_entries %zu\n", creating_entries.size());
 
             for (size_t ir = 0; ir < count; ir++)
@@ -401,8 +516,21 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
-                , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+            if (set_entries_attribute)
+            {
+                status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
+                    , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            }
+            if (is_bulk_unsupported(status))
+            {
+                SWSS_LOG_INFO("EntityBulker.flush bulk set is not supported, setting %zu attributes one by one\n", count);
+                set_entries_attribute = nullptr;
+                for (size_t ir = 0; ir < count; ir++)
+                {
+                    statuses[ir] = (*serial_set_entry_attribute)(&rs[ir], &ts[ir]);
+                }
+            }
             SWSS_LOG_INFO("EntityBulker.flush setting_entries %zu, count %zu\n", setting_entries.size(), count);
 
             for (size_t ir = 0; ir < count; ir++)
@@ -475,6 +603,11 @@ private:
     typename Ts::bulk_create_entry_fn                       create_entries;
     typename Ts::bulk_remove_entry_fn                       remove_entries;
     typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
+
+    // Used when the SAI doesn't implement the bulk API
+    typename Ts::create_entry_fn                            serial_create_entry;
+    typename Ts::remove_entry_fn                            serial_remove_entry;
+    typename Ts::set_entry_attribute_fn                     serial_set_entry_attribute;
 };
 
 template <>
@@ -483,6 +616,9 @@ inline EntityBulker<sai_route_api_t>::EntityBulker(sai_route_api_t *api)
     create_entries = api->create_route_entries;
     remove_entries = api->remove_route_entries;
     set_entries_attribute = api->set_route_entries_attribute;
+    serial_create_entry = api->create_route_entry;
+    serial_remove_entry = api->remove_route_entry;
+    serial_set_entry_attribute = api->set_route_entry_attribute;
 }
 
 template <>
@@ -503,6 +639,20 @@ inline EntityBulker<sai_mpls_api_t>::EntityBulker(sai_mpls_api_t *api)
     create_entries = api->create_inseg_entries;
     remove_entries = api->remove_inseg_entries;
     set_entries_attribute = api->set_inseg_entries_attribute;
+    serial_create_entry = api->create_inseg_entry;
+    serial_remove_entry = api->remove_inseg_entry;
+    serial_set_entry_attribute = api->set_inseg_entry_attribute;
+}
+
+template <>
+inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api)
+{
+    create_entries = api->create_neighbor_entries;
+    remove_entries = api->remove_neighbor_entries;
+    set_entries_attribute = api->set_neighbor_entries_attribute;
+    serial_create_entry = api->create_neighbor_entry;
+    serial_remove_entry = api->remove_neighbor_entry;
+    serial_set_entry_attribute = api->set_neighbor_entry_attribute;
 }
 
 template <typename T>
@@ -596,7 +746,25 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+            sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+            if (remove_entries)
+            {
+                status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+            }
+            if (is_bulk_unsupported(status))
+            {
+                SWSS_LOG_INFO("ObjectBulker.flush bulk remove is not supported, removing %zu objects one by one\n", count);
+                remove_entries = nullptr;
+                std::fill(statuses.begin(), statuses.end(), SAI_STATUS_NOT_EXECUTED);
+                for (size_t i = 0; i < count; i++)
+                {
+                    status = statuses[i] = (*serial_remove_entry)(rs[i]);
+                    if (status != SAI_STATUS_SUCCESS)
+                    {
+                        break;
+                    }
+                }
+            }
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
 
             for (size_t i = 0; i < count; i++)
@@ -627,8 +795,26 @@ public:
             size_t count = creating_entries.size();
             std::vector<sai_object_id_t> object_ids(count);
             std::vector<sai_status_t> statuses(count);
-            (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-                , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+            if (create_entries)
+            {
+                status = (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
+                    , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            }
+            if (is_bulk_unsupported(status))
+            {
+                SWSS_LOG_INFO("ObjectBulker.flush bulk create is not supported, creating %zu objects one by one\n", count);
+                create_entries = nullptr;
+                std::fill(statuses.begin(), statuses.end(), SAI_STATUS_NOT_EXECUTED);
+                for (size_t i = 0; i < count; i++)
+                {
+                    statuses[i] = (*serial_create_entry)(&object_ids[i], switch_id, cs[i], tss[i]);
+                    if (statuses[i] != SAI_STATUS_SUCCESS)
+                    {
+                        break;
+                    }
+                }
+            }
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", creating_entries.size());
 
             for (size_t i = 0; i < count; i++)
@@ -728,6 +914,10 @@ private:
     typename Ts::bulk_remove_entry_fn                       remove_entries;
     // TODO: wait until available in SAI
     //typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
+
+    // Used when the SAI doesn't implement the bulk API
+    typename Ts::create_entry_fn                            serial_create_entry;
+    typename Ts::remove_entry_fn                            serial_remove_entry;
 };
 
 template <>
@@ -736,6 +926,18 @@ inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_
 {
     create_entries = api->create_next_hop_group_members;
     remove_entries = api->remove_next_hop_group_members;
+    serial_create_entry = api->create_next_hop_group_member;
+    serial_remove_entry = api->remove_next_hop_group_member;
     // TODO: wait until available in SAI
     //set_entries_attribute = ;
 }
+
+template <>
+inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_hop_api_t>::api_t *api, sai_object_id_t switch_id)
+    : switch_id(switch_id)
+{
+    create_entries = api->create_next_hops;
+    remove_entries = api->remove_next_hops;
+    serial_create_entry = api->create_next_hop;
+    serial_remove_entry = api->remove_next_hop;
+}
@@ -88,7 +88,7 @@ void CbfNhgHandler::doTask(Consumer& consumer)
                 /*
                  * If we reached the NHG limit, postpone the creation.
                  */
-                if (NhgBase::getSyncedCount() >= NhgOrch::getMaxNhgCount())
+                if (NhgOrch::isNhgExhausted())
                 {
                     SWSS_LOG_WARN("Reached next hop group limit. Postponing "
                                   "creation.");
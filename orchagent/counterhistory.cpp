@@ -0,0 +1,209 @@
+#include "counterhistory.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+// Marks a narrow cell whose delta is kept in the overflow map
+static const uint32_t COUNTER_HISTORY_OVERFLOW = numeric_limits<uint32_t>::max();
+
+CounterHistory::CounterHistory(const vector<bool> &wide, size_t capacity) :
+    m_capacity(max(capacity, static_cast<size_t>(1))),
+    m_columns(wide.size()),
+    m_timestamps(m_capacity, 0)
+{
+    for (size_t i = 0; i < wide.size(); i++)
+    {
+        m_columns[i].wide = wide[i];
+    }
+}
+
+size_t CounterHistory::addRow()
+{
+    for (auto &column : m_columns)
+    {
+        if (column.wide)
+        {
+            column.deltas.resize(column.deltas.size() + m_capacity, 0);
+        }
+        else
+        {
+            column.narrow.resize(column.narrow.size() + m_capacity, 0);
+        }
+        column.last.push_back(0);
+    }
+    m_samples.push_back(0);
+
+    return m_rows++;
+}
+
+void CounterHistory::removeRow(size_t row)
+{
+    if (row >= m_rows)
+    {
+        return;
+    }
+
+    size_t last = m_rows - 1;
+    for (auto &column : m_columns)
+    {
+        for (size_t slot = 0; slot < m_capacity; slot++)
+        {
+            size_t cell = row * m_capacity + slot;
+            size_t lastCell = last * m_capacity + slot;
+
+            column.overflow.erase(cell);
+            if (row != last)
+            {
+                setDelta(column, cell, getDelta(column, lastCell));
+            }
+            column.overflow.erase(lastCell);
+        }
+
+        if (column.wide)
+        {
+            column.deltas.resize(last * m_capacity);
+        }
+        else
+        {
+            column.narrow.resize(last * m_capacity);
+        }
+        column.last[row] = column.last[last];
+        column.last.pop_back();
+    }
+
+    m_samples[row] = m_samples[last];
+    m_samples.pop_back();
+    m_rows--;
+}
+
+void CounterHistory::push(uint64_t timestamp, const vector<vector<uint64_t>> &counters, const vector<bool> &valid)
+{
+    m_head = (m_head + 1) % m_capacity;
+    m_timestamps[m_head] = timestamp;
+
+    for (size_t stat = 0; stat < m_columns.size(); stat++)
+    {
+        auto &column = m_columns[stat];
+        for (size_t row = 0; row < m_rows; row++)
+        {
+            size_t cell = row * m_capacity + m_head;
+            uint64_t delta = 0;
+
+            if (valid[row])
+            {
+                // The first sample of a row has nothing to be relative to.
+                // Cleared counters wrap around, which rebuilds them exactly.
+                uint64_t value = counters[stat][row];
+                delta = m_samples[row] ? value - column.last[row] : 0;
+                column.last[row] = value;
+            }
+
+            column.overflow.erase(cell);
+            setDelta(column, cell, delta);
+        }
+    }
+
+    for (size_t row = 0; row < m_rows; row++)
+    {
+        if (m_samples[row] || valid[row])
+        {
+            m_samples[row] = min(m_samples[row] + 1, m_capacity);
+        }
+    }
+}
+
+size_t CounterHistory::get(size_t row, size_t stat, size_t count, vector<uint64_t> &values) const
+{
+    values.clear();
+    if (row >= m_rows || stat >= m_columns.size())
+    {
+        return 0;
+    }
+
+    const auto &column = m_columns[stat];
+    count = min(count, m_samples[row]);
+    values.resize(count);
+
+    uint64_t value = column.last[row];
+    for (size_t age = 0; age < count; age++)
+    {
+        values[count - age - 1] = value;
+        value -= getDelta(column, row * m_capacity + getSlot(age));
+    }
+
+    return count;
+}
+
+size_t CounterHistory::getTimestamps(size_t row, size_t count, vector<uint64_t> &timestamps) const
+{
+    timestamps.clear();
+    if (row >= m_rows)
+    {
+        return 0;
+    }
+
+    count = min(count, m_samples[row]);
+    timestamps.resize(count);
+    for (size_t age = 0; age < count; age++)
+    {
+        timestamps[count - age - 1] = m_timestamps[getSlot(age)];
+    }
+
+    return count;
+}
+
+size_t CounterHistory::memoryUsage() const
+{
+    size_t bytes = m_timestamps.size() * sizeof(uint64_t) + m_samples.size() * sizeof(size_t);
+
+    for (const auto &column : m_columns)
+    {
+        bytes += column.narrow.size() * sizeof(uint32_t);
+        bytes += column.deltas.size() * sizeof(uint64_t);
+        bytes += column.last.size() * sizeof(uint64_t);
+        bytes += column.overflow.size() * (sizeof(size_t) + sizeof(uint64_t));
+    }
+
+    return bytes;
+}
+
+uint64_t CounterHistory::getDelta(const Column &column, size_t cell) const
+{
+    if (column.wide)
+    {
+        return column.deltas[cell];
+    }
+
+    if (column.narrow[cell] == COUNTER_HISTORY_OVERFLOW)
+    {
+        auto it = column.overflow.find(cell);
+        return it != column.overflow.end() ? it->second : COUNTER_HISTORY_OVERFLOW;
+    }
+
+    return column.narrow[cell];
+}
+
+void CounterHistory::setDelta(Column &column, size_t cell, uint64_t delta)
+{
+    if (column.wide)
+    {
+        column.deltas[cell] = delta;
+    }
+    else if (delta >= COUNTER_HISTORY_OVERFLOW)
+    {
+        column.narrow[cell] = COUNTER_HISTORY_OVERFLOW;
+        column.overflow[cell] = delta;
+    }
+    else
+    {
+        column.narrow[cell] = static_cast<uint32_t>(delta);
+    }
+}
+
+// Slot of the sample taken age samples before the latest one
+size_t CounterHistory::getSlot(size_t age) const
+{
+    return (m_head + m_capacity - age % m_capacity) % m_capacity;
+}
@@ -0,0 +1,68 @@
+#ifndef COUNTERHISTORY_H
+#define COUNTERHISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Fixed size ring of the recent samples of a set of objects' stats.
+ *
+ * Samples are stored column-wise, one column per stat, with all the samples
+ * of a row next to each other. Each cell holds the delta to the previous
+ * sample of the row, the values are rebuilt backwards from the latest one.
+ * Narrow columns keep 32-bit deltas, which fit the packet counters; deltas
+ * which don't fit are kept aside in an overflow map. Wide columns, meant for
+ * the octet counters, keep 64-bit deltas.
+ */
+class CounterHistory
+{
+public:
+    CounterHistory(const std::vector<bool> &wide, size_t capacity);
+
+    size_t addRow();
+    // Moves the last row to the removed one, like the snapshot columns do
+    void removeRow(size_t row);
+
+    // Appends one sample of all the rows, counters is [stat][row]. Rows
+    // without a valid sample repeat their previous value.
+    void push(uint64_t timestamp, const std::vector<std::vector<uint64_t>> &counters, const std::vector<bool> &valid);
+
+    // Gets up to count of the latest samples of the row, oldest first
+    size_t get(size_t row, size_t stat, size_t count, std::vector<uint64_t> &values) const;
+    size_t getTimestamps(size_t row, size_t count, std::vector<uint64_t> &timestamps) const;
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    // Bytes used by the samples
+    size_t memoryUsage() const;
+
+private:
+    struct Column
+    {
+        bool wide = false;
+        std::vector<uint32_t> narrow;                       // [row * capacity + slot]
+        std::vector<uint64_t> deltas;                       // [row * capacity + slot]
+        std::unordered_map<size_t, uint64_t> overflow;      // cell -> delta
+        std::vector<uint64_t> last;                         // [row]
+    };
+
+    uint64_t getDelta(const Column &column, size_t cell) const;
+    void setDelta(Column &column, size_t cell, uint64_t delta);
+    size_t getSlot(size_t age) const;
+
+    size_t m_capacity;
+    size_t m_rows = 0;
+    // Slot of the latest sample
+    size_t m_head = 0;
+    std::vector<Column> m_columns;
+    std::vector<uint64_t> m_timestamps;                     // [slot]
+    // Number of samples held by each row, rows added later have fewer
+    std::vector<size_t> m_samples;                          // [row]
+};
+
+#endif
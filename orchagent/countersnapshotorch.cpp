@@ -0,0 +1,603 @@
+#include "countersnapshotorch.h"
+#include "notifier.h"
+#include "redisreply.h"
+#include "schema.h"
+#include "tokenize.h"
+#include "converter.h"
+#include <hiredis/hiredis.h>
+#include <inttypes.h>
+#include <algorithm>
+#include <chrono>
+
+#define COUNTER_SNAPSHOT_RATES_TABLE    "RATES"
+#define COUNTER_SNAPSHOT_INIT_DONE      "INIT_DONE"
+#define COUNTER_SNAPSHOT_DEFAULT_POLL_MSECS 1000
+#define COUNTER_SNAPSHOT_QUEUE_POLL_MSECS   10000
+#define COUNTER_HISTORY_TABLE               "COUNTER_HISTORY"
+#define COUNTER_HISTORY_REQUEST_CHANNEL     "COUNTER_HISTORY_REQUEST"
+
+CounterSnapshotOrch& CounterSnapshotOrch::getInstance(DBConnector *db)
+{
+    SWSS_LOG_ENTER();
+
+    static vector<string> tableNames = {};
+    static CounterSnapshotOrch *snapshotOrch = new CounterSnapshotOrch(db, tableNames);
+
+    return *snapshotOrch;
+}
+
+CounterSnapshotOrch::CounterSnapshotOrch(DBConnector *db, vector<string> &tableNames):
+    Orch(db, tableNames),
+    m_countersDb(new DBConnector("COUNTERS_DB", 0)),
+    m_pipeline(m_countersDb.get()),
+    m_ratesTable(&m_pipeline, COUNTER_SNAPSHOT_RATES_TABLE, true),
+    m_historyTable(&m_pipeline, COUNTER_HISTORY_TABLE, true)
+{
+    SWSS_LOG_ENTER();
+
+    m_portGroup.name = "PORT";
+    m_portGroup.alphaField = "PORT_ALPHA";
+    m_portGroup.statNames = {
+        "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+        "SAI_PORT_STAT_IF_IN_OCTETS",
+        "SAI_PORT_STAT_IF_OUT_OCTETS",
+    };
+    m_portGroup.wideStats = { false, false, false, false, true, true };
+    m_portGroup.rates = {{
+        { "RX_BPS", { 4 } },
+        { "RX_PPS", { 0, 1 } },
+        { "TX_BPS", { 5 } },
+        { "TX_PPS", { 2, 3 } },
+    }};
+
+    m_rifGroup.name = "RIF";
+    m_rifGroup.alphaField = "RIF_ALPHA";
+    m_rifGroup.statNames = {
+        "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS",
+        "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS",
+        "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS",
+        "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS",
+    };
+    m_rifGroup.wideStats = { true, false, true, false };
+    m_rifGroup.rates = {{
+        { "RX_BPS", { 0 } },
+        { "RX_PPS", { 1 } },
+        { "TX_BPS", { 2 } },
+        { "TX_PPS", { 3 } },
+    }};
+
+    // Queues only keep the history, their rates are not published
+    m_queueGroup.name = "QUEUE";
+    m_queueGroup.statNames = {
+        "SAI_QUEUE_STAT_PACKETS",
+        "SAI_QUEUE_STAT_BYTES",
+        "SAI_QUEUE_STAT_DROPPED_PACKETS",
+        "SAI_QUEUE_STAT_DROPPED_BYTES",
+    };
+    m_queueGroup.wideStats = { false, true, false, true };
+    m_queueGroup.hasRates = false;
+
+    m_portGroup.pollInterval = COUNTER_SNAPSHOT_DEFAULT_POLL_MSECS;
+    m_rifGroup.pollInterval = COUNTER_SNAPSHOT_DEFAULT_POLL_MSECS;
+    m_queueGroup.pollInterval = COUNTER_SNAPSHOT_QUEUE_POLL_MSECS;
+
+    for (auto group : { &m_portGroup, &m_rifGroup, &m_queueGroup })
+    {
+        group->counters.resize(group->statNames.size());
+        group->countersLast.resize(group->statNames.size());
+        group->values.resize(COUNTER_SNAPSHOT_RATES_COUNT);
+        group->valuesWritten.resize(COUNTER_SNAPSHOT_RATES_COUNT);
+        group->history.reset(new CounterHistory(group->wideStats, COUNTER_SNAPSHOT_HISTORY_SAMPLES));
+
+        auto interv = timespec { .tv_sec = group->pollInterval / 1000, .tv_nsec = 0 };
+        group->timer = new SelectableTimer(interv);
+        auto executor = new ExecutableTimer(group->timer, this, group->name + "_RATES_POLL");
+        Orch::addExecutor(executor);
+    }
+
+    m_historyRequests = new NotificationConsumer(m_countersDb.get(), COUNTER_HISTORY_REQUEST_CHANNEL);
+    auto notifier = new Notifier(m_historyRequests, this, COUNTER_HISTORY_REQUEST_CHANNEL);
+    Orch::addExecutor(notifier);
+}
+
+CounterSnapshotOrch::~CounterSnapshotOrch(void)
+{
+    SWSS_LOG_ENTER();
+}
+
+CounterSnapshotOrch::SnapshotGroup &CounterSnapshotOrch::getGroup(CounterSnapshotGroup group)
+{
+    switch (group)
+    {
+        case CounterSnapshotGroup::PORT:
+            return m_portGroup;
+        case CounterSnapshotGroup::RIF:
+            return m_rifGroup;
+        default:
+            return m_queueGroup;
+    }
+}
+
+void CounterSnapshotOrch::addObject(CounterSnapshotGroup groupType, const string &oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = getGroup(groupType);
+    if (group.index.find(oid) != group.index.end())
+    {
+        return;
+    }
+
+    group.index[oid] = group.oids.size();
+    group.oids.push_back(oid);
+    for (size_t i = 0; i < group.statNames.size(); i++)
+    {
+        group.counters[i].push_back(0);
+        group.countersLast[i].push_back(0);
+    }
+    for (size_t i = 0; i < COUNTER_SNAPSHOT_RATES_COUNT; i++)
+    {
+        group.values[i].push_back(0);
+        group.valuesWritten[i].push_back(-1);
+    }
+    group.state.push_back(RatesState::INIT);
+    group.pollsSinceSample.push_back(0);
+    group.history->addRow();
+}
+
+void CounterSnapshotOrch::removeObject(CounterSnapshotGroup groupType, const string &oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = getGroup(groupType);
+    auto found = group.index.find(oid);
+    if (found == group.index.end())
+    {
+        return;
+    }
+
+    // Keep the columns dense by moving the last row to the freed one
+    size_t row = found->second;
+    size_t last = group.oids.size() - 1;
+    group.index.erase(found);
+    if (row != last)
+    {
+        group.oids[row] = group.oids[last];
+        group.index[group.oids[row]] = row;
+        for (size_t i = 0; i < group.statNames.size(); i++)
+        {
+            group.counters[i][row] = group.counters[i][last];
+            group.countersLast[i][row] = group.countersLast[i][last];
+        }
+        for (size_t i = 0; i < COUNTER_SNAPSHOT_RATES_COUNT; i++)
+        {
+            group.values[i][row] = group.values[i][last];
+            group.valuesWritten[i][row] = group.valuesWritten[i][last];
+        }
+        group.state[row] = group.state[last];
+        group.pollsSinceSample[row] = group.pollsSinceSample[last];
+    }
+
+    group.oids.pop_back();
+    for (size_t i = 0; i < group.statNames.size(); i++)
+    {
+        group.counters[i].pop_back();
+        group.countersLast[i].pop_back();
+    }
+    for (size_t i = 0; i < COUNTER_SNAPSHOT_RATES_COUNT; i++)
+    {
+        group.values[i].pop_back();
+        group.valuesWritten[i].pop_back();
+    }
+    group.state.pop_back();
+    group.pollsSinceSample.pop_back();
+    group.history->removeRow(row);
+}
+
+void CounterSnapshotOrch::setPollInterval(CounterSnapshotGroup groupType, uint32_t pollInterval)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = getGroup(groupType);
+    if (pollInterval == 0 || pollInterval == group.pollInterval)
+    {
+        return;
+    }
+
+    group.pollInterval = pollInterval;
+    if (group.enabled)
+    {
+        startTimer(group);
+    }
+}
+
+void CounterSnapshotOrch::setEnabled(CounterSnapshotGroup groupType, bool enabled)
+{
+    SWSS_LOG_ENTER();
+
+    auto &group = getGroup(groupType);
+    if (group.enabled == enabled)
+    {
+        return;
+    }
+
+    group.enabled = enabled;
+    if (enabled)
+    {
+        // Counters were not polled meanwhile, start from scratch
+        for (auto &state : group.state)
+        {
+            state = RatesState::INIT;
+        }
+        startTimer(group);
+    }
+    else
+    {
+        group.timer->stop();
+    }
+
+    SWSS_LOG_NOTICE("%s rates %s", group.name.c_str(), enabled ? "enabled" : "disabled");
+}
+
+void CounterSnapshotOrch::startTimer(SnapshotGroup &group)
+{
+    auto interv = timespec { .tv_sec = group.pollInterval / 1000, .tv_nsec = (group.pollInterval % 1000) * 1000000 };
+    group.timer->setInterval(interv);
+    group.timer->reset();
+}
+
+void CounterSnapshotOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto group : { &m_portGroup, &m_rifGroup, &m_queueGroup })
+    {
+        if (group->timer == &timer)
+        {
+            updateRates(*group);
+        }
+    }
+}
+
+bool CounterSnapshotOrch::readSnapshot(SnapshotGroup &group, vector<bool> &valid, string &alpha)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = m_countersDb->getContext();
+    const string prefix = string(COUNTERS_TABLE) + ":";
+
+    // Pipeline the reads of all objects, so a poll costs one round trip
+    vector<const char *> argv(group.statNames.size() + 2);
+    argv[0] = "HMGET";
+    for (size_t i = 0; i < group.statNames.size(); i++)
+    {
+        argv[i + 2] = group.statNames[i].c_str();
+    }
+
+    for (const auto &oid : group.oids)
+    {
+        string key = prefix + oid;
+        argv[1] = key.c_str();
+        if (redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue %s counters read: %s", group.name.c_str(), ctx->errstr);
+            return false;
+        }
+    }
+
+    size_t replies = group.oids.size();
+    if (group.hasRates)
+    {
+        string alphaKey = string(COUNTER_SNAPSHOT_RATES_TABLE) + ":" + group.name;
+        if (redisAppendCommand(ctx, "HGET %s %s", alphaKey.c_str(), group.alphaField.c_str()) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue %s rates configuration read: %s", group.name.c_str(), ctx->errstr);
+            return false;
+        }
+        replies++;
+    }
+
+    valid.assign(group.oids.size(), false);
+    for (size_t row = 0; row < replies; row++)
+    {
+        redisReply *replyPtr = nullptr;
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&replyPtr)) != REDIS_OK)
+        {
+            // Pending replies can't be matched to the objects anymore
+            throw runtime_error(string("Failed to read counters: ") + ctx->errstr);
+        }
+
+        RedisReply reply(replyPtr);
+        const redisReply *r = reply.getContext();
+
+        if (row == group.oids.size())
+        {
+            alpha = r->type == REDIS_REPLY_STRING ? string(r->str) : "";
+            break;
+        }
+
+        if (r->type != REDIS_REPLY_ARRAY || r->elements != group.statNames.size())
+        {
+            continue;
+        }
+
+        bool complete = true;
+        for (size_t i = 0; i < group.statNames.size(); i++)
+        {
+            const redisReply *element = r->element[i];
+            if (element == nullptr || element->type != REDIS_REPLY_STRING)
+            {
+                complete = false;
+                break;
+            }
+            group.counters[i][row] = strtoull(element->str, nullptr, 10);
+        }
+        valid[row] = complete;
+    }
+
+    return true;
+}
+
+void CounterSnapshotOrch::updateRates(SnapshotGroup &group)
+{
+    SWSS_LOG_ENTER();
+
+    if (!group.enabled || group.oids.empty())
+    {
+        return;
+    }
+
+    vector<bool> valid;
+    string alphaStr;
+    if (!readSnapshot(group, valid, alphaStr))
+    {
+        return;
+    }
+
+    auto now = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch());
+    group.history->push(static_cast<uint64_t>(now.count()), group.counters, valid);
+
+    if (!group.hasRates)
+    {
+        return;
+    }
+
+    computeRates(group, valid, alphaStr);
+}
+
+/*
+ * Derives the rates of the objects from the snapshot just read. The first
+ * sample of an object only records its counters, the first rate is the raw
+ * one and the next ones are smoothed with the configured alpha.
+ */
+void CounterSnapshotOrch::computeRates(SnapshotGroup &group, const vector<bool> &valid, const string &alphaStr)
+{
+    SWSS_LOG_ENTER();
+
+    double alpha = 0;
+    try
+    {
+        alpha = stod(alphaStr);
+    }
+    catch (const exception &)
+    {
+        SWSS_LOG_INFO("%s rates alpha is not defined", group.name.c_str());
+        return;
+    }
+
+    const size_t statCount = group.statNames.size();
+
+    for (size_t row = 0; row < group.oids.size(); row++)
+    {
+        if (!valid[row])
+        {
+            continue;
+        }
+
+        group.pollsSinceSample[row]++;
+
+        if (group.state[row] == RatesState::INIT)
+        {
+            for (size_t i = 0; i < statCount; i++)
+            {
+                group.countersLast[i][row] = group.counters[i][row];
+            }
+            group.state[row] = RatesState::COUNTERS_LAST;
+            group.pollsSinceSample[row] = 0;
+            m_ratesTable.hset(group.oids[row] + ":" + group.name, COUNTER_SNAPSHOT_INIT_DONE, "COUNTERS_LAST");
+            continue;
+        }
+
+        // syncd polls the counters independently from us, so the same snapshot
+        // may be read twice. Wait one more poll before taking it as idle traffic.
+        bool changed = false;
+        for (size_t i = 0; i < statCount && !changed; i++)
+        {
+            changed = group.counters[i][row] != group.countersLast[i][row];
+        }
+        if (!changed && group.pollsSinceSample[row] < 2)
+        {
+            continue;
+        }
+
+        double seconds = group.pollsSinceSample[row] * group.pollInterval / 1000.0;
+        bool smooth = group.state[row] == RatesState::DONE;
+        bool dirty = false;
+
+        for (size_t r = 0; r < COUNTER_SNAPSHOT_RATES_COUNT; r++)
+        {
+            uint64_t delta = 0;
+            for (auto i : group.rates[r].stats)
+            {
+                // Counters may go back after they are cleared
+                if (group.counters[i][row] > group.countersLast[i][row])
+                {
+                    delta += group.counters[i][row] - group.countersLast[i][row];
+                }
+            }
+
+            double rate = static_cast<double>(delta) / seconds;
+            double &value = group.values[r][row];
+            value = smooth ? alpha * rate + (1.0 - alpha) * value : rate;
+            dirty = dirty || value != group.valuesWritten[r][row];
+        }
+
+        for (size_t i = 0; i < statCount; i++)
+        {
+            group.countersLast[i][row] = group.counters[i][row];
+        }
+        group.pollsSinceSample[row] = 0;
+
+        if (!smooth)
+        {
+            group.state[row] = RatesState::DONE;
+            m_ratesTable.hset(group.oids[row] + ":" + group.name, COUNTER_SNAPSHOT_INIT_DONE, "DONE");
+        }
+
+        // Idle objects keep the same rates, don't rewrite them
+        if (!dirty)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs;
+        for (size_t r = 0; r < COUNTER_SNAPSHOT_RATES_COUNT; r++)
+        {
+            fvs.emplace_back(group.rates[r].name, to_string(group.values[r][row]));
+            group.valuesWritten[r][row] = group.values[r][row];
+        }
+        m_ratesTable.set(group.oids[row], fvs);
+    }
+
+    m_pipeline.flush();
+}
+
+void CounterSnapshotOrch::doTask(NotificationConsumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    string op;
+    string data;
+    vector<FieldValueTuple> values;
+
+    consumer.pop(op, data, values);
+
+    if (&consumer != m_historyRequests)
+    {
+        return;
+    }
+
+    for (auto group : { &m_portGroup, &m_rifGroup, &m_queueGroup })
+    {
+        if (group->name == op)
+        {
+            dumpHistory(*group, data, values);
+            return;
+        }
+    }
+
+    SWSS_LOG_ERROR("Unknown counter history group %s", op.c_str());
+}
+
+/*
+ * Writes the latest samples of the object to COUNTER_HISTORY:<oid>, oldest
+ * first: TIMESTAMPS holds the sample times in ms since the epoch, each stat
+ * its values, and <stat>_PEAK_RATE the highest per second rate of the stat
+ * between two samples in the window.
+ */
+void CounterSnapshotOrch::dumpHistory(SnapshotGroup &group, const string &oid, const vector<FieldValueTuple> &values)
+{
+    SWSS_LOG_ENTER();
+
+    m_historyTable.del(oid);
+
+    auto found = group.index.find(oid);
+    if (found == group.index.end())
+    {
+        SWSS_LOG_WARN("No %s counter history for %s", group.name.c_str(), oid.c_str());
+        m_pipeline.flush();
+        return;
+    }
+    size_t row = found->second;
+
+    vector<size_t> stats;
+    size_t count = group.history->capacity();
+    for (const auto &fv : values)
+    {
+        if (fvField(fv) == "COUNT")
+        {
+            try
+            {
+                count = to_uint<uint32_t>(fvValue(fv));
+            }
+            catch (const exception &e)
+            {
+                SWSS_LOG_ERROR("Invalid counter history sample count %s: %s", fvValue(fv).c_str(), e.what());
+            }
+        }
+        else if (fvField(fv) == "STATS")
+        {
+            for (const auto &name : tokenize(fvValue(fv), ','))
+            {
+                auto stat = find(group.statNames.begin(), group.statNames.end(), name);
+                if (stat == group.statNames.end())
+                {
+                    SWSS_LOG_ERROR("Stat %s is not in the %s counter history", name.c_str(), group.name.c_str());
+                    continue;
+                }
+                stats.push_back(static_cast<size_t>(stat - group.statNames.begin()));
+            }
+        }
+    }
+
+    if (stats.empty())
+    {
+        for (size_t i = 0; i < group.statNames.size(); i++)
+        {
+            stats.push_back(i);
+        }
+    }
+
+    auto join = [](const vector<uint64_t> &samples) {
+        string joined;
+        for (const auto sample : samples)
+        {
+            joined += (joined.empty() ? "" : ",") + to_string(sample);
+        }
+        return joined;
+    };
+
+    vector<uint64_t> timestamps;
+    group.history->getTimestamps(row, count, timestamps);
+
+    vector<FieldValueTuple> fvs;
+    fvs.emplace_back("TIMESTAMPS", join(timestamps));
+
+    for (auto stat : stats)
+    {
+        vector<uint64_t> samples;
+        group.history->get(row, stat, count, samples);
+
+        double peak = 0;
+        for (size_t i = 1; i < samples.size(); i++)
+        {
+            // Cleared counters and repeated samples don't make a rate
+            if (samples[i] <= samples[i - 1] || timestamps[i] <= timestamps[i - 1])
+            {
+                continue;
+            }
+            double rate = static_cast<double>(samples[i] - samples[i - 1]) * 1000.0 /
+                          static_cast<double>(timestamps[i] - timestamps[i - 1]);
+            peak = max(peak, rate);
+        }
+
+        fvs.emplace_back(group.statNames[stat], join(samples));
+        fvs.emplace_back(group.statNames[stat] + "_PEAK_RATE", to_string(peak));
+    }
+
+    m_historyTable.set(oid, fvs);
+    m_pipeline.flush();
+}
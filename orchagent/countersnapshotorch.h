@@ -0,0 +1,113 @@
+#ifndef COUNTERSNAPSHOT_ORCH_H
+#define COUNTERSNAPSHOT_ORCH_H
+
+#include "orch.h"
+#include "timer.h"
+#include "redispipeline.h"
+#include "notificationconsumer.h"
+#include "counterhistory.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+#define COUNTER_SNAPSHOT_RATES_COUNT 4
+#define COUNTER_SNAPSHOT_HISTORY_SAMPLES 60
+
+enum class CounterSnapshotGroup
+{
+    PORT,
+    RIF,
+    QUEUE,
+};
+
+/*
+ * Keeps the latest polled stats of ports and router interfaces in a columnar
+ * in-memory snapshot and derives the smoothed rates in the RATES table from it.
+ * Replaces port_rates.lua and rif_rates.lua, which re-read the previous
+ * values of every object from COUNTERS_DB on every poll.
+ *
+ * The last COUNTER_SNAPSHOT_HISTORY_SAMPLES snapshots of ports, router
+ * interfaces and queues are also kept in a CounterHistory ring. The samples
+ * of an object are dumped to COUNTER_HISTORY:<oid> in COUNTERS_DB on request
+ * on the COUNTER_HISTORY_REQUEST channel, the op being the group name, the
+ * data the object id, and the optional fields STATS (comma separated stat
+ * names) and COUNT (number of samples).
+ */
+class CounterSnapshotOrch: public Orch
+{
+public:
+    static CounterSnapshotOrch& getInstance(swss::DBConnector *db = nullptr);
+    virtual void doTask(swss::SelectableTimer &timer);
+    virtual void doTask(Consumer &consumer) {}
+    virtual void doTask(swss::NotificationConsumer &consumer);
+
+    void addObject(CounterSnapshotGroup group, const std::string &oid);
+    void removeObject(CounterSnapshotGroup group, const std::string &oid);
+    void setPollInterval(CounterSnapshotGroup group, uint32_t pollInterval);
+    void setEnabled(CounterSnapshotGroup group, bool enabled);
+
+private:
+    enum class RatesState
+    {
+        INIT,
+        COUNTERS_LAST,
+        DONE,
+    };
+
+    struct RateDefinition
+    {
+        std::string name;
+        // Indexes of the stats which deltas make up the rate
+        std::vector<size_t> stats;
+    };
+
+    struct SnapshotGroup
+    {
+        std::string name;
+        std::string alphaField;
+        std::vector<std::string> statNames;
+        // Stats which deltas may not fit 32 bits in the history, the octets
+        std::vector<bool> wideStats;
+        std::array<RateDefinition, COUNTER_SNAPSHOT_RATES_COUNT> rates;
+        bool hasRates = true;
+
+        swss::SelectableTimer *timer = nullptr;
+        uint32_t pollInterval = 0;
+        bool enabled = false;
+
+        // Columns, one row per object, index maps the object id to the row
+        std::unordered_map<std::string, size_t> index;
+        std::vector<std::string> oids;
+        std::vector<std::vector<uint64_t>> counters;       // [stat][row]
+        std::vector<std::vector<uint64_t>> countersLast;   // [stat][row]
+        std::vector<std::vector<double>> values;           // [rate][row]
+        std::vector<std::vector<double>> valuesWritten;    // [rate][row]
+        std::vector<RatesState> state;
+        std::vector<uint32_t> pollsSinceSample;
+
+        // Same rows as the columns above
+        std::unique_ptr<CounterHistory> history;
+    };
+
+    CounterSnapshotOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
+    virtual ~CounterSnapshotOrch(void);
+
+    SnapshotGroup &getGroup(CounterSnapshotGroup group);
+    void startTimer(SnapshotGroup &group);
+    bool readSnapshot(SnapshotGroup &group, std::vector<bool> &valid, std::string &alpha);
+    void updateRates(SnapshotGroup &group);
+    void computeRates(SnapshotGroup &group, const std::vector<bool> &valid, const std::string &alphaStr);
+    void dumpHistory(SnapshotGroup &group, const std::string &oid, const std::vector<swss::FieldValueTuple> &values);
+
+    SnapshotGroup m_portGroup;
+    SnapshotGroup m_rifGroup;
+    SnapshotGroup m_queueGroup;
+
+    std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
+    swss::RedisPipeline m_pipeline;
+    swss::Table m_ratesTable;
+    swss::Table m_historyTable;
+    swss::NotificationConsumer *m_historyRequests = nullptr;
+};
+
+#endif
@@ -14,6 +14,7 @@
 #define CRM_THRESHOLD_HIGH_DEFAULT 85
 #define CRM_EXCEEDED_MSG_MAX 10
 #define CRM_ACL_RESOURCE_COUNT 256
+#define CRM_AVAILABLE_REFRESH_INTERVAL_MIN 1
 
 extern sai_object_id_t gSwitchId;
 extern sai_switch_api_t *sai_switch_api;
@@ -312,7 +313,14 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter++;
+
+        // Predict the availability until the next poll reconciles it
+        if (cnt.availableKnown && cnt.availableCounter > 0)
+        {
+            cnt.availableCounter--;
+        }
     }
     catch (...)
     {
@@ -327,7 +335,13 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter--;
+
+        if (cnt.availableKnown)
+        {
+            cnt.availableCounter++;
+        }
     }
     catch (...)
     {
@@ -421,6 +435,90 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
     }
 }
 
+bool CrmOrch::isCrmResAvailable(CrmResourceType resource, uint32_t count)
+{
+    SWSS_LOG_ENTER();
+
+    // Resources which are not supported or not polled yet don't restrict anything
+    auto res = m_resourcesMap.find(resource);
+    if (res == m_resourcesMap.end())
+    {
+        return true;
+    }
+
+    auto cnt = res->second.countersMap.find(CRM_COUNTERS_TABLE_KEY);
+    if (cnt == res->second.countersMap.end() || !cnt->second.availableKnown)
+    {
+        return true;
+    }
+
+    if (cnt->second.availableCounter >= count)
+    {
+        return true;
+    }
+
+    /*
+     * The prediction is pessimistic when removed objects don't free whole
+     * entries in the ASIC, so read the actual value before refusing. It is
+     * rate limited, as callers keep asking while the resource is exhausted.
+     */
+    auto now = chrono::steady_clock::now();
+    if (now - res->second.lastRefresh < chrono::seconds(CRM_AVAILABLE_REFRESH_INTERVAL_MIN))
+    {
+        return false;
+    }
+    res->second.lastRefresh = now;
+
+    if (getResAvailableCounter(resource, res->second) != SAI_STATUS_SUCCESS)
+    {
+        return true;
+    }
+
+    if (cnt->second.availableCounter < count)
+    {
+        SWSS_LOG_INFO("%s resource exhausted, %u available, %u requested",
+                      res->second.name.c_str(), cnt->second.availableCounter, count);
+        return false;
+    }
+
+    return true;
+}
+
+bool CrmOrch::isAnyCrmResAvailable(const set<CrmResourceType> &resources)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto resource : resources)
+    {
+        if (isCrmResAvailable(resource))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+sai_status_t CrmOrch::getResAvailableCounter(CrmResourceType resource, CrmResourceEntry &entry)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+    attr.id = crmResSaiAvailAttrMap.at(resource);
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    auto &cnt = entry.countersMap[CRM_COUNTERS_TABLE_KEY];
+    cnt.availableCounter = attr.value.u32;
+    cnt.availableKnown = true;
+
+    return status;
+}
+
 void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
@@ -454,7 +552,7 @@ void CrmOrch::getResAvailableCounters()
             case SAI_SWITCH_ATTR_AVAILABLE_SNAT_ENTRY:
             case SAI_SWITCH_ATTR_AVAILABLE_DNAT_ENTRY:
             {
-                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+                sai_status_t status = getResAvailableCounter(res.first, res.second);
                 if (status != SAI_STATUS_SUCCESS)
                 {
                     if((status == SAI_STATUS_NOT_SUPPORTED) ||
@@ -471,8 +569,6 @@ void CrmOrch::getResAvailableCounters()
                     break;
                 }
 
-                res.second.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = attr.value.u32;
-
                 break;
             }
 
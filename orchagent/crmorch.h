@@ -3,6 +3,7 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <set>
 #include "orch.h"
 #include "port.h"
 
@@ -51,6 +52,10 @@ public:
     void incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId);
     // Decrement "used" counter for the per ACL table CRM resources (ACL entry/counter)
     void decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId);
+    // Check if count more objects of the resource are predicted to fit in the ASIC
+    bool isCrmResAvailable(CrmResourceType resource, uint32_t count = 1);
+    // Check if any of the exhausted resources has some room again
+    bool isAnyCrmResAvailable(const std::set<CrmResourceType> &resources);
 
 private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
@@ -62,6 +67,8 @@ private:
         sai_object_id_t id = 0;
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
+        // Set once availableCounter has been read from the ASIC
+        bool availableKnown = false;
     };
 
     struct CrmResourceEntry
@@ -77,6 +84,9 @@ private:
         std::map<std::string, CrmResourceCounter> countersMap;
 
         uint32_t exceededLogCounter = 0;
+
+        // Last time the available counter was refreshed on demand
+        std::chrono::steady_clock::time_point lastRefresh;
     };
 
     std::chrono::seconds m_pollingInterval;
@@ -87,6 +97,7 @@ private:
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     void doTask(swss::SelectableTimer &timer);
     void getResAvailableCounters();
+    sai_status_t getResAvailableCounter(CrmResourceType resource, CrmResourceEntry &entry);
     void updateCrmCountersTable();
     void checkCrmThresholds();
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
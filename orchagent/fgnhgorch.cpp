@@ -27,7 +27,12 @@ FgNhgOrch::FgNhgOrch(DBConnector *db, DBConnector *appDb, DBConnector *stateDb,
         m_intfsOrch(intfsOrch),
         m_vrfOrch(vrfOrch),
         m_stateWarmRestartRouteTable(stateDb, STATE_FG_ROUTE_TABLE_NAME),
-        m_routeTable(appDb, APP_ROUTE_TABLE_NAME)
+        m_routeTable(appDb, APP_ROUTE_TABLE_NAME),
+#ifdef HAVE_SAI_BULK_NHGM_SET
+        m_bulkHashBucketSetSupported(true)
+#else
+        m_bulkHashBucketSetSupported(false)
+#endif
 {
     SWSS_LOG_ENTER();
     isFineGrainedConfigured = false;
@@ -196,34 +201,19 @@ void FgNhgOrch::calculateBankHashBucketStartIndices(FgNhgEntry *fgNhgEntry)
 }
 
 
-void FgNhgOrch::setStateDbRouteEntry(const IpPrefix &ipPrefix, uint32_t index, NextHopKey nextHop)
+void FgNhgOrch::setStateDbRouteEntry(const IpPrefix &ipPrefix, const std::vector<FieldValueTuple> &bucketNextHops)
 {
     SWSS_LOG_ENTER();
 
-    string key = ipPrefix.to_string();
-    // Write to StateDb
-    std::vector<FieldValueTuple> fvs;
-
-    // check if profile already exists - if yes - skip creation
-    m_stateWarmRestartRouteTable.get(key, fvs);
-
-    //bucket rewrite
-    if (fvs.size() > index)
-    {
-        FieldValueTuple fv(std::to_string(index), nextHop.to_string());
-        fvs[index] = fv;
-        SWSS_LOG_INFO("Set state db entry for ip prefix %s next hop %s with index %d",
-                        ipPrefix.to_string().c_str(), nextHop.to_string().c_str(), index);
-        m_stateWarmRestartRouteTable.set(key, fvs);
-    }
-    else
+    if (bucketNextHops.empty())
     {
-        fvs.push_back(FieldValueTuple(std::to_string(index), nextHop.to_string()));
-        SWSS_LOG_INFO("Add new next hop entry %s with index %d for ip prefix %s",
-                nextHop.to_string().c_str(), index, ipPrefix.to_string().c_str());
-        m_stateWarmRestartRouteTable.set(key, fvs);
+        return;
     }
 
+    // Fields are hash bucket indices, only the given buckets are rewritten
+    SWSS_LOG_INFO("Set %zu hash bucket entries in state db for ip prefix %s",
+                    bucketNextHops.size(), ipPrefix.to_string().c_str());
+    m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), bucketNextHops);
 }
 
 bool FgNhgOrch::writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, uint32_t index, sai_object_id_t nh_oid,
@@ -231,21 +221,134 @@ bool FgNhgOrch::writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry,
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t nhgm_attr;
-    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-    nhgm_attr.value.oid = nh_oid;
-    sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
-                                                              syncd_fg_route_entry->nhopgroup_members[index],
-                                                              &nhgm_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    SWSS_LOG_INFO("Queue hash bucket %d member %" PRIx64 " of ip prefix %s to next hop %s",
+            index, syncd_fg_route_entry->nhopgroup_members[index],
+            ipPrefix.to_string().c_str(), nextHop.to_string().c_str());
+
+    // Applied by flushHashBucketChanges, a bucket moved more than once ends up at its last next-hop
+    m_pendingHashBucketChanges[index] = std::make_pair(nh_oid, nextHop);
+    return true;
+}
+
+/* flushHashBucketChanges: Applies the queued hash bucket rewrites of a route.
+ * The rewrites are applied all or nothing: if one of them fails, the buckets already
+ * rewritten are set back to their previous next-hop from prevBucketNextHops, so that
+ * the caller can restore the route's software state and the change can be retried.
+ */
+bool FgNhgOrch::flushHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, const IpPrefix &ipPrefix,
+        const std::map<uint32_t, NextHopKey> &prevBucketNextHops)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pendingHashBucketChanges.empty())
     {
-        SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
-            syncd_fg_route_entry->nhopgroup_members[index], nh_oid, status);
-        return false;
+        return true;
     }
 
-    setStateDbRouteEntry(ipPrefix, index, nextHop);
-    return true;
+    vector<uint32_t> indices;
+    vector<sai_object_id_t> members;
+    vector<sai_attribute_t> attrs;
+    for (const auto &change : m_pendingHashBucketChanges)
+    {
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = change.second.first;
+
+        indices.push_back(change.first);
+        members.push_back(syncd_fg_route_entry->nhopgroup_members[change.first]);
+        attrs.push_back(nhgm_attr);
+    }
+
+    uint32_t count = (uint32_t)members.size();
+    vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+#ifdef HAVE_SAI_BULK_NHGM_SET
+    if (m_bulkHashBucketSetSupported)
+    {
+        sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+        if (sai_next_hop_group_api->set_next_hop_group_members_attribute != nullptr)
+        {
+            status = sai_next_hop_group_api->set_next_hop_group_members_attribute(count,
+                    members.data(), attrs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        }
+
+        if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            SWSS_LOG_NOTICE("Bulk set of next hop group members is not supported, rewriting hash buckets one by one");
+            m_bulkHashBucketSetSupported = false;
+            std::fill(statuses.begin(), statuses.end(), SAI_STATUS_NOT_EXECUTED);
+        }
+    }
+#endif
+
+    if (!m_bulkHashBucketSetSupported)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            statuses[i] = sai_next_hop_group_api->set_next_hop_group_member_attribute(members[i], &attrs[i]);
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                break;
+            }
+        }
+    }
+
+    bool success = true;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            if (statuses[i] != SAI_STATUS_NOT_EXECUTED)
+            {
+                SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
+                    attrs[i].value.oid, members[i], statuses[i]);
+            }
+            success = false;
+        }
+    }
+
+    vector<FieldValueTuple> bucketNextHops;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        if (success)
+        {
+            bucketNextHops.emplace_back(std::to_string(indices[i]),
+                    m_pendingHashBucketChanges[indices[i]].second.to_string());
+            continue;
+        }
+
+        /* Set the rewritten bucket back to its previous next-hop */
+        auto prev = prevBucketNextHops.find(indices[i]);
+        if (prev != prevBucketNextHops.end() && m_neighOrch->hasNextHop(prev->second))
+        {
+            sai_attribute_t nhgm_attr;
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+            nhgm_attr.value.oid = m_neighOrch->getNextHopId(prev->second);
+
+            if (sai_next_hop_group_api->set_next_hop_group_member_attribute(members[i], &nhgm_attr) ==
+                    SAI_STATUS_SUCCESS)
+            {
+                continue;
+            }
+        }
+
+        /* Keep state db in line with the next-hop the bucket is left at */
+        SWSS_LOG_ERROR("Failed to restore hash bucket %d of ip prefix %s, it stays at next hop %s",
+                indices[i], ipPrefix.to_string().c_str(),
+                m_pendingHashBucketChanges[indices[i]].second.to_string().c_str());
+        bucketNextHops.emplace_back(std::to_string(indices[i]),
+                m_pendingHashBucketChanges[indices[i]].second.to_string());
+    }
+
+    setStateDbRouteEntry(ipPrefix, bucketNextHops);
+    m_pendingHashBucketChanges.clear();
+
+    return success;
 }
 
 
@@ -855,7 +958,26 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
 {
     SWSS_LOG_ENTER();
 
-    for (uint32_t bank_idx = 0; bank_idx < bank_member_changes.size(); bank_idx++)
+    /* The bank changes below update the route's software state as they queue the
+     * hash bucket rewrites, it is restored if the rewrites can't all be applied */
+    BankFGNextHopGroupMap syncd_fgnhg_map = syncd_fg_route_entry->syncd_fgnhg_map;
+    ActiveNextHops active_nexthops = syncd_fg_route_entry->active_nexthops;
+    InactiveBankMapsToBank inactive_to_active_map = syncd_fg_route_entry->inactive_to_active_map;
+
+    std::map<uint32_t, NextHopKey> prevBucketNextHops;
+    for (const auto &bank_map : syncd_fgnhg_map)
+    {
+        for (const auto &nh_buckets : bank_map)
+        {
+            for (auto index : nh_buckets.second)
+            {
+                prevBucketNextHops.emplace(index, nh_buckets.first);
+            }
+        }
+    }
+
+    bool success = true;
+    for (uint32_t bank_idx = 0; success && bank_idx < bank_member_changes.size(); bank_idx++)
     {
         if (bank_member_changes[bank_idx].active_nhs.size() != 0 ||
                 (bank_member_changes[bank_idx].nhs_to_add.size() != 0 &&
@@ -866,23 +988,33 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
              * simultaneously, nhs were added(nhs_to_add > 0).
              * Route this to fn which deals with active banks
              */
-            if (!setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
-                        bank_idx, bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix))
-            {
-                return false;
-            }
+            success = setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
+                        bank_idx, bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix);
         }
         else
         {
-            if (!setInactiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
-                        bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix))
-            {
-                return false;
-            }
+            success = setInactiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
+                        bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix);
         }
     }
 
-    return true;
+    if (success)
+    {
+        success = flushHashBucketChanges(syncd_fg_route_entry, ipPrefix, prevBucketNextHops);
+    }
+    else
+    {
+        m_pendingHashBucketChanges.clear();
+    }
+
+    if (!success)
+    {
+        syncd_fg_route_entry->syncd_fgnhg_map = syncd_fgnhg_map;
+        syncd_fg_route_entry->active_nexthops = active_nexthops;
+        syncd_fg_route_entry->inactive_to_active_map = inactive_to_active_map;
+    }
+
+    return success;
 }
 
 
@@ -894,6 +1026,7 @@ bool FgNhgOrch::setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNh
 
     sai_status_t status;
     bool isWarmReboot = false;
+    vector<FieldValueTuple> bucketNextHops;
     auto nexthopsMap = m_recoveryMap.find(ipPrefix.to_string());
     for (uint32_t i = 0; i < fgNhgEntry->hash_bucket_indices.size(); i++)
     {
@@ -989,7 +1122,7 @@ bool FgNhgOrch::setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNh
                 return false;
             }
 
-            setStateDbRouteEntry(ipPrefix, j, bank_nh_memb);
+            bucketNextHops.emplace_back(std::to_string(j), bank_nh_memb.to_string());
             syncd_fg_route_entry.syncd_fgnhg_map[i][bank_nh_memb].push_back(j);
             syncd_fg_route_entry.active_nexthops.insert(bank_nh_memb);
             syncd_fg_route_entry.nhopgroup_members.push_back(next_hop_group_member_id);
@@ -997,6 +1130,8 @@ bool FgNhgOrch::setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNh
         }
     }
 
+    setStateDbRouteEntry(ipPrefix, bucketNextHops);
+
     if (isWarmReboot)
     {
         m_recoveryMap.erase(nexthopsMap);
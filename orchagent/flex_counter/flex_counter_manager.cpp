@@ -17,6 +17,7 @@ using std::vector;
 using swss::DBConnector;
 using swss::FieldValueTuple;
 using swss::ProducerTable;
+using swss::RedisPipeline;
 
 const string FLEX_COUNTER_ENABLE("enable");
 const string FLEX_COUNTER_DISABLE("disable");
@@ -177,6 +178,47 @@ void FlexCounterManager::setCounterIdList(
             group_name.c_str());
 }
 
+// setCounterIdList configures flex counters to poll the same set of stats on
+// all of the given objects. The entries are written in a single pipelined
+// transaction instead of one round trip per object.
+void FlexCounterManager::setCounterIdList(
+        const vector<sai_object_id_t>& object_ids,
+        const CounterType counter_type,
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    auto counter_type_it = counter_id_field_lookup.find(counter_type);
+    if (counter_type_it == counter_id_field_lookup.end())
+    {
+        SWSS_LOG_ERROR("Could not update flex counter id list for group '%s': counter type not found.",
+                group_name.c_str());
+        return;
+    }
+
+    if (object_ids.empty())
+    {
+        return;
+    }
+
+    initPipeline();
+
+    std::vector<swss::FieldValueTuple> field_values =
+    {
+        FieldValueTuple(counter_type_it->second, serializeCounterStats(counter_stats))
+    };
+    for (const auto& object_id: object_ids)
+    {
+        flex_counter_buffered_table->set(getFlexCounterTableKey(group_name, object_id), field_values);
+        installed_counters.insert(object_id);
+    }
+    flex_counter_buffered_table->flush();
+
+    SWSS_LOG_DEBUG("Updated flex counter id list for %zu objects in group '%s'.",
+            object_ids.size(),
+            group_name.c_str());
+}
+
 // clearCounterIdList clears all stats that are currently being polled from
 // the given object.
 void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
@@ -200,6 +242,53 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
             group_name.c_str());
 }
 
+// clearCounterIdList clears all stats that are currently being polled from
+// the given objects, in a single pipelined transaction.
+void FlexCounterManager::clearCounterIdList(const vector<sai_object_id_t>& object_ids)
+{
+    SWSS_LOG_ENTER();
+
+    if (object_ids.empty())
+    {
+        return;
+    }
+
+    initPipeline();
+
+    for (const auto& object_id: object_ids)
+    {
+        auto counter_it = installed_counters.find(object_id);
+        if (counter_it == installed_counters.end())
+        {
+            SWSS_LOG_WARN("No counters found on object '%" PRIu64 "' in group '%s'.",
+                    object_id,
+                    group_name.c_str());
+            continue;
+        }
+
+        flex_counter_buffered_table->del(getFlexCounterTableKey(group_name, object_id));
+        installed_counters.erase(counter_it);
+    }
+    flex_counter_buffered_table->flush();
+
+    SWSS_LOG_DEBUG("Cleared flex counter id list for %zu objects in group '%s'.",
+            object_ids.size(),
+            group_name.c_str());
+}
+
+// initPipeline creates the pipeline used by the bulk updates. The pipeline
+// holds its own connection, only managers doing bulk updates pay for it.
+void FlexCounterManager::initPipeline()
+{
+    if (flex_counter_pipeline)
+    {
+        return;
+    }
+
+    flex_counter_pipeline = std::make_shared<RedisPipeline>(flex_counter_db.get());
+    flex_counter_buffered_table = std::make_shared<ProducerTable>(flex_counter_pipeline.get(), FLEX_COUNTER_TABLE, true);
+}
+
 string FlexCounterManager::getFlexCounterTableKey(
         const string& group_name,
         const sai_object_id_t object_id) const
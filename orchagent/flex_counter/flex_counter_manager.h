@@ -4,8 +4,10 @@
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 #include "dbconnector.h"
 #include "producertable.h"
+#include "redispipeline.h"
 #include <inttypes.h>
 
 extern "C" {
@@ -52,12 +54,22 @@ class FlexCounterManager
                 const sai_object_id_t object_id,
                 const CounterType counter_type,
                 const std::unordered_set<std::string>& counter_stats);
+        void setCounterIdList(
+                const std::vector<sai_object_id_t>& object_ids,
+                const CounterType counter_type,
+                const std::unordered_set<std::string>& counter_stats);
         void clearCounterIdList(const sai_object_id_t object_id);
+        void clearCounterIdList(const std::vector<sai_object_id_t>& object_ids);
+
+        const std::string& getGroupName() const { return group_name; }
+        uint getPollingInterval() const { return polling_interval; }
+        bool isEnabled() const { return enabled; }
 
     protected:
         void applyGroupConfiguration();
 
     private:
+        void initPipeline();
         std::string getFlexCounterTableKey(
                 const std::string& group_name,
                 const sai_object_id_t object_id) const;
@@ -73,6 +85,8 @@ class FlexCounterManager
         std::shared_ptr<swss::DBConnector> flex_counter_db = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_group_table = nullptr;
         std::shared_ptr<swss::ProducerTable> flex_counter_table = nullptr;
+        std::shared_ptr<swss::RedisPipeline> flex_counter_pipeline = nullptr;
+        std::shared_ptr<swss::ProducerTable> flex_counter_buffered_table = nullptr;
 
         static const std::unordered_map<StatsMode, std::string> stats_mode_lookup;
         static const std::unordered_map<bool, std::string> status_lookup;
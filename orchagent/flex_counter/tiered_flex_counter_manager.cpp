@@ -0,0 +1,438 @@
+#include "tiered_flex_counter_manager.h"
+
+#include <hiredis/hiredis.h>
+
+#include "schema.h"
+#include "redisreply.h"
+#include "logger.h"
+#include "sai_serialize.h"
+
+using std::map;
+using std::string;
+using std::unordered_set;
+using std::vector;
+using std::chrono::steady_clock;
+using swss::DBConnector;
+using swss::FieldValueTuple;
+using swss::RedisReply;
+using swss::Table;
+
+// Polling interval of the WARM and COLD sub-groups, as a multiple of the
+// polling interval of the group
+const uint TIER_WARM_INTERVAL_FACTOR = 6;
+const uint TIER_COLD_INTERVAL_FACTOR = 30;
+
+// Sum of the counter deltas per second above which an object is busy
+const double TIER_HOT_DELTA_PER_SEC = 100000.0;
+
+// Consecutive samples without any change before an object is moved to COLD
+const uint32_t TIER_COLD_IDLE_SAMPLES = 3;
+
+TieredFlexCounterManager::TieredFlexCounterManager(
+        const string& group_name,
+        const StatsMode stats_mode,
+        const uint polling_interval,
+        const bool enabled) :
+    FlexCounterManager(group_name, stats_mode, polling_interval, enabled),
+    warm_manager(group_name + "_WARM", stats_mode, polling_interval * TIER_WARM_INTERVAL_FACTOR, enabled),
+    cold_manager(group_name + "_COLD", stats_mode, polling_interval * TIER_COLD_INTERVAL_FACTOR, enabled),
+    counters_db(new DBConnector("COUNTERS_DB", 0)),
+    state_db(new DBConnector("STATE_DB", 0)),
+    tier_table(new Table(state_db.get(), FLEX_COUNTER_TIER_TABLE))
+{
+    SWSS_LOG_ENTER();
+
+    publishTierStats();
+}
+
+TieredFlexCounterManager::~TieredFlexCounterManager()
+{
+    SWSS_LOG_ENTER();
+
+    tier_table->del(getGroupName());
+}
+
+// updateGroupPollingInterval sets the polling interval of the HOT tier, the
+// other tiers follow at their fixed ratio.
+void TieredFlexCounterManager::updateGroupPollingInterval(
+        const uint polling_interval)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounterManager::updateGroupPollingInterval(polling_interval);
+    warm_manager.updateGroupPollingInterval(polling_interval * TIER_WARM_INTERVAL_FACTOR);
+    cold_manager.updateGroupPollingInterval(polling_interval * TIER_COLD_INTERVAL_FACTOR);
+
+    publishTierStats();
+}
+
+void TieredFlexCounterManager::enableFlexCounterGroup()
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounterManager::enableFlexCounterGroup();
+    warm_manager.enableFlexCounterGroup();
+    cold_manager.enableFlexCounterGroup();
+
+    publishTierStats();
+}
+
+void TieredFlexCounterManager::disableFlexCounterGroup()
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounterManager::disableFlexCounterGroup();
+    warm_manager.disableFlexCounterGroup();
+    cold_manager.disableFlexCounterGroup();
+
+    publishTierStats();
+}
+
+// setCounterIdList starts polling the given object in the HOT tier, or updates
+// the stats polled in its current tier.
+void TieredFlexCounterManager::setCounterIdList(
+        const sai_object_id_t object_id,
+        const CounterType counter_type,
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    setCounterIdList(vector<sai_object_id_t>{ object_id }, counter_type, counter_stats);
+}
+
+void TieredFlexCounterManager::setCounterIdList(
+        const vector<sai_object_id_t>& object_ids,
+        const CounterType counter_type,
+        const unordered_set<string>& counter_stats)
+{
+    SWSS_LOG_ENTER();
+
+    // The objects configured together share the same set of stats
+    Stats stats = std::make_shared<const unordered_set<string>>(counter_stats);
+    map<CounterTier, vector<sai_object_id_t>> tier_objects;
+
+    for (const auto& object_id: object_ids)
+    {
+        auto& object = objects[object_id];
+        object.counter_type = counter_type;
+        object.stats = stats;
+        object.sampled = false;
+        tier_objects[object.tier].push_back(object_id);
+    }
+
+    for (const auto& it: tier_objects)
+    {
+        getTierManager(it.first).setCounterIdList(it.second, counter_type, counter_stats);
+    }
+}
+
+void TieredFlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto object_it = objects.find(object_id);
+    if (object_it == objects.end())
+    {
+        SWSS_LOG_WARN("No counters found on object '%" PRIu64 "' in group '%s'.",
+                object_id,
+                getGroupName().c_str());
+        return;
+    }
+
+    getTierManager(object_it->second.tier).clearCounterIdList(object_id);
+    objects.erase(object_it);
+}
+
+// evaluateTiers samples the counters of the objects which have been polled
+// since their last sample, and moves the objects whose tier changed.
+void TieredFlexCounterManager::evaluateTiers()
+{
+    SWSS_LOG_ENTER();
+
+    if (objects.empty() || !isEnabled())
+    {
+        publishTierStats();
+        return;
+    }
+
+    auto now = steady_clock::now();
+
+    // A sample taken before the next poll of the object would show no change
+    vector<sai_object_id_t> due;
+    for (const auto& it: objects)
+    {
+        auto interval = std::chrono::milliseconds(getTierPollingInterval(it.second.tier));
+        if (!it.second.sampled || now - it.second.last_sample >= interval)
+        {
+            due.push_back(it.first);
+        }
+    }
+
+    vector<uint64_t> sums;
+    vector<bool> valid;
+    if (!due.empty() && readCounterSums(due, sums, valid))
+    {
+        applyCounterSums(due, sums, valid, now);
+    }
+
+    publishTierStats();
+}
+
+// applyCounterSums records the counter sums sampled at the given time, and
+// moves the objects whose tier changed.
+void TieredFlexCounterManager::applyCounterSums(
+        const vector<sai_object_id_t>& object_ids,
+        const vector<uint64_t>& sums,
+        const vector<bool>& valid,
+        const steady_clock::time_point now)
+{
+    SWSS_LOG_ENTER();
+
+    map<CounterTier, vector<sai_object_id_t>> moves;
+    for (size_t i = 0; i < object_ids.size(); i++)
+    {
+        if (!valid[i])
+        {
+            continue;
+        }
+
+        auto& object = objects[object_ids[i]];
+        if (!object.sampled)
+        {
+            object.last_sum = sums[i];
+            object.last_sample = now;
+            object.sampled = true;
+            continue;
+        }
+
+        double elapsed = std::chrono::duration<double>(now - object.last_sample).count();
+        CounterTier tier = getNextTier(object, sums[i], elapsed);
+        object.last_sum = sums[i];
+        object.last_sample = now;
+
+        if (tier != object.tier)
+        {
+            moves[tier].push_back(object_ids[i]);
+        }
+    }
+
+    moveObjects(moves);
+}
+
+size_t TieredFlexCounterManager::getTierObjectCount(const CounterTier tier) const
+{
+    size_t count = 0;
+    for (const auto& it: objects)
+    {
+        if (it.second.tier == tier)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// getPollsPerSecond returns the number of objects polled per second over all
+// the tiers.
+double TieredFlexCounterManager::getPollsPerSecond() const
+{
+    if (!isEnabled())
+    {
+        return 0;
+    }
+
+    double polls = 0;
+    for (const auto tier: { CounterTier::HOT, CounterTier::WARM, CounterTier::COLD })
+    {
+        uint interval = getTierPollingInterval(tier);
+        if (interval)
+        {
+            polls += static_cast<double>(getTierObjectCount(tier)) * 1000.0 / interval;
+        }
+    }
+
+    return polls;
+}
+
+FlexCounterManager& TieredFlexCounterManager::getTierManager(const CounterTier tier)
+{
+    switch (tier)
+    {
+        case CounterTier::WARM:
+            return warm_manager;
+        case CounterTier::COLD:
+            return cold_manager;
+        default:
+            return *this;
+    }
+}
+
+uint TieredFlexCounterManager::getTierPollingInterval(const CounterTier tier) const
+{
+    switch (tier)
+    {
+        case CounterTier::WARM:
+            return warm_manager.getPollingInterval();
+        case CounterTier::COLD:
+            return cold_manager.getPollingInterval();
+        default:
+            return getPollingInterval();
+    }
+}
+
+// readCounterSums reads the polled stats of the objects from COUNTERS_DB in a
+// single pipeline and sums them up per object.
+bool TieredFlexCounterManager::readCounterSums(
+        const vector<sai_object_id_t>& object_ids,
+        vector<uint64_t>& sums,
+        vector<bool>& valid)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = counters_db->getContext();
+    const string prefix = string(COUNTERS_TABLE) + ":";
+
+    for (const auto& object_id: object_ids)
+    {
+        const auto& stats = *objects[object_id].stats;
+        string key = prefix + sai_serialize_object_id(object_id);
+
+        vector<const char *> argv;
+        argv.reserve(stats.size() + 2);
+        argv.push_back("HMGET");
+        argv.push_back(key.c_str());
+        for (const auto& stat: stats)
+        {
+            argv.push_back(stat.c_str());
+        }
+
+        if (redisAppendCommandArgv(ctx, static_cast<int>(argv.size()), argv.data(), nullptr) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue counters read of group '%s': %s", getGroupName().c_str(), ctx->errstr);
+            return false;
+        }
+    }
+
+    sums.assign(object_ids.size(), 0);
+    valid.assign(object_ids.size(), false);
+    for (size_t i = 0; i < object_ids.size(); i++)
+    {
+        redisReply *replyPtr = nullptr;
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&replyPtr)) != REDIS_OK)
+        {
+            // The context is unusable after a read error, skip this re-tiering interval
+            SWSS_LOG_ERROR("Failed to read counters of group '%s': %s", getGroupName().c_str(), ctx->errstr);
+            return false;
+        }
+
+        RedisReply reply(replyPtr);
+        const redisReply *r = reply.getContext();
+        if (r->type != REDIS_REPLY_ARRAY)
+        {
+            continue;
+        }
+
+        // Objects which have not been polled yet have no counters
+        bool found = false;
+        for (size_t j = 0; j < r->elements; j++)
+        {
+            const redisReply *element = r->element[j];
+            if (element != nullptr && element->type == REDIS_REPLY_STRING)
+            {
+                sums[i] += strtoull(element->str, nullptr, 10);
+                found = true;
+            }
+        }
+        valid[i] = found;
+    }
+
+    return true;
+}
+
+// getNextTier picks the tier of the object from the change of its counters
+// since the last sample. Objects are promoted on the first busy sample, and
+// only go COLD after several samples without any change.
+CounterTier TieredFlexCounterManager::getNextTier(
+        TieredObject& object,
+        const uint64_t sum,
+        const double elapsed) const
+{
+    // Counters going backwards have been cleared, count them from zero
+    uint64_t delta = sum >= object.last_sum ? sum - object.last_sum : sum;
+
+    if (delta == 0)
+    {
+        object.idle_samples++;
+        if (object.idle_samples >= TIER_COLD_IDLE_SAMPLES)
+        {
+            return CounterTier::COLD;
+        }
+
+        return object.tier == CounterTier::HOT ? CounterTier::WARM : object.tier;
+    }
+
+    object.idle_samples = 0;
+    if (elapsed > 0 && static_cast<double>(delta) / elapsed >= TIER_HOT_DELTA_PER_SEC)
+    {
+        return CounterTier::HOT;
+    }
+
+    return CounterTier::WARM;
+}
+
+// moveObjects moves the objects from their current tier to the new one, with
+// one bulk update per source and destination tier.
+void TieredFlexCounterManager::moveObjects(const map<CounterTier, vector<sai_object_id_t>>& moves)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& move: moves)
+    {
+        const CounterTier to = move.first;
+        map<CounterTier, vector<sai_object_id_t>> from;
+
+        // The stats are shared by the objects configured together, which
+        // allows installing them in bulk
+        map<std::pair<CounterType, Stats>, vector<sai_object_id_t>> to_install;
+
+        for (const auto& object_id: move.second)
+        {
+            auto& object = objects[object_id];
+            from[object.tier].push_back(object_id);
+            to_install[{ object.counter_type, object.stats }].push_back(object_id);
+            object.tier = to;
+        }
+
+        for (const auto& it: from)
+        {
+            getTierManager(it.first).clearCounterIdList(it.second);
+        }
+
+        for (const auto& it: to_install)
+        {
+            getTierManager(to).setCounterIdList(it.second, it.first.first, *it.first.second);
+        }
+
+        SWSS_LOG_INFO("Moved %zu objects of group '%s' to tier %d",
+                move.second.size(), getGroupName().c_str(), static_cast<int>(to));
+    }
+}
+
+void TieredFlexCounterManager::publishTierStats()
+{
+    SWSS_LOG_ENTER();
+
+    vector<FieldValueTuple> field_values =
+    {
+        FieldValueTuple("hot_objects", std::to_string(getTierObjectCount(CounterTier::HOT))),
+        FieldValueTuple("warm_objects", std::to_string(getTierObjectCount(CounterTier::WARM))),
+        FieldValueTuple("cold_objects", std::to_string(getTierObjectCount(CounterTier::COLD))),
+        FieldValueTuple("hot_interval", std::to_string(getTierPollingInterval(CounterTier::HOT))),
+        FieldValueTuple("warm_interval", std::to_string(getTierPollingInterval(CounterTier::WARM))),
+        FieldValueTuple("cold_interval", std::to_string(getTierPollingInterval(CounterTier::COLD))),
+        FieldValueTuple("polls_per_second", std::to_string(getPollsPerSecond()))
+    };
+
+    tier_table->set(getGroupName(), field_values);
+}
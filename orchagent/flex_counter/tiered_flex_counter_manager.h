@@ -0,0 +1,108 @@
+#ifndef ORCHAGENT_TIERED_FLEX_COUNTER_MANAGER_H
+#define ORCHAGENT_TIERED_FLEX_COUNTER_MANAGER_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flex_counter_manager.h"
+#include "dbconnector.h"
+#include "table.h"
+
+// STATE_DB table holding the tier statistics of each tiered group
+#define FLEX_COUNTER_TIER_TABLE "FLEX_COUNTER_TIER_TABLE"
+
+enum class CounterTier
+{
+    HOT,
+    WARM,
+    COLD
+};
+
+// TieredFlexCounterManager allows users to manage a group of flex counters
+// where the objects are polled at a rate that follows their activity.
+//
+// Objects start in the HOT tier, which is the group itself. The counters are
+// periodically read back from COUNTERS_DB, objects that see little or no
+// change are moved to the WARM and COLD sub-groups, which are polled at a
+// fraction of the rate of the group. They are moved back as soon as their
+// counters pick up again.
+class TieredFlexCounterManager : public FlexCounterManager
+{
+    public:
+        TieredFlexCounterManager(
+                const std::string& group_name,
+                const StatsMode stats_mode,
+                const uint polling_interval,
+                const bool enabled);
+
+        TieredFlexCounterManager(const TieredFlexCounterManager&) = delete;
+        TieredFlexCounterManager& operator=(const TieredFlexCounterManager&) = delete;
+        ~TieredFlexCounterManager();
+
+        void updateGroupPollingInterval(const uint polling_interval);
+        void enableFlexCounterGroup();
+        void disableFlexCounterGroup();
+
+        void setCounterIdList(
+                const sai_object_id_t object_id,
+                const CounterType counter_type,
+                const std::unordered_set<std::string>& counter_stats);
+        void setCounterIdList(
+                const std::vector<sai_object_id_t>& object_ids,
+                const CounterType counter_type,
+                const std::unordered_set<std::string>& counter_stats);
+        void clearCounterIdList(const sai_object_id_t object_id);
+
+        // Re-assign the objects to the tiers according to their counter
+        // deltas, and publish the tier statistics
+        void evaluateTiers();
+
+        size_t getTierObjectCount(const CounterTier tier) const;
+        double getPollsPerSecond() const;
+
+    private:
+        using Stats = std::shared_ptr<const std::unordered_set<std::string>>;
+
+        struct TieredObject
+        {
+            CounterTier tier = CounterTier::HOT;
+            CounterType counter_type;
+            Stats stats;
+            uint64_t last_sum = 0;
+            bool sampled = false;
+            std::chrono::steady_clock::time_point last_sample;
+            uint32_t idle_samples = 0;
+        };
+
+        FlexCounterManager& getTierManager(const CounterTier tier);
+        uint getTierPollingInterval(const CounterTier tier) const;
+        bool readCounterSums(
+                const std::vector<sai_object_id_t>& object_ids,
+                std::vector<uint64_t>& sums,
+                std::vector<bool>& valid);
+        void applyCounterSums(
+                const std::vector<sai_object_id_t>& object_ids,
+                const std::vector<uint64_t>& sums,
+                const std::vector<bool>& valid,
+                const std::chrono::steady_clock::time_point now);
+        CounterTier getNextTier(TieredObject& object, const uint64_t sum, const double elapsed) const;
+        void moveObjects(const std::map<CounterTier, std::vector<sai_object_id_t>>& moves);
+        void publishTierStats();
+
+        // The HOT tier is the group managed by the base class
+        FlexCounterManager warm_manager;
+        FlexCounterManager cold_manager;
+
+        std::unordered_map<sai_object_id_t, TieredObject> objects;
+
+        std::shared_ptr<swss::DBConnector> counters_db = nullptr;
+        std::shared_ptr<swss::DBConnector> state_db = nullptr;
+        std::unique_ptr<swss::Table> tier_table = nullptr;
+};
+
+#endif // ORCHAGENT_TIERED_FLEX_COUNTER_MANAGER_H
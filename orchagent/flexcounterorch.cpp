@@ -8,6 +8,8 @@
 #include "bufferorch.h"
 #include "flexcounterorch.h"
 #include "debugcounterorch.h"
+#include "countersnapshotorch.h"
+#include "converter.h"
 
 extern sai_port_api_t *sai_port_api;
 
@@ -16,13 +18,22 @@ extern IntfsOrch *gIntfsOrch;
 extern BufferOrch *gBufferOrch;
 
 #define BUFFER_POOL_WATERMARK_KEY   "BUFFER_POOL_WATERMARK"
+#define QUEUE_KEY                   "QUEUE"
+
+// Groups which stats are snapshotted by CounterSnapshotOrch, for rates and history
+unordered_map<string, CounterSnapshotGroup> counterSnapshotGroupMap =
+{
+    {"PORT", CounterSnapshotGroup::PORT},
+    {"RIF", CounterSnapshotGroup::RIF},
+    {QUEUE_KEY, CounterSnapshotGroup::QUEUE},
+};
 
 unordered_map<string, string> flexCounterGroupMap =
 {
     {"PORT", PORT_STAT_COUNTER_FLEX_COUNTER_GROUP},
     {"PORT_RATES", PORT_RATE_COUNTER_FLEX_COUNTER_GROUP},
     {"PORT_BUFFER_DROP", PORT_STAT_COUNTER_FLEX_COUNTER_GROUP},
-    {"QUEUE", QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP},
+    {QUEUE_KEY, QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP},
     {"PFCWD", PFC_WD_FLEX_COUNTER_GROUP},
     {"QUEUE_WATERMARK", QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP},
     {"PG_WATERMARK", PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP},
@@ -83,6 +94,32 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     vector<FieldValueTuple> fieldValues;
                     fieldValues.emplace_back(POLL_INTERVAL_FIELD, value);
                     m_flexCounterGroupTable->set(flexCounterGroupMap[key], fieldValues);
+
+                    auto snapshotGroup = counterSnapshotGroupMap.find(key);
+                    if (snapshotGroup != counterSnapshotGroupMap.end())
+                    {
+                        try
+                        {
+                            CounterSnapshotOrch::getInstance().setPollInterval(snapshotGroup->second, to_uint<uint32_t>(value));
+                        }
+                        catch (const exception &e)
+                        {
+                            SWSS_LOG_ERROR("Invalid poll interval %s for %s: %s", value.c_str(), key.c_str(), e.what());
+                        }
+                    }
+
+                    // The queue counters are polled in tiers, which intervals follow the group one
+                    if (key == QUEUE_KEY)
+                    {
+                        try
+                        {
+                            gPortsOrch->updateQueueCounterPollInterval(to_uint<uint32_t>(value));
+                        }
+                        catch (const exception &e)
+                        {
+                            SWSS_LOG_ERROR("Invalid poll interval %s for %s: %s", value.c_str(), key.c_str(), e.what());
+                        }
+                    }
                 }
                 else if(field == FLEX_COUNTER_STATUS_FIELD)
                 {
@@ -112,6 +149,17 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     vector<FieldValueTuple> fieldValues;
                     fieldValues.emplace_back(FLEX_COUNTER_STATUS_FIELD, value);
                     m_flexCounterGroupTable->set(flexCounterGroupMap[key], fieldValues);
+
+                    auto snapshotGroup = counterSnapshotGroupMap.find(key);
+                    if (snapshotGroup != counterSnapshotGroupMap.end())
+                    {
+                        CounterSnapshotOrch::getInstance().setEnabled(snapshotGroup->second, value == "enable");
+                    }
+
+                    if (key == QUEUE_KEY)
+                    {
+                        gPortsOrch->updateQueueCounterStatus(value == "enable");
+                    }
                 }
                 else
                 {
@@ -17,6 +17,7 @@
 #include "directory.h"
 #include "vnetorch.h"
 #include "subscriberstatetable.h"
+#include "countersnapshotorch.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern Directory<Orch*> gDirectory;
@@ -81,24 +82,6 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
     m_flexCounterGroupTable->set(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
 
-    string rifRatePluginName = "rif_rates.lua";
-
-    try
-    {
-        string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
-        string rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(RIF_PLUGIN_FIELD, rifRateSha);
-        fieldValues.emplace_back(POLL_INTERVAL_FIELD, RIF_FLEX_STAT_COUNTER_POLL_MSECS);
-        fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
-        m_flexCounterGroupTable->set(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
-    }
-
     if(gMySwitchType == "voq")
     {
         //Add subscriber to process VOQ system interface
@@ -1310,6 +1293,7 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
     vector<FieldValueTuple> fieldValues;
     fieldValues.emplace_back(RIF_COUNTER_ID_LIST, counters_stream.str());
     m_flexCounterTable->set(key, fieldValues);
+    CounterSnapshotOrch::getInstance().addObject(CounterSnapshotGroup::RIF, id);
     SWSS_LOG_DEBUG("Registered interface %s to Flex counter", name.c_str());
 }
 
@@ -1324,6 +1308,7 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
     string key = getRifFlexCounterTableKey(id);
 
     m_flexCounterTable->del(key);
+    CounterSnapshotOrch::getInstance().removeObject(CounterSnapshotGroup::RIF, id);
     SWSS_LOG_DEBUG("Unregistered interface %s from Flex counter", name.c_str());
 }
 
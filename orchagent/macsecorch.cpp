@@ -464,6 +464,31 @@ MACsecOrch::~MACsecOrch()
         const MACsecOrch::TaskArgs temp;
         taskDisableMACsecPort(port->first, temp);
     }
+    flushCounters();
+}
+
+void MACsecOrch::doTask()
+{
+    SWSS_LOG_ENTER();
+
+    // Drain the tables in dependency order, so that the SAs of a rekey find
+    // their SC, and the receive side is ready before the transmit one switches
+    auto tableOrder = {
+        APP_MACSEC_PORT_TABLE_NAME,
+        APP_MACSEC_EGRESS_SC_TABLE_NAME,
+        APP_MACSEC_INGRESS_SC_TABLE_NAME,
+        APP_MACSEC_INGRESS_SA_TABLE_NAME,
+        APP_MACSEC_EGRESS_SA_TABLE_NAME,
+    };
+
+    for (auto tableName: tableOrder)
+    {
+        auto consumer = getExecutor(tableName);
+        if (consumer != nullptr)
+        {
+            consumer->drain();
+        }
+    }
 }
 
 void MACsecOrch::doTask(Consumer &consumer)
@@ -505,6 +530,17 @@ void MACsecOrch::doTask(Consumer &consumer)
         auto &message = itr->second;
         const std::string &op = kfvOp(message);
 
+        if (op == SET_COMMAND
+            && (table_name == APP_MACSEC_EGRESS_SA_TABLE_NAME
+                || table_name == APP_MACSEC_INGRESS_SA_TABLE_NAME))
+        {
+            startRekey(
+                kfvKey(message),
+                table_name == APP_MACSEC_EGRESS_SA_TABLE_NAME
+                    ? SAI_MACSEC_DIRECTION_EGRESS
+                    : SAI_MACSEC_DIRECTION_INGRESS);
+        }
+
         auto task = TaskMap.find(std::make_tuple(table_name, op));
         if (task != TaskMap.end())
         {
@@ -547,6 +583,8 @@ void MACsecOrch::doTask(Consumer &consumer)
             itr = consumer.m_toSync.erase(itr);
         }
     }
+
+    flushCounters();
 }
 
 task_process_status MACsecOrch::taskUpdateMACsecPort(
@@ -1165,6 +1203,7 @@ bool MACsecOrch::deleteMACsecPort(
     }
 
     m_state_macsec_port.del(port_name);
+    m_rekey_stats.erase(port_name);
 
     return true;
 }
@@ -1683,6 +1722,7 @@ task_process_status MACsecOrch::createMACsecSA(
     {
         installCounter(CounterType::MACSEC_SA_ATTR, port_sci_an, sc->m_sa_ids[an], macsec_egress_sa_attrs);
         m_state_macsec_egress_sa.set(swss::join('|', port_name, sci, an), fvVector);
+        finishRekey(port_name);
     }
     else
     {
@@ -1842,26 +1882,116 @@ void MACsecOrch::installCounter(
     sai_object_id_t obj_id,
     const std::vector<std::string> &stats)
 {
-    FieldValueTuple tuple(obj_name, sai_serialize_object_id(obj_id));
-    vector<FieldValueTuple> fields;
-    fields.push_back(tuple);
-    m_macsec_counters_map.set("", fields);
-
-    std::unordered_set<std::string> counter_stats;
-    for (const auto &stat : stats)
-    {
-        counter_stats.emplace(stat);
-    }
-    m_macsec_flex_counter_manager.setCounterIdList(obj_id, counter_type, counter_stats);
+    m_counter_batch.m_names.emplace_back(obj_name, sai_serialize_object_id(obj_id));
+    m_counter_batch.m_installs[std::make_pair(counter_type, &stats)].push_back(obj_id);
 }
 
+// The counter of an SA is uninstalled right away, so that it isn't polled
+// anymore by the time the SA is removed
 void MACsecOrch::uninstallCounter(const std::string &obj_name, sai_object_id_t obj_id)
 {
+    // The counter of an SA created in the same pass hasn't been installed yet
+    for (auto &install : m_counter_batch.m_installs)
+    {
+        auto &ids = install.second;
+        auto id = std::find(ids.begin(), ids.end(), obj_id);
+        if (id == ids.end())
+        {
+            continue;
+        }
+        ids.erase(id);
+
+        auto &names = m_counter_batch.m_names;
+        names.erase(
+            std::remove_if(
+                names.begin(),
+                names.end(),
+                [&obj_name](const FieldValueTuple &fv) { return fvField(fv) == obj_name; }),
+            names.end());
+        return;
+    }
+
     m_macsec_flex_counter_manager.clearCounterIdList(obj_id);
 
     m_counter_db.hdel(COUNTERS_MACSEC_NAME_MAP, obj_name);
 }
 
+void MACsecOrch::flushCounters()
+{
+    auto &batch = m_counter_batch;
+
+    if (!batch.m_names.empty())
+    {
+        m_macsec_counters_map.set("", batch.m_names);
+    }
+
+    for (const auto &install : batch.m_installs)
+    {
+        if (install.second.empty())
+        {
+            continue;
+        }
+        const auto &stats = *install.first.second;
+        std::unordered_set<std::string> counter_stats(stats.begin(), stats.end());
+        m_macsec_flex_counter_manager.setCounterIdList(install.second, install.first.first, counter_stats);
+    }
+
+    batch = MACsecCounterBatch();
+}
+
+// A rekey starts when an SA is set for an AN its SC doesn't have yet, while
+// the SC already has the SA of the previous key
+void MACsecOrch::startRekey(const std::string &port_sci_an, sai_macsec_direction_t direction)
+{
+    std::string port_name;
+    sai_uint64_t sci = 0;
+    macsec_an_t an = 0;
+    if (!extract_variables(port_sci_an, ':', port_name, sci, an) || an > MAX_SA_NUMBER)
+    {
+        return;
+    }
+
+    MACsecOrchContext ctx(this, port_name, direction, sci, an);
+    auto sc = ctx.get_macsec_sc();
+    if (sc == nullptr || sc->m_sa_ids.empty() || sc->m_sa_ids.find(an) != sc->m_sa_ids.end())
+    {
+        return;
+    }
+
+    auto &stats = m_rekey_stats[port_name];
+    if (!stats.m_pending)
+    {
+        stats.m_pending = true;
+        stats.m_start = std::chrono::steady_clock::now();
+    }
+}
+
+// A rekey completes once the egress SA carrying the new key is programmed,
+// its latency runs from the first SA of the key reaching MACsecOrch
+void MACsecOrch::finishRekey(const std::string &port_name)
+{
+    auto itr = m_rekey_stats.find(port_name);
+    if (itr == m_rekey_stats.end() || !itr->second.m_pending)
+    {
+        return;
+    }
+
+    auto &stats = itr->second;
+    auto latency_us = static_cast<sai_uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - stats.m_start).count());
+    stats.m_pending = false;
+    stats.m_count++;
+    stats.m_max_latency_us = std::max(stats.m_max_latency_us, latency_us);
+
+    std::vector<FieldValueTuple> fvVector;
+    fvVector.emplace_back("rekey_count", std::to_string(stats.m_count));
+    fvVector.emplace_back("last_rekey_latency_us", std::to_string(latency_us));
+    fvVector.emplace_back("max_rekey_latency_us", std::to_string(stats.m_max_latency_us));
+    m_state_macsec_port.set(port_name, fvVector);
+
+    SWSS_LOG_INFO("MACsec rekey of port %s took %" PRIu64 " us", port_name.c_str(), latency_us);
+}
+
 bool MACsecOrch::initMACsecACLTable(
     MACsecACLTable &acl_table,
     sai_object_id_t port_id,
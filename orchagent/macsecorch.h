@@ -9,6 +9,7 @@
 #include <dbconnector.h>
 #include <swss/schema.h>
 
+#include <chrono>
 #include <map>
 #include <string>
 #include <vector>
@@ -35,6 +36,7 @@ public:
     ~MACsecOrch();
 
 private:
+    void doTask();
     void doTask(Consumer &consumer);
 
 public:
@@ -196,6 +198,29 @@ private:
         sai_object_id_t obj_id,
         const std::vector<std::string> &stats);
     void uninstallCounter(const std::string &obj_name, sai_object_id_t obj_id);
+    void flushCounters();
+
+    /* Counters of the SAs created while draining a table,
+       they are installed in bulk once it is drained */
+    struct MACsecCounterBatch
+    {
+        std::vector<FieldValueTuple>                    m_names;
+        std::map<std::pair<CounterType, const std::vector<std::string> *>,
+                 std::vector<sai_object_id_t> >         m_installs;
+    };
+    MACsecCounterBatch m_counter_batch;
+
+    /* Rekey latency */
+    struct MACsecRekeyStats
+    {
+        bool                                    m_pending;
+        std::chrono::steady_clock::time_point   m_start;
+        sai_uint64_t                            m_count;
+        sai_uint64_t                            m_max_latency_us;
+    };
+    map<std::string, MACsecRekeyStats> m_rekey_stats;
+    void startRekey(const std::string &port_sci_an, sai_macsec_direction_t direction);
+    void finishRekey(const std::string &port_name);
 
     /* MACsec ACL */
     bool initMACsecACLTable(
@@ -151,6 +151,15 @@ void MirrorOrch::update(SubjectType type, void *cntx)
         updateNeighbor(*update);
         break;
     }
+    case SUBJECT_TYPE_NEIGH_BULK_CHANGE:
+    {
+        NeighborBulkUpdate *update = static_cast<NeighborBulkUpdate *>(cntx);
+        for (const auto &neigh_update : update->updates)
+        {
+            updateNeighbor(neigh_update);
+        }
+        break;
+    }
     case SUBJECT_TYPE_FDB_CHANGE:
     {
         FdbUpdate *update = static_cast<FdbUpdate *>(cntx);
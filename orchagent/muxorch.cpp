@@ -5,6 +5,7 @@
 #include <unordered_set>
 #include <stdexcept>
 #include <inttypes.h>
+#include <chrono>
 
 #include "sai.h"
 #include "ipaddress.h"
@@ -18,6 +19,7 @@
 #include "neighorch.h"
 #include "portsorch.h"
 #include "aclorch.h"
+#include "bulker.h"
 
 /* Global variables */
 extern Directory<Orch*> gDirectory;
@@ -41,6 +43,9 @@ extern sai_router_interface_api_t* sai_router_intfs_api;
 #define MUX_HW_STATE_UNKNOWN "unknown"
 #define MUX_HW_STATE_PENDING "pending"
 
+/* Upper bounds of the switchover duration histogram buckets */
+const vector<uint64_t> mux_switchover_buckets_ms = { 10, 50, 100, 250, 500, 1000, 2500, 5000 };
+
 const map<std::pair<MuxState, MuxState>, MuxStateChange> muxStateTransition =
 {
     { { MuxState::MUX_STATE_INIT, MuxState::MUX_STATE_ACTIVE}, MuxStateChange::MUX_STATE_INIT_ACTIVE
@@ -85,13 +90,65 @@ static inline MuxStateChange mux_state_change (MuxState prev, MuxState curr)
     return MuxStateChange::MUX_STATE_UNKNOWN_STATE;
 }
 
-static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
+static void fill_route_entry(sai_route_entry_t &route_entry, IpPrefix &pfx)
 {
-    sai_route_entry_t route_entry;
     route_entry.switch_id = gSwitchId;
     route_entry.vr_id = gVirtualRouterId;
     copy(route_entry.destination, pfx);
     subnet(route_entry.destination, route_entry.destination);
+}
+
+static void update_route_crm(const sai_route_entry_t &route_entry, bool add)
+{
+    CrmResourceType resource = (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+                               CrmResourceType::CRM_IPV4_ROUTE : CrmResourceType::CRM_IPV6_ROUTE;
+    if (add)
+    {
+        gCrmOrch->incCrmResUsedCounter(resource);
+    }
+    else
+    {
+        gCrmOrch->decCrmResUsedCounter(resource);
+    }
+}
+
+static bool remove_routes(vector<IpPrefix> &pfxs)
+{
+    EntityBulker<sai_route_api_t> bulker(sai_route_api);
+    vector<sai_route_entry_t> route_entries(pfxs.size());
+    vector<sai_status_t> statuses(pfxs.size());
+
+    for (size_t i = 0; i < pfxs.size(); i++)
+    {
+        fill_route_entry(route_entries[i], pfxs[i]);
+        bulker.remove_entry(&statuses[i], &route_entries[i]);
+    }
+    bulker.flush();
+
+    bool success = true;
+    for (size_t i = 0; i < pfxs.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove tunnel route %s, rv:%d",
+                            pfxs[i].getIp().to_string().c_str(), statuses[i]);
+            success = false;
+            continue;
+        }
+
+        update_route_crm(route_entries[i], false);
+        SWSS_LOG_NOTICE("Removed tunnel route to %s ", pfxs[i].to_string().c_str());
+    }
+
+    return success;
+}
+
+/* Either all the routes are created, or none of them */
+static bool create_routes(vector<IpPrefix> &pfxs, sai_object_id_t nh)
+{
+    EntityBulker<sai_route_api_t> bulker(sai_route_api);
+    vector<sai_route_entry_t> route_entries(pfxs.size());
+    vector<sai_status_t> statuses(pfxs.size());
 
     sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
@@ -104,54 +161,35 @@ static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
     attr.value.oid = nh;
     attrs.push_back(attr);
 
-    sai_status_t status = sai_route_api->create_route_entry(&route_entry, (uint32_t)attrs.size(), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < pfxs.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to create tunnel route %s,nh %" PRIx64 " rv:%d",
-                pfx.getIp().to_string().c_str(), nh, status);
-        return status;
+        fill_route_entry(route_entries[i], pfxs[i]);
+        bulker.create_entry(&statuses[i], &route_entries[i], (uint32_t)attrs.size(), attrs.data());
     }
+    bulker.flush();
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-    }
-    else
+    vector<IpPrefix> created;
+    for (size_t i = 0; i < pfxs.size(); i++)
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
-
-    SWSS_LOG_NOTICE("Created tunnel route to %s ", pfx.to_string().c_str());
-    return status;
-}
-
-static sai_status_t remove_route(IpPrefix &pfx)
-{
-    sai_route_entry_t route_entry;
-    route_entry.switch_id = gSwitchId;
-    route_entry.vr_id = gVirtualRouterId;
-    copy(route_entry.destination, pfx);
-    subnet(route_entry.destination, route_entry.destination);
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create tunnel route %s,nh %" PRIx64 " rv:%d",
+                    pfxs[i].getIp().to_string().c_str(), nh, statuses[i]);
+            continue;
+        }
 
-    sai_status_t status = sai_route_api->remove_route_entry(&route_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to remove tunnel route %s, rv:%d",
-                        pfx.getIp().to_string().c_str(), status);
-        return status;
+        update_route_crm(route_entries[i], true);
+        SWSS_LOG_NOTICE("Created tunnel route to %s ", pfxs[i].to_string().c_str());
+        created.push_back(pfxs[i]);
     }
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    if (created.size() != pfxs.size())
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-    }
-    else
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        remove_routes(created);
+        return false;
     }
 
-    SWSS_LOG_NOTICE("Removed tunnel route to %s ", pfx.to_string().c_str());
-    return status;
+    return true;
 }
 
 static sai_object_id_t create_tunnel(const IpAddress* p_dst_ip, const IpAddress* p_src_ip)
@@ -346,12 +384,8 @@ bool MuxCable::stateActive()
         return false;
     }
 
-    if (remove_route(srv_ip4_) != SAI_STATUS_SUCCESS)
-    {
-        return false;
-    }
-
-    if (remove_route(srv_ip6_) != SAI_STATUS_SUCCESS)
+    vector<IpPrefix> routes = { srv_ip4_, srv_ip6_ };
+    if (!remove_routes(routes))
     {
         return false;
     }
@@ -380,28 +414,21 @@ bool MuxCable::stateStandby()
         return false;
     }
 
-    if (create_route(srv_ip4_, nh) != SAI_STATUS_SUCCESS)
-    {
-        return false;
-    }
-
-    if (create_route(srv_ip6_, nh) != SAI_STATUS_SUCCESS)
+    vector<IpPrefix> routes = { srv_ip4_, srv_ip6_ };
+    if (!create_routes(routes, nh))
     {
-        remove_route(srv_ip4_);
         return false;
     }
 
     if (!nbrHandler(false))
     {
-        remove_route(srv_ip4_);
-        remove_route(srv_ip6_);
+        remove_routes(routes);
         return false;
     }
 
     if (!aclHandler(port.m_port_id))
     {
-        remove_route(srv_ip4_);
-        remove_route(srv_ip6_);
+        remove_routes(routes);
         SWSS_LOG_INFO("Add ACL drop rule failed for %s", mux_name_.c_str());
         return false;
     }
@@ -432,6 +459,8 @@ void MuxCable::setState(string new_state)
 
     st_chg_in_progress_ = true;
 
+    auto start = std::chrono::steady_clock::now();
+
     if (!(this->*(state_machine_handlers_[it->second]))())
     {
         //Reset back to original state
@@ -443,6 +472,9 @@ void MuxCable::setState(string new_state)
     st_chg_in_progress_ = false;
     SWSS_LOG_INFO("Changed state to %s", new_state.c_str());
 
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    mux_state_orch_->updateSwitchoverStats(mux_name_, new_state, static_cast<uint64_t>(duration.count()));
+
     return;
 }
 
@@ -508,40 +540,26 @@ void MuxNbrHandler::update(IpAddress ip, string alias, bool add)
     }
 }
 
-bool MuxNbrHandler::enable()
+vector<NeighborEntry> MuxNbrHandler::getNeighbors() const
 {
-    NeighborEntry neigh;
+    vector<NeighborEntry> neighs;
 
-    auto it = neighbors_.getIpAddresses().begin();
-    while (it != neighbors_.getIpAddresses().end())
+    for (const auto &ip : neighbors_.getIpAddresses())
     {
-        neigh = NeighborEntry(*it, alias_);
-        if (!gNeighOrch->enableNeighbor(neigh))
-        {
-            return false;
-        }
-        it++;
+        neighs.emplace_back(ip, alias_);
     }
 
-    return true;
+    return neighs;
 }
 
-bool MuxNbrHandler::disable()
+bool MuxNbrHandler::enable()
 {
-    NeighborEntry neigh;
-
-    auto it = neighbors_.getIpAddresses().begin();
-    while (it != neighbors_.getIpAddresses().end())
-    {
-        neigh = NeighborEntry(*it, alias_);
-        if (!gNeighOrch->disableNeighbor(neigh))
-        {
-            return false;
-        }
-        it++;
-    }
+    return gNeighOrch->enableNeighbors(getNeighbors());
+}
 
-    return true;
+bool MuxNbrHandler::disable()
+{
+    return gNeighOrch->disableNeighbors(getNeighbors());
 }
 
 std::map<std::string, AclTable> MuxAclHandler::acl_table_;
@@ -718,6 +736,15 @@ void MuxOrch::update(SubjectType type, void *cntx)
             updateNeighbor(*update);
             break;
         }
+        case SUBJECT_TYPE_NEIGH_BULK_CHANGE:
+        {
+            NeighborBulkUpdate *update = static_cast<NeighborBulkUpdate *>(cntx);
+            for (const auto &neigh_update : update->updates)
+            {
+                updateNeighbor(neigh_update);
+            }
+            break;
+        }
         default:
             /* Received update in which we are not interested
              * Ignore it
@@ -926,11 +953,48 @@ bool MuxCableOrch::delOperation(const Request& request)
 
 MuxStateOrch::MuxStateOrch(DBConnector *db, const std::string& tableName) :
               Orch2(db, tableName, request_),
-              mux_state_table_(db, STATE_MUX_CABLE_TABLE_NAME)
+              mux_state_table_(db, STATE_MUX_CABLE_TABLE_NAME),
+              mux_switchover_table_(db, STATE_MUX_SWITCHOVER_TABLE_NAME)
 {
      SWSS_LOG_ENTER();
 }
 
+void MuxStateOrch::updateSwitchoverStats(string portName, string muxState, uint64_t duration_us)
+{
+    auto &histogram = switchover_histogram_[portName];
+    histogram.resize(mux_switchover_buckets_ms.size() + 1, 0);
+
+    size_t bucket = 0;
+    while (bucket < mux_switchover_buckets_ms.size() && duration_us > mux_switchover_buckets_ms[bucket] * 1000)
+    {
+        bucket++;
+    }
+    histogram[bucket]++;
+
+    vector<FieldValueTuple> tuples;
+    tuples.emplace_back("last_state", muxState);
+    tuples.emplace_back("last_duration_us", to_string(duration_us));
+
+    uint64_t count = 0;
+    uint64_t lower = 0;
+    for (size_t i = 0; i < histogram.size(); i++)
+    {
+        string field = (i < mux_switchover_buckets_ms.size()) ?
+                       to_string(lower) + "-" + to_string(mux_switchover_buckets_ms[i]) + "ms" :
+                       to_string(lower) + "ms+";
+        tuples.emplace_back(field, to_string(histogram[i]));
+
+        count += histogram[i];
+        if (i < mux_switchover_buckets_ms.size())
+        {
+            lower = mux_switchover_buckets_ms[i];
+        }
+    }
+    tuples.emplace_back("count", to_string(count));
+
+    mux_switchover_table_.set(portName, tuples);
+}
+
 void MuxStateOrch::updateMuxState(string portName, string muxState)
 {
     vector<FieldValueTuple> tuples;
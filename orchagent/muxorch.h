@@ -9,6 +9,10 @@
 #include "portsorch.h"
 #include "tunneldecaporch.h"
 #include "aclorch.h"
+#include "neighorch.h"
+
+// STATE_DB table with the duration histogram of each port's switchovers
+#define STATE_MUX_SWITCHOVER_TABLE_NAME "MUX_SWITCHOVER_TABLE"
 
 enum MuxState
 {
@@ -60,6 +64,8 @@ public:
     void update(IpAddress, string alias = "", bool = true);
 
 private:
+    vector<NeighborEntry> getNeighbors() const;
+
     IpAddresses neighbors_;
     string alias_;
 };
@@ -239,11 +245,15 @@ public:
     MuxStateOrch(DBConnector *db, const std::string& tableName);
 
     void updateMuxState(string portName, string muxState);
+    void updateSwitchoverStats(string portName, string muxState, uint64_t duration_us);
 
 private:
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
     swss::Table mux_state_table_;
+    swss::Table mux_switchover_table_;
+    // port -> switchover count of each duration bucket
+    map<string, vector<uint64_t>> switchover_histogram_;
     MuxStateRequest request_;
 };
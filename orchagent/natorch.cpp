@@ -37,7 +37,6 @@ extern bool               gIsNatSupported;
 #ifdef DEBUG_FRAMEWORK
 extern DebugDumpOrch      *gDebugDumpOrch;
 #endif
-uint32_t  natTimerTickCntr  = 0;
 bool      gNhTrackingSupported = false;
 
 NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames,
@@ -87,9 +86,10 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
     auto cleanupNotifier = new Notifier(m_cleanupNotificationConsumer, this, "NAT_DB_CLEANUP_NOTIFICATION");
     Orch::addExecutor(cleanupNotifier);
 
-    /* Start the timer to query NAT entry statistics every 5 secs and hitbits every 30 secs */
+    /* Start the timer to query NAT entry statistics and hitbits. Every tick queries
+     * a slice of the entry counters and the hitbits of the entries that are due. */
     SWSS_LOG_INFO("Start the HITBIT Timer ");
-    auto interval      = timespec { .tv_sec = NAT_HITBIT_N_CNTRS_QUERY_PERIOD, .tv_nsec = 0 };
+    auto interval      = timespec { .tv_sec = NAT_QUERY_TICK_PERIOD, .tv_nsec = 0 };
     m_natQueryTimer = new SelectableTimer(interval);
     auto executor   = new ExecutableTimer(m_natQueryTimer, this, "NAT_HITBIT_N_CNTRS_QUERY_TIMER");
     Orch::addExecutor(executor);
@@ -170,6 +170,15 @@ void NatOrch::update(SubjectType type, void *cntx)
             updateNeighbor(*update);
             break;
         }
+        case SUBJECT_TYPE_NEIGH_BULK_CHANGE:
+        {
+            NeighborBulkUpdate *update = static_cast<NeighborBulkUpdate *>(cntx);
+            for (const auto &neigh_update : update->updates)
+            {
+                updateNeighbor(neigh_update);
+            }
+            break;
+        }
         default:
             /* Received update in which we are not interested
              * Ignore it
@@ -1308,6 +1317,7 @@ bool NatOrch::addHwSnatEntry(const IpAddress &ip_address)
     updateNatCounters(ip_address, 0, 0);
     m_natEntries[ip_address].addedToHw = true;
     m_natEntries[ip_address].activeTime = time_now.tv_sec;
+    scheduleHitBitQuery(ip_address, time_now.tv_sec);
 
     if (entry.entry_type == "static")
     {
@@ -1389,6 +1399,7 @@ bool NatOrch::addHwTwiceNatEntry(const TwiceNatEntryKey &key)
     updateTwiceNatCounters(key, 0, 0);
     m_twiceNatEntries[key].addedToHw = true; 
     m_twiceNatEntries[key].activeTime = time_now.tv_sec;
+    scheduleHitBitQuery(key, time_now.tv_sec);
 
     totalDnatEntries++;
     updateDnatCounters(totalDnatEntries);
@@ -1476,6 +1487,7 @@ bool NatOrch::addHwSnaptEntry(const NaptEntryKey &keyEntry)
 
      m_naptEntries[keyEntry].addedToHw = true;
      m_naptEntries[keyEntry].activeTime = time_now.tv_sec;
+     scheduleHitBitQuery(keyEntry, time_now.tv_sec);
 
      updateNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port, 0, 0);
 
@@ -1575,6 +1587,7 @@ bool NatOrch::addHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
      updateTwiceNaptCounters(key, 0, 0);
      m_twiceNaptEntries[key].addedToHw = true;
      m_twiceNaptEntries[key].activeTime = time_now.tv_sec;
+     scheduleHitBitQuery(key, time_now.tv_sec);
 
      totalDnatEntries++;
      updateDnatCounters(totalDnatEntries);
@@ -2897,6 +2910,7 @@ void NatOrch::doNatGlobalTableTask(Consumer& consumer)
         string op = kfvOp(t);
         string mode;
         vector<string> keys = tokenize(key, ':');
+        bool timeoutChanged = false;
          
         /* Example : APPL_DB
          * NAT_GLOBAL_TABLE:Values
@@ -2933,20 +2947,32 @@ void NatOrch::doNatGlobalTableTask(Consumer& consumer)
             }
             else if (fvField(i) == "nat_tcp_timeout")
             {
-                tcp_timeout = stoi(fvValue(i));
+                int value = stoi(fvValue(i));
+                timeoutChanged |= (value != tcp_timeout);
+                tcp_timeout = value;
             }
             else if (fvField(i) == "nat_udp_timeout")
             {
-                udp_timeout = stoi(fvValue(i));
+                int value = stoi(fvValue(i));
+                timeoutChanged |= (value != udp_timeout);
+                udp_timeout = value;
             }
             else if (fvField(i) == "nat_timeout")
             {
-                timeout = stoi(fvValue(i));
+                int value = stoi(fvValue(i));
+                timeoutChanged |= (value != timeout);
+                timeout = value;
             }
         }
 
         SWSS_LOG_INFO("Global Values - Admin mode - %s, TCP - %d, UDP - %d and Both - %d", admin_mode.c_str(), tcp_timeout, udp_timeout, timeout);
 
+        if (timeoutChanged)
+        {
+            /* The query interval of the entries depends on the timeouts */
+            rescheduleAllHitBitQueries();
+        }
+
         it = consumer.m_toSync.erase(it);
     }
 }
@@ -3085,10 +3111,7 @@ void NatOrch::doTask(SelectableTimer &timer)
 
     if (timer.getFd() == m_natQueryTimer->getFd())
     {
-        if (((natTimerTickCntr++) % NAT_HITBIT_QUERY_MULTIPLE) == 0)
-        {
-            queryHitBits();
-        }
+        queryHitBits();
         queryCounters();
     }
     else if (timer.getFd() == m_natTimeoutTimer->getFd())
@@ -3102,53 +3125,62 @@ void NatOrch::doTask(SelectableTimer &timer)
     }
 }
 
-void NatOrch::queryCounters(void)
+/* Query the next slice of the entries after the cursor, wrapping to the start
+ * of the table at its end, so that every entry is queried once in
+ * NAT_HITBIT_N_CNTRS_QUERY_PERIOD ticks without walking the whole table at once.
+ */
+template <typename Entries, typename Query>
+static uint32_t queryNextSlice(Entries &entries, NatQueryCursor<typename Entries::key_type> &cursor, Query query)
 {
-    SWSS_LOG_ENTER();
-
-    uint32_t         queried_entries = 0;
-    struct timespec  time_now, time_end, time_spent;
-
-    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    if (entries.empty())
     {
-        return;
+        cursor.valid = false;
+        return 0;
     }
 
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
-    {
-        getNatCounters(natIter);
+    size_t slice = (entries.size() + NAT_HITBIT_N_CNTRS_QUERY_PERIOD - 1) / NAT_HITBIT_N_CNTRS_QUERY_PERIOD;
+    slice = min(slice, static_cast<size_t>(NAT_QUERY_MAX_ENTRIES_PER_TICK));
 
-        queried_entries++;
-        natIter++;
-    }
+    auto iter = cursor.valid ? entries.upper_bound(cursor.key) : entries.begin();
+    uint32_t queried_entries = 0;
 
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    while (queried_entries < slice)
     {
-        getNaptCounters(naptIter);
+        if (iter == entries.end())
+        {
+            iter = entries.begin();
+        }
+        query(iter);
 
+        cursor.key   = iter->first;
+        cursor.valid = true;
         queried_entries++;
-        naptIter++;
+        iter++;
     }
-    TwiceNatEntry::iterator tnatIter = m_twiceNatEntries.begin();
-    while (tnatIter != m_twiceNatEntries.end())
-    {
-        getTwiceNatCounters(tnatIter);
+    return queried_entries;
+}
 
-        queried_entries++;
-        tnatIter++;
-    }
+void NatOrch::queryCounters(void)
+{
+    SWSS_LOG_ENTER();
 
-    TwiceNaptEntry::iterator tnaptIter = m_twiceNaptEntries.begin();
-    while (tnaptIter != m_twiceNaptEntries.end())
-    {
-        getTwiceNaptCounters(tnaptIter);
+    uint32_t         queried_entries = 0;
+    struct timespec  time_now, time_end, time_spent;
 
-        queried_entries++;
-        tnaptIter++;
+    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    {
+        return;
     }
 
+    queried_entries += queryNextSlice(m_natEntries, m_natQueryCursor,
+                                      [this](const NatEntry::iterator &iter) { getNatCounters(iter); });
+    queried_entries += queryNextSlice(m_naptEntries, m_naptQueryCursor,
+                                      [this](const NaptEntry::iterator &iter) { getNaptCounters(iter); });
+    queried_entries += queryNextSlice(m_twiceNatEntries, m_twiceNatQueryCursor,
+                                      [this](const TwiceNatEntry::iterator &iter) { getTwiceNatCounters(iter); });
+    queried_entries += queryNextSlice(m_twiceNaptEntries, m_twiceNaptQueryCursor,
+                                      [this](const TwiceNaptEntry::iterator &iter) { getTwiceNaptCounters(iter); });
+
     if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
     {
         return;
@@ -3288,6 +3320,141 @@ void NatOrch::clearCounters(void)
     }
 }
 
+/* Remove the slots that are due by now from the schedule, at most
+ * NAT_QUERY_MAX_ENTRIES_PER_TICK of them, the rest are left for the next tick.
+ */
+template <typename Key>
+static vector<pair<time_t, Key>> popDueHitBitQueries(NatAgingSchedule<Key> &schedule, time_t now)
+{
+    vector<pair<time_t, Key>> due;
+
+    auto iter = schedule.begin();
+    while ((iter != schedule.end()) && (iter->first <= now) && (due.size() < NAT_QUERY_MAX_ENTRIES_PER_TICK))
+    {
+        due.push_back(*iter);
+        iter = schedule.erase(iter);
+    }
+    return due;
+}
+
+/* Entries are queried a fixed number of times per timeout, but not more often
+ * than every 30 secs. An idle entry is queried again when it is due to age out.
+ */
+time_t NatOrch::getHitBitQueryTime(time_t now, time_t activeTime, int entryTimeout, bool active)
+{
+    time_t minInterval = NAT_HITBIT_N_CNTRS_QUERY_PERIOD * NAT_HITBIT_QUERY_MULTIPLE;
+    time_t interval    = max(minInterval, static_cast<time_t>(entryTimeout / NAT_HITBIT_QUERIES_PER_TIMEOUT));
+    time_t queryTime   = now + interval;
+
+    if (!active)
+    {
+        queryTime = min(queryTime, max(activeTime + entryTimeout, now + minInterval));
+    }
+    return queryTime;
+}
+
+void NatOrch::scheduleHitBitQuery(const IpAddress &ipAddr, time_t now)
+{
+    auto iter = m_natEntries.find(ipAddr);
+    if ((iter == m_natEntries.end()) or (iter->second.nat_type != "snat") or
+        (iter->second.entry_type == "static"))
+    {
+        /* Static entries never age out, DNAT hitbits are queried along with SNAT */
+        return;
+    }
+
+    iter->second.hitBitQueryTime = getHitBitQueryTime(now, iter->second.activeTime, timeout, true);
+    m_natAgingSchedule.emplace(iter->second.hitBitQueryTime, ipAddr);
+}
+
+void NatOrch::scheduleHitBitQuery(const NaptEntryKey &key, time_t now)
+{
+    auto iter = m_naptEntries.find(key);
+    if ((iter == m_naptEntries.end()) or (iter->second.nat_type != "snat") or
+        (iter->second.entry_type == "static"))
+    {
+        return;
+    }
+
+    int timeout = key.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+    iter->second.hitBitQueryTime = getHitBitQueryTime(now, iter->second.activeTime, timeout, true);
+    m_naptAgingSchedule.emplace(iter->second.hitBitQueryTime, key);
+}
+
+void NatOrch::scheduleHitBitQuery(const TwiceNatEntryKey &key, time_t now)
+{
+    auto iter = m_twiceNatEntries.find(key);
+    if ((iter == m_twiceNatEntries.end()) or (iter->second.entry_type == "static"))
+    {
+        return;
+    }
+
+    iter->second.hitBitQueryTime = getHitBitQueryTime(now, iter->second.activeTime, timeout, true);
+    m_twiceNatAgingSchedule.emplace(iter->second.hitBitQueryTime, key);
+}
+
+void NatOrch::scheduleHitBitQuery(const TwiceNaptEntryKey &key, time_t now)
+{
+    auto iter = m_twiceNaptEntries.find(key);
+    if ((iter == m_twiceNaptEntries.end()) or (iter->second.entry_type == "static"))
+    {
+        return;
+    }
+
+    int timeout = key.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+    iter->second.hitBitQueryTime = getHitBitQueryTime(now, iter->second.activeTime, timeout, true);
+    m_twiceNaptAgingSchedule.emplace(iter->second.hitBitQueryTime, key);
+}
+
+void NatOrch::rescheduleAllHitBitQueries(void)
+{
+    SWSS_LOG_ENTER();
+
+    struct timespec  time_now;
+
+    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    {
+        return;
+    }
+
+    m_natAgingSchedule.clear();
+    m_naptAgingSchedule.clear();
+    m_twiceNatAgingSchedule.clear();
+    m_twiceNaptAgingSchedule.clear();
+
+    for (const auto &natEntry : m_natEntries)
+    {
+        if (natEntry.second.addedToHw == true)
+        {
+            scheduleHitBitQuery(natEntry.first, time_now.tv_sec);
+        }
+    }
+
+    for (const auto &naptEntry : m_naptEntries)
+    {
+        if (naptEntry.second.addedToHw == true)
+        {
+            scheduleHitBitQuery(naptEntry.first, time_now.tv_sec);
+        }
+    }
+
+    for (const auto &twiceNatEntry : m_twiceNatEntries)
+    {
+        if (twiceNatEntry.second.addedToHw == true)
+        {
+            scheduleHitBitQuery(twiceNatEntry.first, time_now.tv_sec);
+        }
+    }
+
+    for (const auto &twiceNaptEntry : m_twiceNaptEntries)
+    {
+        if (twiceNaptEntry.second.addedToHw == true)
+        {
+            scheduleHitBitQuery(twiceNaptEntry.first, time_now.tv_sec);
+        }
+    }
+}
+
 void NatOrch::queryHitBits(void)
 {
     SWSS_LOG_ENTER();
@@ -3300,120 +3467,118 @@ void NatOrch::queryHitBits(void)
         return;
     }
 
-    /* Remove the NAT entries that are aged out.
-     * Query the NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    /* Only the dynamic entries that are due are queried for their activity
+     * in the hardware. Active entries get their active time reset, idle ones
+     * are reported for removal once they are idle for the timeout. */
+    for (const auto &slot : popDueHitBitQueries(m_natAgingSchedule, time_now.tv_sec))
     {
-        if (checkIfNatEntryIsActive(natIter, time_now.tv_sec))
+        NatEntry::iterator natIter = m_natEntries.find(slot.second);
+        if ((natIter == m_natEntries.end()) or (natIter->second.addedToHw == false) or
+            (natIter->second.entry_type == "static") or (natIter->second.hitBitQueryTime != slot.first))
+        {
+            /* Entry was removed or rescheduled after the slot was added */
+            continue;
+        }
+
+        bool active = checkIfNatEntryIsActive(natIter, time_now.tv_sec);
+        if (active)
         {
             /* Since the entry is active in the hardware, reset the active time */
             natIter->second.activeTime = time_now.tv_sec;
         }
-        else
+        else if (time_now.tv_sec - natIter->second.activeTime >= timeout)
         {
-            if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
-                (natIter->second.entry_type != "static"))
-            {
-                if (time_now.tv_sec - natIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = natIter->first.to_string();
-                    setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
-                }
-            } 
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = natIter->first.to_string();
+            setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
         }
+
+        natIter->second.hitBitQueryTime = getHitBitQueryTime(time_now.tv_sec, natIter->second.activeTime, timeout, active);
+        m_natAgingSchedule.emplace(natIter->second.hitBitQueryTime, natIter->first);
         queried_entries++;
-        natIter++;
     }
 
-    /* Remove the NAPT entries that are aged out.
-     * Query the NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    for (const auto &slot : popDueHitBitQueries(m_naptAgingSchedule, time_now.tv_sec))
     {
-        if (checkIfNaptEntryIsActive(naptIter, time_now.tv_sec))
+        NaptEntry::iterator naptIter = m_naptEntries.find(slot.second);
+        if ((naptIter == m_naptEntries.end()) or (naptIter->second.addedToHw == false) or
+            (naptIter->second.entry_type == "static") or (naptIter->second.hitBitQueryTime != slot.first))
+        {
+            continue;
+        }
+
+        int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+        bool active = checkIfNaptEntryIsActive(naptIter, time_now.tv_sec);
+        if (active)
         {
-            /* Since the entry is active in the hardware, reset the active time */
             naptIter->second.activeTime = time_now.tv_sec;
         }
-        else
+        else if (time_now.tv_sec - naptIter->second.activeTime >= timeout)
         {
-            if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
-                (naptIter->second.entry_type != "static"))
-            {
-                int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
-                if (time_now.tv_sec - naptIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
-                    setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
-                }
-            }
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
+            setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
         }
+
+        naptIter->second.hitBitQueryTime = getHitBitQueryTime(time_now.tv_sec, naptIter->second.activeTime, timeout, active);
+        m_naptAgingSchedule.emplace(naptIter->second.hitBitQueryTime, naptIter->first);
         queried_entries++;
-        naptIter++;
     }
 
-    /* Remove the Twice NAT entries that are aged out.
-     * Query the Twice NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (const auto &slot : popDueHitBitQueries(m_twiceNatAgingSchedule, time_now.tv_sec))
     {
-        if (checkIfTwiceNatEntryIsActive(twiceNatIter, time_now.tv_sec))
+        TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.find(slot.second);
+        if ((twiceNatIter == m_twiceNatEntries.end()) or (twiceNatIter->second.addedToHw == false) or
+            (twiceNatIter->second.entry_type == "static") or (twiceNatIter->second.hitBitQueryTime != slot.first))
+        {
+            continue;
+        }
+
+        bool active = checkIfTwiceNatEntryIsActive(twiceNatIter, time_now.tv_sec);
+        if (active)
         {
-            /* Since the entry is active in the hardware, reset the active time */
             twiceNatIter->second.activeTime = time_now.tv_sec;
         }
-        else
+        else if (time_now.tv_sec - twiceNatIter->second.activeTime >= timeout)
         {
-            if ((twiceNatIter->second.addedToHw == true) and
-                (twiceNatIter->second.entry_type != "static"))
-            {
-                if (time_now.tv_sec - twiceNatIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
-                    setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
-                }
-            }
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
+            setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
         }
+
+        twiceNatIter->second.hitBitQueryTime = getHitBitQueryTime(time_now.tv_sec, twiceNatIter->second.activeTime, timeout, active);
+        m_twiceNatAgingSchedule.emplace(twiceNatIter->second.hitBitQueryTime, twiceNatIter->first);
         queried_entries++;
-        twiceNatIter++;
     }
 
-    /* Remove the Twice NAPT entries that are aged out.
-     * Query the Twice NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+    for (const auto &slot : popDueHitBitQueries(m_twiceNaptAgingSchedule, time_now.tv_sec))
     {
-        if (checkIfTwiceNaptEntryIsActive(twiceNaptIter, time_now.tv_sec))
+        TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.find(slot.second);
+        if ((twiceNaptIter == m_twiceNaptEntries.end()) or (twiceNaptIter->second.addedToHw == false) or
+            (twiceNaptIter->second.entry_type == "static") or (twiceNaptIter->second.hitBitQueryTime != slot.first))
+        {
+            continue;
+        }
+
+        int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+        bool active = checkIfTwiceNaptEntryIsActive(twiceNaptIter, time_now.tv_sec);
+        if (active)
         {
-            /* Since the entry is active in the hardware, reset the active time */
             twiceNaptIter->second.activeTime = time_now.tv_sec;
         }
-        else
+        else if (time_now.tv_sec - twiceNaptIter->second.activeTime >= timeout)
         {
-            if ((twiceNaptIter->second.addedToHw == true) and
-                (twiceNaptIter->second.entry_type != "static"))
-            {
-                int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
-                if (time_now.tv_sec - twiceNaptIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) + 
-                                       ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
-                    setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
-                }
-            }
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) + 
+                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
+            setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
         }
+
+        twiceNaptIter->second.hitBitQueryTime = getHitBitQueryTime(time_now.tv_sec, twiceNaptIter->second.activeTime, timeout, active);
+        m_twiceNaptAgingSchedule.emplace(twiceNaptIter->second.hitBitQueryTime, twiceNaptIter->first);
         queried_entries++;
-        twiceNaptIter++;
     }
+
     if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
     {
         return;
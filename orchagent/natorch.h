@@ -34,9 +34,12 @@
 #endif
 
 #define VALUES                            "Values" // Global Values Key
-#define NAT_HITBIT_N_CNTRS_QUERY_PERIOD   5        // 5 secs
+#define NAT_QUERY_TICK_PERIOD             1        // 1 sec
+#define NAT_HITBIT_N_CNTRS_QUERY_PERIOD   5        // Counters of every entry are refreshed every 5 secs
 #define NAT_CONNTRACK_TIMEOUT_PERIOD      86400    // 1 day
-#define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits are queried every 30 secs
+#define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits of an entry are queried at most every 30 secs
+#define NAT_HITBIT_QUERIES_PER_TIMEOUT    10       // Hit bits are queried 10 times per entry timeout
+#define NAT_QUERY_MAX_ENTRIES_PER_TICK    1024     // Max entries of each table queried per timer tick
 
 struct NatEntryValue
 {
@@ -46,6 +49,7 @@ struct NatEntryValue
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
     bool           addedToHw;          // Boolean to represent added to hardware
+    time_t         hitBitQueryTime;    // Timestamp in secs when the hit bits are queried next
 
     bool operator<(const NatEntryValue& other) const
     {
@@ -74,6 +78,7 @@ struct NaptEntryValue
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
     bool           addedToHw;          // Boolean to represent added to hardware
+    time_t         hitBitQueryTime;    // Timestamp in secs when the hit bits are queried next
 
     bool operator<(const NaptEntryValue& other) const
     {
@@ -100,6 +105,7 @@ struct TwiceNatEntryValue
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
     bool           addedToHw;          // Boolean to represent added to hardware
+    time_t         hitBitQueryTime;    // Timestamp in secs when the hit bits are queried next
 
     bool operator<(const TwiceNatEntryValue& other) const
     {
@@ -131,6 +137,7 @@ struct TwiceNaptEntryValue
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
     bool           addedToHw;          // Boolean to represent added to hardware
+    time_t         hitBitQueryTime;    // Timestamp in secs when the hit bits are queried next
 
     bool operator<(const TwiceNaptEntryValue& other) const
     {
@@ -153,6 +160,21 @@ typedef std::map<TwiceNatEntryKey, TwiceNatEntryValue> TwiceNatEntry;
 
 typedef std::map<TwiceNaptEntryKey, TwiceNaptEntryValue> TwiceNaptEntry;
 
+/* Dynamic entries ordered by the time their hit bits are queried next.
+ * Rescheduling an entry leaves its previous slot stale, such slots are
+ * recognized by the hitBitQueryTime of the entry and dropped when due.
+ */
+template <typename Key>
+using NatAgingSchedule = std::multimap<time_t, Key>;
+
+/* Position of the round robin counter query in one of the entry tables */
+template <typename Key>
+struct NatQueryCursor
+{
+    bool           valid = false;      // False when the next walk starts from the beginning
+    Key            key;                // Last key queried
+};
+
 /* Cache of DNAT entries that are dependent on the 
  * nexthop resolution of the translated destination ip address.
  */
@@ -219,6 +241,15 @@ private:
     IpAddress               nullIpv4Addr;
     DnatPoolEntry           m_dnatPoolEntries;
 
+    NatAgingSchedule<IpAddress>          m_natAgingSchedule;
+    NatAgingSchedule<NaptEntryKey>       m_naptAgingSchedule;
+    NatAgingSchedule<TwiceNatEntryKey>   m_twiceNatAgingSchedule;
+    NatAgingSchedule<TwiceNaptEntryKey>  m_twiceNaptAgingSchedule;
+    NatQueryCursor<IpAddress>            m_natQueryCursor;
+    NatQueryCursor<NaptEntryKey>         m_naptQueryCursor;
+    NatQueryCursor<TwiceNatEntryKey>     m_twiceNatQueryCursor;
+    NatQueryCursor<TwiceNaptEntryKey>    m_twiceNaptQueryCursor;
+
     std::shared_ptr<NotificationProducer> setTimeoutNotifier;
 
     /* DNAT/DNAPT entry is cached, to delete and re-add it whenever the direct NextHop (connected neighbor)
@@ -303,6 +334,12 @@ private:
     void clearCounters(void);
     void queryCounters(void);
     void queryHitBits(void);
+    time_t getHitBitQueryTime(time_t now, time_t activeTime, int entryTimeout, bool active);
+    void scheduleHitBitQuery(const IpAddress &ipAddr, time_t now);
+    void scheduleHitBitQuery(const NaptEntryKey &key, time_t now);
+    void scheduleHitBitQuery(const TwiceNatEntryKey &key, time_t now);
+    void scheduleHitBitQuery(const TwiceNaptEntryKey &key, time_t now);
+    void rescheduleAllHitBitQueries(void);
     bool isNatEnabled(void);
     bool getNatCounters(const NatEntry::iterator &iter);
     bool getTwiceNatCounters(const TwiceNatEntry::iterator &iter);
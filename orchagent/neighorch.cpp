@@ -23,12 +23,17 @@ extern string gMySwitchType;
 
 const int neighorch_pri = 30;
 
+/* A linecard is converged once none of its remote neighbors were programmed for this long */
+#define VOQ_NEIGH_CONVERGENCE_QUIESCENCE_SEC 5
+
 NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch, FdbOrch *fdbOrch, PortsOrch *portsOrch, DBConnector *chassisAppDb) :
         Orch(appDb, tableName, neighorch_pri),
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        gNeighBulker(sai_neighbor_api),
+        gNextHopBulker(sai_next_hop_api, gSwitchId)
 {
     SWSS_LOG_ENTER();
 
@@ -39,12 +44,20 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         //Add subscriber to process VOQ system neigh
         tableName = CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME;
         Orch::addExecutor(new Consumer(new SubscriberStateTable(chassisAppDb, tableName, TableConsumable::DEFAULT_POP_BATCH_SIZE, 0), this, tableName));
-        m_tableVoqSystemNeighTable = unique_ptr<Table>(new Table(chassisAppDb, CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME));
+        m_chassisAppPipeline = make_unique<RedisPipeline>(chassisAppDb);
+        m_tableVoqSystemNeighTable = unique_ptr<Table>(new Table(m_chassisAppPipeline.get(), CHASSIS_APP_SYSTEM_NEIGH_TABLE_NAME, true));
 
         //STATE DB connection for setting state of the remote neighbor SAI programming
         unique_ptr<DBConnector> stateDb;
         stateDb = make_unique<DBConnector>("STATE_DB", 0);
-        m_stateSystemNeighTable = unique_ptr<Table>(new Table(stateDb.get(), STATE_SYSTEM_NEIGH_TABLE_NAME));
+        m_stateDbPipeline = make_unique<RedisPipeline>(stateDb.get());
+        m_stateSystemNeighTable = unique_ptr<Table>(new Table(m_stateDbPipeline.get(), STATE_SYSTEM_NEIGH_TABLE_NAME, true));
+        m_stateSystemNeighConvergenceTable = unique_ptr<Table>(new Table(m_stateDbPipeline.get(), STATE_SYSTEM_NEIGH_CONVERGENCE_TABLE_NAME, true));
+
+        auto interv = timespec { .tv_sec = VOQ_NEIGH_CONVERGENCE_QUIESCENCE_SEC, .tv_nsec = 0 };
+        m_voqNeighConvergenceTimer = new SelectableTimer(interv);
+        auto executor = new ExecutableTimer(m_voqNeighConvergenceTimer, this, "VOQ_NEIGH_CONVERGENCE_TIMER");
+        Orch::addExecutor(executor);
     }
 }
 
@@ -220,6 +233,14 @@ bool NeighOrch::addNextHop(NextHopKey nexthop)
         return false;
     }
 
+    addNextHopPost(nexthop, next_hop_id, p);
+    return true;
+}
+
+void NeighOrch::addNextHopPost(const NextHopKey &nexthop, sai_object_id_t next_hop_id, const Port &p)
+{
+    SWSS_LOG_ENTER();
+
     SWSS_LOG_NOTICE("Created next hop %s", nexthop.to_string().c_str());
 
     NextHopEntry next_hop_entry;
@@ -256,7 +277,6 @@ bool NeighOrch::addNextHop(NextHopKey nexthop)
                 nexthop.to_string().c_str());
         }
     }
-    return true;
 }
 
 bool NeighOrch::setNextHopFlag(const NextHopKey &nexthop, const uint32_t nh_flag)
@@ -495,6 +515,34 @@ bool NeighOrch::getNeighborEntry(const IpAddress &ipAddress, NeighborEntry &neig
     return getNeighborEntry(nexthop, neighborEntry, macAddress);
 }
 
+const Port *NeighOrch::getCachedPort(const string &alias)
+{
+    auto found = m_portCache.find(alias);
+    if (found != m_portCache.end())
+    {
+        return &found->second;
+    }
+
+    Port p;
+    if (!gPortsOrch->getPort(alias, p))
+    {
+        return nullptr;
+    }
+
+    return &m_portCache.emplace(alias, p).first->second;
+}
+
+void NeighOrch::doTask()
+{
+    Orch::doTask();
+
+    if (m_chassisAppPipeline)
+    {
+        m_chassisAppPipeline->flush();
+        m_stateDbPipeline->flush();
+    }
+}
+
 void NeighOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -511,10 +559,24 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    /*
+     * Port objects are looked up once per interface for this pass; a burst of
+     * neighbors is usually learnt on a handful of VLAN interfaces.
+     */
+    m_portCache.clear();
+
+    unparkConsumer(consumer);
+    m_crmAdmitted.clear();
+    m_crmExhausted.clear();
+    m_crmParkedCount = 0;
+
+    // New neighbors are created with the neighbor and next hop bulkers
+    map<string, NeighborBulkContext> toBulk;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        const KeyOpFieldsValuesTuple &t = it->second;
 
         string key = kfvKey(t);
         string op = kfvOp(t);
@@ -556,15 +618,15 @@ void NeighOrch::doTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            const Port *p = getCachedPort(alias);
+            if (!p)
             {
                 SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
                 it++;
                 continue;
             }
 
-            if (!p.m_rif_id)
+            if (!p->m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
                 it++;
@@ -579,6 +641,44 @@ void NeighOrch::doTask(Consumer &consumer)
                     mac_address = MacAddress(fvValue(*i));
             }
 
+            if (isBulkNeighborAdd(neighbor_entry))
+            {
+                if (!admitNeighbor(neighbor_entry, true))
+                {
+                    it++;
+                    continue;
+                }
+
+                auto rc = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple());
+
+                auto& ctx = rc.first->second;
+                if (!rc.second)
+                {
+                    ctx.clear();
+                }
+
+                ctx.neighbor_entry = neighbor_entry;
+                ctx.mac = mac_address;
+
+                if (!addNeighbor(ctx))
+                {
+                    toBulk.erase(rc.first);
+                }
+
+                /* Result is handled after the bulkers are flushed */
+                it++;
+                continue;
+            }
+
+            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
+                    && !admitNeighbor(neighbor_entry, false))
+            {
+                it++;
+                continue;
+            }
+
             if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
                     || m_syncdNeighbors[neighbor_entry].mac != mac_address)
             {
@@ -632,6 +732,311 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (toBulk.empty())
+    {
+        parkOnCrmExhaustion(consumer);
+        m_portCache.clear();
+        return;
+    }
+
+    /*
+     * Neighbor entries have to exist before their next hops can be created,
+     * so the two object types are flushed one after the other.
+     */
+    gNeighBulker.flush();
+
+    for (auto& i: toBulk)
+    {
+        addNextHop(i.second);
+    }
+
+    gNextHopBulker.flush();
+
+    // Go through the bulker results
+    NeighborBulkUpdate bulk_update;
+    auto it_prev = consumer.m_toSync.begin();
+    while (it_prev != consumer.m_toSync.end())
+    {
+        if (kfvOp(it_prev->second) != SET_COMMAND)
+        {
+            it_prev++;
+            continue;
+        }
+
+        auto found = toBulk.find(it_prev->first);
+        if (found == toBulk.end())
+        {
+            it_prev++;
+            continue;
+        }
+
+        if (!addNeighborPost(found->second, bulk_update))
+        {
+            it_prev++;
+            continue;
+        }
+
+        string key = it_prev->first;
+        it_prev = consumer.m_toSync.erase(it_prev);
+
+        /* Remove remaining DEL operation in m_toSync for the same neighbor, see above */
+        auto rit = make_reverse_iterator(it_prev);
+        while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+        {
+            consumer.m_toSync.erase(next(rit).base());
+            SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+        }
+    }
+
+    if (!bulk_update.updates.empty())
+    {
+        notify(SUBJECT_TYPE_NEIGH_BULK_CHANGE, static_cast<void *>(&bulk_update));
+    }
+
+    parkOnCrmExhaustion(consumer);
+    m_portCache.clear();
+}
+
+/*
+ * A new neighbor takes a neighbor and a next hop entry, check the predicted
+ * CRM availability of both before it is programmed. Entries of the current
+ * bulk are only accounted in CRM once the bulk is flushed.
+ */
+bool NeighOrch::admitNeighbor(const NeighborEntry &neighborEntry, bool bulk)
+{
+    SWSS_LOG_ENTER();
+
+    bool isV4 = neighborEntry.ip_address.isV4();
+    const CrmResourceType resources[] = {
+        isV4 ? CrmResourceType::CRM_IPV4_NEIGHBOR : CrmResourceType::CRM_IPV6_NEIGHBOR,
+        isV4 ? CrmResourceType::CRM_IPV4_NEXTHOP : CrmResourceType::CRM_IPV6_NEXTHOP,
+    };
+
+    for (auto resource : resources)
+    {
+        uint32_t pending = bulk ? m_crmAdmitted[resource] : 0;
+        if (!gCrmOrch->isCrmResAvailable(resource, pending + 1))
+        {
+            SWSS_LOG_INFO("No resources left for neighbor %s on %s",
+                    neighborEntry.ip_address.to_string().c_str(), neighborEntry.alias.c_str());
+            m_crmExhausted.insert(resource);
+            m_crmParkedCount++;
+            return false;
+        }
+    }
+
+    if (bulk)
+    {
+        for (auto resource : resources)
+        {
+            m_crmAdmitted[resource]++;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * If all the pending neighbors are waiting for free entries, don't retry
+ * them on every loop, but only once some entries are freed.
+ */
+void NeighOrch::parkOnCrmExhaustion(Consumer &consumer)
+{
+    if (m_crmExhausted.empty() || m_crmParkedCount != consumer.m_toSync.size())
+    {
+        return;
+    }
+
+    SWSS_LOG_NOTICE("%zu neighbors are waiting for neighbor resources", m_crmParkedCount);
+
+    auto exhausted = m_crmExhausted;
+    parkConsumer(consumer, [exhausted]() { return gCrmOrch->isAnyCrmResAvailable(exhausted); });
+}
+
+/*
+ * Only brand new neighbors which go straight to hardware take the bulk path.
+ * MAC updates, neighbors on standby mux ports and local VOQ neighbors (which
+ * need the encap index and the CHASSIS_APP_DB sync) are programmed one by one.
+ * Remote system neighbors are bulked by doVoqSystemNeighTask.
+ */
+bool NeighOrch::isBulkNeighborAdd(const NeighborEntry &neighborEntry)
+{
+    if (gMySwitchType == "voq")
+    {
+        return false;
+    }
+
+    if (m_syncdNeighbors.find(neighborEntry) != m_syncdNeighbors.end())
+    {
+        return false;
+    }
+
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+    return mux_orch->isNeighborActive(neighborEntry.ip_address, neighborEntry.alias);
+}
+
+bool NeighOrch::addNeighbor(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const string &alias = ctx.neighbor_entry.alias;
+
+    sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(alias);
+    if (rif_id == SAI_NULL_OBJECT_ID)
+    {
+        SWSS_LOG_INFO("Failed to get rif_id for %s", alias.c_str());
+        return false;
+    }
+
+    sai_neighbor_entry_t &neighbor_entry = ctx.sai_neighbor_entry;
+    neighbor_entry.rif_id = rif_id;
+    neighbor_entry.switch_id = gSwitchId;
+    copy(neighbor_entry.ip_address, ctx.neighbor_entry.ip_address);
+
+    vector<sai_attribute_t> neighbor_attrs;
+    sai_attribute_t neighbor_attr;
+
+    neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+    memcpy(neighbor_attr.value.mac, ctx.mac.getMac(), 6);
+    neighbor_attrs.push_back(neighbor_attr);
+
+    if (ctx.encap_index)
+    {
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_ENCAP_INDEX;
+        neighbor_attr.value.u32 = ctx.encap_index;
+        neighbor_attrs.push_back(neighbor_attr);
+
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_ENCAP_IMPOSE_INDEX;
+        neighbor_attr.value.booldata = true;
+        neighbor_attrs.push_back(neighbor_attr);
+
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_IS_LOCAL;
+        neighbor_attr.value.booldata = false;
+        neighbor_attrs.push_back(neighbor_attr);
+    }
+
+    gNeighBulker.create_entry(&ctx.neighbor_status, &neighbor_entry,
+                              (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
+
+    return true;
+}
+
+void NeighOrch::addNextHop(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctx.neighbor_status != SAI_STATUS_SUCCESS)
+    {
+        return;
+    }
+
+    const string &alias = ctx.neighbor_entry.alias;
+
+    m_intfsOrch->increaseRouterIntfsRefCount(alias);
+
+    if (ctx.sai_neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+    }
+    else
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+    }
+
+    vector<sai_attribute_t> next_hop_attrs;
+    sai_attribute_t next_hop_attr;
+
+    next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+    next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+    next_hop_attrs.push_back(next_hop_attr);
+
+    next_hop_attr.id = SAI_NEXT_HOP_ATTR_IP;
+    copy(next_hop_attr.value.ipaddr, ctx.neighbor_entry.ip_address);
+    next_hop_attrs.push_back(next_hop_attr);
+
+    /* Next hops of remote system port neighbors are on the inband interface */
+    next_hop_attr.id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+    next_hop_attr.value.oid = ctx.next_hop_alias.empty() ? ctx.sai_neighbor_entry.rif_id :
+                                  m_intfsOrch->getRouterIntfsId(ctx.next_hop_alias);
+    next_hop_attrs.push_back(next_hop_attr);
+
+    gNextHopBulker.create_entry(&ctx.next_hop_id, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+}
+
+bool NeighOrch::addNeighborPost(const NeighborBulkContext& ctx, NeighborBulkUpdate &update)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+    const string &alias = neighborEntry.alias;
+    const MacAddress &macAddress = ctx.mac;
+
+    sai_status_t status = ctx.neighbor_status;
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
+        {
+            SWSS_LOG_ERROR("Entry exists: neighbor %s on %s, rv:%d",
+                       macAddress.to_string().c_str(), alias.c_str(), status);
+            /* Returning True so as to skip retry */
+            return true;
+        }
+
+        SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                   macAddress.to_string().c_str(), alias.c_str(), status);
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Created neighbor ip %s, %s on %s", neighborEntry.ip_address.to_string().c_str(),
+            macAddress.to_string().c_str(), alias.c_str());
+
+    NextHopKey nexthop(neighborEntry.ip_address, ctx.next_hop_alias.empty() ? alias : ctx.next_hop_alias);
+
+    const Port *p = getCachedPort(alias);
+    Port parent;
+    if (p && p->m_type == Port::SUBPORT)
+    {
+        p = gPortsOrch->getPort(p->m_parent_port_id, parent) ? &parent : nullptr;
+    }
+
+    if (ctx.next_hop_id == SAI_NULL_OBJECT_ID || !p)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop %s", nexthop.to_string().c_str());
+
+        if (ctx.next_hop_id != SAI_NULL_OBJECT_ID)
+        {
+            sai_next_hop_api->remove_next_hop(ctx.next_hop_id);
+        }
+
+        status = sai_neighbor_api->remove_neighbor_entry(&ctx.sai_neighbor_entry);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                           macAddress.to_string().c_str(), alias.c_str(), status);
+            return false;
+        }
+        m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+
+        if (ctx.sai_neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        return false;
+    }
+
+    addNextHopPost(nexthop, ctx.next_hop_id, *p);
+
+    m_syncdNeighbors[neighborEntry] = { macAddress, true };
+
+    update.updates.push_back({ neighborEntry, macAddress, true });
+
+    return true;
 }
 
 bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress)
@@ -902,6 +1307,236 @@ bool NeighOrch::disableNeighbor(const NeighborEntry& neighborEntry)
     return removeNeighbor(neighborEntry, true);
 }
 
+/*
+ * Mux switchovers enable or disable all the neighbors of a port at once,
+ * their neighbor and next hop entries go through the bulkers. VOQ neighbors
+ * are handled one by one, see isBulkNeighborAdd.
+ */
+bool NeighOrch::enableNeighbors(const vector<NeighborEntry>& neighborEntries)
+{
+    SWSS_LOG_ENTER();
+
+    bool success = true;
+    map<NeighborEntry, NeighborBulkContext> toBulk;
+
+    for (const auto &neighborEntry : neighborEntries)
+    {
+        if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
+        {
+            SWSS_LOG_INFO("Neighbor %s not found", neighborEntry.ip_address.to_string().c_str());
+            continue;
+        }
+
+        if (isHwConfigured(neighborEntry))
+        {
+            SWSS_LOG_INFO("Neighbor %s is already programmed to HW", neighborEntry.ip_address.to_string().c_str());
+            continue;
+        }
+
+        if (gMySwitchType == "voq")
+        {
+            success = enableNeighbor(neighborEntry) && success;
+            continue;
+        }
+
+        auto rc = toBulk.emplace(std::piecewise_construct,
+                std::forward_as_tuple(neighborEntry),
+                std::forward_as_tuple());
+
+        auto& ctx = rc.first->second;
+        ctx.neighbor_entry = neighborEntry;
+        ctx.mac = m_syncdNeighbors[neighborEntry].mac;
+
+        if (!addNeighbor(ctx))
+        {
+            toBulk.erase(rc.first);
+            success = false;
+        }
+    }
+
+    if (toBulk.empty())
+    {
+        return success;
+    }
+
+    SWSS_LOG_NOTICE("Neighbor enable request for %zu neighbors", toBulk.size());
+
+    gNeighBulker.flush();
+
+    for (auto& i: toBulk)
+    {
+        addNextHop(i.second);
+    }
+
+    gNextHopBulker.flush();
+
+    NeighborBulkUpdate bulk_update;
+    for (auto& i: toBulk)
+    {
+        if (!addNeighborPost(i.second, bulk_update))
+        {
+            success = false;
+        }
+    }
+
+    if (!bulk_update.updates.empty())
+    {
+        notify(SUBJECT_TYPE_NEIGH_BULK_CHANGE, static_cast<void *>(&bulk_update));
+    }
+
+    m_portCache.clear();
+
+    return success;
+}
+
+bool NeighOrch::disableNeighbors(const vector<NeighborEntry>& neighborEntries)
+{
+    SWSS_LOG_ENTER();
+
+    struct NeighborRemoveContext
+    {
+        NeighborEntry           neighbor_entry;
+        sai_neighbor_entry_t    sai_neighbor_entry;
+        sai_status_t            next_hop_status;
+        sai_status_t            neighbor_status;
+    };
+
+    bool success = true;
+    vector<NeighborRemoveContext> toBulk;
+    /* The bulkers keep pointers to the statuses */
+    toBulk.reserve(neighborEntries.size());
+
+    for (const auto &neighborEntry : neighborEntries)
+    {
+        if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
+        {
+            SWSS_LOG_INFO("Neighbor %s not found", neighborEntry.ip_address.to_string().c_str());
+            continue;
+        }
+
+        if (!isHwConfigured(neighborEntry))
+        {
+            SWSS_LOG_INFO("Neighbor %s is not programmed to HW", neighborEntry.ip_address.to_string().c_str());
+            continue;
+        }
+
+        if (gMySwitchType == "voq")
+        {
+            success = disableNeighbor(neighborEntry) && success;
+            continue;
+        }
+
+        NextHopKey nexthop(neighborEntry.ip_address, neighborEntry.alias);
+        if (m_syncdNextHops.at(nexthop).ref_count > 0)
+        {
+            SWSS_LOG_INFO("Failed to remove still referenced neighbor %s on %s",
+                          m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), neighborEntry.alias.c_str());
+            success = false;
+            continue;
+        }
+
+        gFgNhgOrch->invalidNextHopInNextHopGroup(nexthop);
+
+        toBulk.emplace_back();
+        auto &ctx = toBulk.back();
+        ctx.neighbor_entry = neighborEntry;
+        ctx.sai_neighbor_entry.rif_id = m_intfsOrch->getRouterIntfsId(neighborEntry.alias);
+        ctx.sai_neighbor_entry.switch_id = gSwitchId;
+        copy(ctx.sai_neighbor_entry.ip_address, neighborEntry.ip_address);
+        ctx.neighbor_status = SAI_STATUS_NOT_EXECUTED;
+
+        gNextHopBulker.remove_entry(&ctx.next_hop_status, m_syncdNextHops.at(nexthop).next_hop_id);
+    }
+
+    if (toBulk.empty())
+    {
+        return success;
+    }
+
+    SWSS_LOG_NOTICE("Neighbor disable request for %zu neighbors", toBulk.size());
+
+    gNextHopBulker.flush();
+
+    for (auto &ctx : toBulk)
+    {
+        NextHopKey nexthop(ctx.neighbor_entry.ip_address, ctx.neighbor_entry.alias);
+
+        /* Same as removeNextHop, a next hop which doesn't exist is removed from the cache */
+        if ((ctx.next_hop_status != SAI_STATUS_SUCCESS) &&
+            (ctx.next_hop_status != SAI_STATUS_ITEM_NOT_FOUND))
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop %s, rv:%d",
+                            nexthop.to_string().c_str(), ctx.next_hop_status);
+            success = false;
+            continue;
+        }
+        else if (ctx.next_hop_status == SAI_STATUS_SUCCESS)
+        {
+            if (nexthop.ip_address.isV4())
+            {
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+            }
+            else
+            {
+                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
+            }
+        }
+
+        m_syncdNextHops.erase(nexthop);
+        m_intfsOrch->decreaseRouterIntfsRefCount(nexthop.alias);
+
+        gNeighBulker.remove_entry(&ctx.neighbor_status, &ctx.sai_neighbor_entry);
+    }
+
+    gNeighBulker.flush();
+
+    for (auto &ctx : toBulk)
+    {
+        const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+        const string &alias = neighborEntry.alias;
+
+        if (ctx.neighbor_status == SAI_STATUS_NOT_EXECUTED)
+        {
+            continue;
+        }
+
+        if (ctx.neighbor_status != SAI_STATUS_SUCCESS)
+        {
+            if (ctx.neighbor_status == SAI_STATUS_ITEM_NOT_FOUND)
+            {
+                SWSS_LOG_ERROR("Failed to locate neigbor %s on %s, rv:%d",
+                        m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str(), ctx.neighbor_status);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                        m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str(), ctx.neighbor_status);
+                success = false;
+            }
+            continue;
+        }
+
+        if (ctx.sai_neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+
+        SWSS_LOG_NOTICE("Removed neighbor %s on %s",
+                m_syncdNeighbors[neighborEntry].mac.to_string().c_str(), alias.c_str());
+
+        /* Disabled neighbors stay in the cache */
+        m_syncdNeighbors[neighborEntry].hw_configured = false;
+    }
+
+    return success;
+}
+
 sai_object_id_t NeighOrch::addTunnelNextHop(const NextHopKey& nh)
 {
     SWSS_LOG_ENTER();
@@ -983,6 +1618,30 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
         return;
     }
 
+    m_portCache.clear();
+    m_crmAdmitted.clear();
+    m_crmExhausted.clear();
+    m_crmParkedCount = 0;
+
+    //Neighbor successfully added to SAI. Set STATE DB to signal kernel programming by neighbor manager
+    auto setStateSystemNeigh = [&](const string &state_key, MacAddress mac_address) {
+        //If the inband interface type is not VLAN, same MAC can be used for the inband interface for
+        //kernel programming.
+        if(ibif.m_type != Port::VLAN)
+        {
+            mac_address = gMacAddress;
+        }
+        vector<FieldValueTuple> fvVector;
+        FieldValueTuple mac("neigh", mac_address.to_string());
+        fvVector.push_back(mac);
+        m_stateSystemNeighTable->set(state_key, fvVector);
+    };
+
+    // New remote neighbors are created with the neighbor and next hop bulkers
+    map<string, NeighborBulkContext> toBulk;
+    // Linecards (switch ids) whose remote neighbors are still waiting to be programmed
+    set<uint32_t> pendingSwitches;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -1015,17 +1674,30 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            const Port *p = getCachedPort(alias);
+            if (!p)
             {
                 SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
                 it++;
                 continue;
             }
 
-            if (!p.m_rif_id)
+            uint32_t switch_id = p->m_system_port_info.switch_id;
+            auto conv = m_voqNeighConvergence.emplace(switch_id, VoqNeighConvergence());
+            if (conv.second)
+            {
+                conv.first->second.start = std::chrono::steady_clock::now();
+                conv.first->second.last = conv.first->second.start;
+                if (m_voqNeighConvergence.size() == 1)
+                {
+                    m_voqNeighConvergenceTimer->start();
+                }
+            }
+
+            if (!p->m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
+                pendingSwitches.insert(switch_id);
                 it++;
                 continue;
             }
@@ -1048,34 +1720,62 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             {
                 //Encap index is not available yet. Since this is remote neighbor, we need to wait till
                 //Encap index is made available either by dynamic syncing or by static config
+                pendingSwitches.insert(switch_id);
                 it++;
                 continue;
             }
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end() ||
-                    m_syncdNeighbors[neighbor_entry].mac != mac_address)
+            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end())
             {
-                //Add neigh to SAI
+                if (!admitNeighbor(neighbor_entry, true))
+                {
+                    pendingSwitches.insert(switch_id);
+                    it++;
+                    continue;
+                }
+
+                //New neighbor, the encap index of the entry is used as it is
+                auto rc = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple());
+
+                auto& ctx = rc.first->second;
+                if (!rc.second)
+                {
+                    ctx.clear();
+                }
+
+                ctx.neighbor_entry = neighbor_entry;
+                ctx.mac = mac_address;
+                ctx.encap_index = encap_index;
+                ctx.next_hop_alias = ibif.m_alias;
+
+                if (!addNeighbor(ctx))
+                {
+                    toBulk.erase(rc.first);
+                    pendingSwitches.insert(switch_id);
+                }
+
+                /* Result is handled after the bulkers are flushed */
+                it++;
+                continue;
+            }
+
+            if (m_syncdNeighbors[neighbor_entry].mac != mac_address)
+            {
+                //Update neigh in SAI
                 if (addNeighbor(neighbor_entry, mac_address))
                 {
-                    //neigh successfully added to SAI. Set STATE DB to signal kernel programming by neighbor manager
-
-                    //If the inband interface type is not VLAN, same MAC can be used for the inband interface for
-                    //kernel programming.
-                    if(ibif.m_type != Port::VLAN)
-                    {
-                        mac_address = gMacAddress;
-                    }
-                    vector<FieldValueTuple> fvVector;
-                    FieldValueTuple mac("neigh", mac_address.to_string());
-                    fvVector.push_back(mac);
-                    m_stateSystemNeighTable->set(state_key, fvVector);
+                    setStateSystemNeigh(state_key, mac_address);
+                    m_voqNeighConvergence[switch_id].neighbors++;
+                    m_voqNeighConvergence[switch_id].last = std::chrono::steady_clock::now();
 
                     it = consumer.m_toSync.erase(it);
                 }
                 else
                 {
                     SWSS_LOG_ERROR("Failed to add voq neighbor %s to SAI", kfvKey(t).c_str());
+                    pendingSwitches.insert(switch_id);
                     it++;
                 }
             }
@@ -1114,6 +1814,126 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (!toBulk.empty())
+    {
+        gNeighBulker.flush();
+
+        for (auto& i: toBulk)
+        {
+            addNextHop(i.second);
+        }
+
+        gNextHopBulker.flush();
+
+        // Go through the bulker results
+        NeighborBulkUpdate bulk_update;
+        it = consumer.m_toSync.begin();
+        while (it != consumer.m_toSync.end())
+        {
+            if (kfvOp(it->second) != SET_COMMAND)
+            {
+                it++;
+                continue;
+            }
+
+            auto found = toBulk.find(it->first);
+            if (found == toBulk.end())
+            {
+                it++;
+                continue;
+            }
+
+            const NeighborBulkContext &ctx = found->second;
+            uint32_t switch_id = getCachedPort(ctx.neighbor_entry.alias)->m_system_port_info.switch_id;
+
+            if (!addNeighborPost(ctx, bulk_update))
+            {
+                SWSS_LOG_ERROR("Failed to add voq neighbor %s to SAI", it->first.c_str());
+                pendingSwitches.insert(switch_id);
+                it++;
+                continue;
+            }
+
+            setStateSystemNeigh(ctx.neighbor_entry.alias + state_db_key_delimiter +
+                                ctx.neighbor_entry.ip_address.to_string(), ctx.mac);
+            m_voqNeighConvergence[switch_id].neighbors++;
+            m_voqNeighConvergence[switch_id].last = std::chrono::steady_clock::now();
+
+            it = consumer.m_toSync.erase(it);
+        }
+
+        if (!bulk_update.updates.empty())
+        {
+            notify(SUBJECT_TYPE_NEIGH_BULK_CHANGE, static_cast<void *>(&bulk_update));
+        }
+    }
+
+    updateVoqNeighConvergence(pendingSwitches);
+    m_portCache.clear();
+}
+
+void NeighOrch::updateVoqNeighConvergence(const set<uint32_t> &pendingSwitches)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &conv : m_voqNeighConvergence)
+    {
+        conv.second.pending = (pendingSwitches.find(conv.first) != pendingSwitches.end());
+    }
+
+    publishVoqNeighConvergence();
+}
+
+/*
+ * A linecard has converged once none of its remote neighbors are pending and no
+ * new one was programmed for a quiescence interval. The time from its first
+ * neighbor being received to its last one being programmed is then published
+ * to STATE_DB.
+ */
+void NeighOrch::publishVoqNeighConvergence()
+{
+    SWSS_LOG_ENTER();
+
+    auto now = std::chrono::steady_clock::now();
+
+    auto it = m_voqNeighConvergence.begin();
+    while (it != m_voqNeighConvergence.end())
+    {
+        if (it->second.pending ||
+            now - it->second.last < std::chrono::seconds(VOQ_NEIGH_CONVERGENCE_QUIESCENCE_SEC))
+        {
+            it++;
+            continue;
+        }
+
+        if (it->second.neighbors)
+        {
+            int64_t duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(it->second.last - it->second.start).count();
+
+            SWSS_LOG_NOTICE("Programmed %u remote neighbors of switch %u in %" PRId64 " ms",
+                            it->second.neighbors, it->first, duration_ms);
+
+            vector<FieldValueTuple> fvVector;
+            fvVector.emplace_back("neighbors", to_string(it->second.neighbors));
+            fvVector.emplace_back("convergence_time_ms", to_string(duration_ms));
+            m_stateSystemNeighConvergenceTable->set(to_string(it->first), fvVector);
+        }
+
+        it = m_voqNeighConvergence.erase(it);
+    }
+
+    if (m_voqNeighConvergence.empty())
+    {
+        m_voqNeighConvergenceTimer->stop();
+    }
+}
+
+void NeighOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    publishVoqNeighConvergence();
 }
 
 bool NeighOrch::addInbandNeighbor(string alias, IpAddress ip_address)
@@ -3,17 +3,24 @@
 
 #include "orch.h"
 #include "observer.h"
+#include "bulker.h"
 #include "portsorch.h"
 #include "intfsorch.h"
 #include "fdborch.h"
+#include "crmorch.h"
 
 #include "ipaddress.h"
 #include "nexthopkey.h"
 #include "producerstatetable.h"
 #include "schema.h"
+#include "timer.h"
+
+#include <chrono>
 
 #define NHFLAGS_IFDOWN                  0x1 // nexthop's outbound i/f is down
 
+#define STATE_SYSTEM_NEIGH_CONVERGENCE_TABLE_NAME "SYSTEM_NEIGH_CONVERGENCE_TABLE"
+
 typedef NextHopKey NeighborEntry;
 
 struct NextHopEntry
@@ -41,6 +48,37 @@ struct NeighborUpdate
     bool add;
 };
 
+struct NeighborBulkUpdate
+{
+    vector<NeighborUpdate> updates;
+};
+
+struct NeighborBulkContext
+{
+    sai_status_t                        neighbor_status;    // Bulk neighbor status
+    sai_object_id_t                     next_hop_id;        // Bulk next hop object id
+    sai_neighbor_entry_t                sai_neighbor_entry;
+    NeighborEntry                       neighbor_entry;
+    MacAddress                          mac;
+    uint32_t                            encap_index;        // Remote system port neighbors only
+    string                              next_hop_alias;     // Inband port of remote system port neighbors
+
+    NeighborBulkContext()
+        : neighbor_status(SAI_STATUS_NOT_EXECUTED), next_hop_id(SAI_NULL_OBJECT_ID), encap_index(0)
+    {
+    }
+
+    // Disable any copy constructors
+    NeighborBulkContext(const NeighborBulkContext&) = delete;
+    NeighborBulkContext(NeighborBulkContext&&) = delete;
+
+    void clear()
+    {
+        neighbor_status = SAI_STATUS_NOT_EXECUTED;
+        next_hop_id = SAI_NULL_OBJECT_ID;
+    }
+};
+
 class NeighOrch : public Orch, public Subject, public Observer
 {
 public:
@@ -62,6 +100,8 @@ public:
 
     bool enableNeighbor(const NeighborEntry&);
     bool disableNeighbor(const NeighborEntry&);
+    bool enableNeighbors(const vector<NeighborEntry>&);
+    bool disableNeighbors(const vector<NeighborEntry>&);
     bool isHwConfigured(const NeighborEntry&);
 
     sai_object_id_t addTunnelNextHop(const NextHopKey&);
@@ -84,20 +124,66 @@ private:
     NeighborTable m_syncdNeighbors;
     NextHopTable m_syncdNextHops;
 
+    EntityBulker<sai_neighbor_api_t>    gNeighBulker;
+    ObjectBulker<sai_next_hop_api_t>    gNextHopBulker;
+
+    map<string, Port> m_portCache;
+    const Port *getCachedPort(const string &alias);
+
+    /*
+     * New entries admitted against the CRM prediction in the current bulk,
+     * and the resources which pending neighbors are waiting for
+     */
+    map<CrmResourceType, uint32_t> m_crmAdmitted;
+    set<CrmResourceType> m_crmExhausted;
+    size_t m_crmParkedCount = 0;
+    bool admitNeighbor(const NeighborEntry&, bool bulk);
+    void parkOnCrmExhaustion(Consumer &consumer);
+
+    void addNextHopPost(const NextHopKey &, sai_object_id_t, const Port &);
+
     bool addNeighbor(const NeighborEntry&, const MacAddress&);
     bool removeNeighbor(const NeighborEntry&, bool disable = false);
 
+    bool isBulkNeighborAdd(const NeighborEntry&);
+    bool addNeighbor(NeighborBulkContext& ctx);
+    void addNextHop(NeighborBulkContext& ctx);
+    bool addNeighborPost(const NeighborBulkContext& ctx, NeighborBulkUpdate &update);
+
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
     bool clearNextHopFlag(const NextHopKey &, const uint32_t);
 
     void processFDBFlushUpdate(const FdbFlushUpdate &);
     bool resolveNeighborEntry(const NeighborEntry &, const MacAddress &);
 
+    void doTask() override;
     void doTask(Consumer &consumer);
+    void doTask(SelectableTimer &timer);
     void doVoqSystemNeighTask(Consumer &consumer);
 
+    /*
+     * CHASSIS_APP_DB and STATE_DB writes of the system neighbors are
+     * buffered and flushed once per doTask() pass.
+     */
+    unique_ptr<RedisPipeline> m_chassisAppPipeline;
+    unique_ptr<RedisPipeline> m_stateDbPipeline;
     unique_ptr<Table> m_tableVoqSystemNeighTable;
     unique_ptr<Table> m_stateSystemNeighTable;
+    unique_ptr<Table> m_stateSystemNeighConvergenceTable;
+
+    /* Remote neighbors programmed since a linecard (switch id) started syncing */
+    struct VoqNeighConvergence
+    {
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point last;
+        uint32_t neighbors = 0;
+        bool pending = false;
+    };
+    map<uint32_t, VoqNeighConvergence> m_voqNeighConvergence;
+    SelectableTimer *m_voqNeighConvergenceTimer = nullptr;
+    void updateVoqNeighConvergence(const set<uint32_t> &pendingSwitches);
+    void publishVoqNeighConvergence();
+
     bool getSystemPortNeighEncapIndex(string &alias, IpAddress &ip, uint32_t &encap_index);
     bool addVoqEncapIndex(string &alias, IpAddress &ip, vector<sai_attribute_t> &neighbor_attrs);
     void voqSyncAddNeigh(string &alias, IpAddress &ip_address, const MacAddress &mac, sai_neighbor_entry_t &neighbor_entry);
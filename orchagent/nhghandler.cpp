@@ -92,7 +92,7 @@ void NhgHandler::doTask(Consumer& consumer)
                 * actual group when there are enough resources.
                 */
                 if ((nhg_key.getSize() > 1) &&
-                    (Nhg::getSyncedCount() >= NhgOrch::getMaxNhgCount()))
+                    NhgOrch::isNhgExhausted())
                 {
                     SWSS_LOG_WARN("Next hop group count reached it's limit.");
 
@@ -175,7 +175,7 @@ void NhgHandler::doTask(Consumer& consumer)
                  */
                 else if (nhg.isTemp() &&
                          (nhg_key.getSize() > 1) &&
-                         (Nhg::getSyncedCount() >= NhgOrch::getMaxNhgCount()))
+                         NhgOrch::isNhgExhausted())
                 {
                     /*
                      * If the group was updated in such way that the previously
@@ -5,6 +5,7 @@
 #include "switchorch.h"
 #include "vector"
 #include "portsorch.h"
+#include "crmorch.h"
 
 using namespace std;
 
@@ -16,6 +17,7 @@ extern sai_object_id_t gSwitchId;
 
 extern SwitchOrch *gSwitchOrch;
 extern PortsOrch *gPortsOrch;
+extern CrmOrch *gCrmOrch;
 
 extern sai_switch_api_t *sai_switch_api;
 
@@ -85,6 +87,18 @@ public:
     static inline unsigned getSyncedNhgCount()
                         { SWSS_LOG_ENTER(); return NhgBase::getSyncedCount(); }
 
+    /*
+     * Check if no more next hop groups can be synced, either because the
+     * switch's capacity is reached or because CRM predicts the table is full.
+     */
+    static inline bool isNhgExhausted()
+    {
+        SWSS_LOG_ENTER();
+
+        return (getSyncedNhgCount() >= m_maxNhgCount) ||
+               !gCrmOrch->isCrmResAvailable(CrmResourceType::CRM_NEXTHOP_GROUP);
+    }
+
     /* Increase the number of synced next hop groups. */
     static void incSyncedNhgCount()
     {
@@ -18,6 +18,7 @@ enum SubjectType
     SUBJECT_TYPE_PORT_CHANGE,
     SUBJECT_TYPE_PORT_OPER_STATE_CHANGE,
     SUBJECT_TYPE_FDB_FLUSH_CHANGE,
+    SUBJECT_TYPE_NEIGH_BULK_CHANGE,
 };
 
 class Observer
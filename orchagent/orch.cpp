@@ -1,6 +1,7 @@
 #include <fstream>
 #include <iostream>
 #include <inttypes.h>
+#include <algorithm>
 #include <sys/time.h>
 #include "timestamp.h"
 #include "orch.h"
@@ -299,6 +300,23 @@ bool Orch::bake()
     return true;
 }
 
+/*
+ * Split the reference content into the two tokens around its only delimiter,
+ * like tokenize() would without building the token vector.
+ */
+static bool splitReference(const string &content, char delim, string &type_name, string &object_name)
+{
+    size_t pos = content.find(delim);
+    if (pos == string::npos || pos + 1 == content.size() || content.find(delim, pos + 1) != string::npos)
+    {
+        return false;
+    }
+
+    type_name = content.substr(0, pos);
+    object_name = content.substr(pos + 1);
+    return true;
+}
+
 /*
 - Validates reference has proper format which is [table_name:object_name]
 - validates table_name exists
@@ -336,32 +354,28 @@ bool Orch::parseReference(type_map &type_maps, string &ref_in, string &type_name
         return true;
     }
     string ref_content = ref_in.substr(1, ref_in.size() - 2);
-    vector<string> tokens;
-    tokens = tokenize(ref_content, delimiter);
-    if (tokens.size() != 2)
+    string ref_type_name, ref_object_name;
+    if (!splitReference(ref_content, delimiter, ref_type_name, ref_object_name) &&
+        !splitReference(ref_content, config_db_key_delimiter, ref_type_name, ref_object_name))
     {
-        tokens = tokenize(ref_content, config_db_key_delimiter);
-        if (tokens.size() != 2)
-        {
-            SWSS_LOG_ERROR("malformed reference:%s. Must contain 2 tokens\n", ref_content.c_str());
-            return false;
-        }
+        SWSS_LOG_ERROR("malformed reference:%s. Must contain 2 tokens\n", ref_content.c_str());
+        return false;
     }
-    auto type_it = type_maps.find(tokens[0]);
+    auto type_it = type_maps.find(ref_type_name);
     if (type_it == type_maps.end())
     {
-        SWSS_LOG_ERROR("not recognized type:%s\n", tokens[0].c_str());
+        SWSS_LOG_ERROR("not recognized type:%s\n", ref_type_name.c_str());
         return false;
     }
-    auto obj_map = type_maps[tokens[0]];
-    auto obj_it = obj_map->find(tokens[1]);
+    auto obj_map = type_it->second;
+    auto obj_it = obj_map->find(ref_object_name);
     if (obj_it == obj_map->end())
     {
-        SWSS_LOG_INFO("map:%s does not contain object with name:%s\n", tokens[0].c_str(), tokens[1].c_str());
+        SWSS_LOG_INFO("map:%s does not contain object with name:%s\n", ref_type_name.c_str(), ref_object_name.c_str());
         return false;
     }
-    type_name = tokens[0];
-    object_name = tokens[1];
+    type_name = ref_type_name;
+    object_name = ref_object_name;
     SWSS_LOG_DEBUG("parsed: type_name:%s, object_name:%s", type_name.c_str(), object_name.c_str());
     return true;
 }
@@ -409,25 +423,17 @@ ref_resolve_status Orch::resolveFieldRefValue(
 }
 
 void Orch::removeMeFromObjsReferencedByMe(
-    type_map &type_maps,
-    const string &table,
-    const string &obj_name,
+    referenced_object &obj,
     const string &field,
-    const string &old_referenced_obj_name)
-{
-    vector<string> objects = tokenize(old_referenced_obj_name, list_item_delimiter);
-    for (auto &obj : objects)
-    {
-        // obj_name references token
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &ref_obj_name = tokens[1];
-        auto &old_referenced_obj = (*type_maps[referenced_table])[ref_obj_name];
-        old_referenced_obj.m_objsDependingOnMe.erase(obj_name);
-        SWSS_LOG_INFO("Obj %s.%s Field %s: Remove reference to %s %s (now %s)",
-                      table.c_str(), obj_name.c_str(), field.c_str(),
-                      referenced_table.c_str(), ref_obj_name.c_str(),
-                      to_string(old_referenced_obj.m_objsDependingOnMe.size()).c_str());
+    const vector<referenced_object *> &old_referenced_objs)
+{
+    for (auto old_referenced_obj : old_referenced_objs)
+    {
+        old_referenced_obj->m_objsDependingOnMe.erase(&obj);
+        SWSS_LOG_INFO("Obj %s.%s Field %s: Remove reference to %s %s (now %zu)",
+                      obj.m_table.c_str(), obj.m_name.c_str(), field.c_str(),
+                      old_referenced_obj->m_table.c_str(), old_referenced_obj->m_name.c_str(),
+                      old_referenced_obj->m_objsDependingOnMe.size());
     }
 }
 
@@ -439,26 +445,37 @@ void Orch::setObjectReference(
     const string &referenced_obj)
 {
     auto &obj = (*type_maps[table])[obj_name];
-    auto field_ref = obj.m_objsReferencingByMe.find(field);
-
-    if (field_ref != obj.m_objsReferencingByMe.end())
-        removeMeFromObjsReferencedByMe(type_maps, table, obj_name, field, field_ref->second);
+    obj.m_table = table;
+    obj.m_name = obj_name;
 
-    obj.m_objsReferencingByMe[field] = referenced_obj;
+    auto &referenced_objs = obj.m_objsReferencingByMe[field];
+    removeMeFromObjsReferencedByMe(obj, field, referenced_objs);
+    referenced_objs.clear();
 
     // Add the reference to the new object being referenced
     vector<string> objs = tokenize(referenced_obj, list_item_delimiter);
-    for (auto &obj : objs)
+    for (auto &ref : objs)
     {
-        auto tokens = tokenize(obj, delimiter);
-        auto &referenced_table = tokens[0];
-        auto &referenced_obj_name = tokens[1];
+        string referenced_table, referenced_obj_name;
+        size_t pos = ref.find(delimiter);
+        if (pos == string::npos)
+        {
+            SWSS_LOG_ERROR("Obj %s.%s Field %s: malformed reference %s",
+                           table.c_str(), obj_name.c_str(), field.c_str(), ref.c_str());
+            continue;
+        }
+        referenced_table = ref.substr(0, pos);
+        referenced_obj_name = ref.substr(pos + 1);
+
         auto &new_obj_being_referenced = (*type_maps[referenced_table])[referenced_obj_name];
-        new_obj_being_referenced.m_objsDependingOnMe.insert(obj_name);
-        SWSS_LOG_INFO("Obj %s.%s Field %s: Add reference to %s %s (now %s)",
+        new_obj_being_referenced.m_table = referenced_table;
+        new_obj_being_referenced.m_name = referenced_obj_name;
+        new_obj_being_referenced.m_objsDependingOnMe.insert(&obj);
+        referenced_objs.push_back(&new_obj_being_referenced);
+        SWSS_LOG_INFO("Obj %s.%s Field %s: Add reference to %s %s (now %zu)",
                       table.c_str(), obj_name.c_str(), field.c_str(),
                       referenced_table.c_str(), referenced_obj_name.c_str(),
-                      to_string(new_obj_being_referenced.m_objsDependingOnMe.size()).c_str());
+                      new_obj_being_referenced.m_objsDependingOnMe.size());
     }
 }
 
@@ -467,15 +484,31 @@ void Orch::removeObject(
     const string &table,
     const string &obj_name)
 {
-    auto &obj = (*type_maps[table])[obj_name];
+    auto &objs = *type_maps[table];
+    auto found = objs.find(obj_name);
+    if (found == objs.end())
+    {
+        return;
+    }
+
+    auto &obj = found->second;
+    for (auto &field_ref : obj.m_objsReferencingByMe)
+    {
+        removeMeFromObjsReferencedByMe(obj, field_ref.first, field_ref.second);
+    }
 
-    for (auto field_ref : obj.m_objsReferencingByMe)
+    // Objects still referencing this one drop the references to the removed node
+    for (auto dependent : obj.m_objsDependingOnMe)
     {
-        removeMeFromObjsReferencedByMe(type_maps, table, obj_name, field_ref.first, field_ref.second);
+        for (auto &field_ref : dependent->m_objsReferencingByMe)
+        {
+            auto &refs = field_ref.second;
+            refs.erase(remove(refs.begin(), refs.end(), &obj), refs.end());
+        }
     }
 
     // Update the field store
-    (*type_maps[table]).erase(obj_name);
+    objs.erase(found);
     SWSS_LOG_INFO("Obj %s:%s is removed from store", table.c_str(), obj_name.c_str());
 }
 
@@ -484,7 +517,10 @@ bool Orch::isObjectBeingReferenced(
     const string &table,
     const string &obj_name)
 {
-    return !(*type_maps[table])[obj_name].m_objsDependingOnMe.empty();
+    auto &objs = *type_maps[table];
+    auto found = objs.find(obj_name);
+
+    return found != objs.end() && !found->second.m_objsDependingOnMe.empty();
 }
 
 string Orch::objectReferenceInfo(
@@ -492,10 +528,17 @@ string Orch::objectReferenceInfo(
     const string &table,
     const string &obj_name)
 {
-    auto &objsDependingSet = (*type_maps[table])[obj_name].m_objsDependingOnMe;
-    for (auto &depObjName : objsDependingSet)
+    auto &objs = *type_maps[table];
+    auto found = objs.find(obj_name);
+    if (found == objs.end())
+    {
+        return "reference count: 0";
+    }
+
+    auto &objsDependingSet = found->second.m_objsDependingOnMe;
+    for (auto depObj : objsDependingSet)
     {
-        string hint = table + " " + obj_name + " one object: " + depObjName;
+        string hint = table + " " + obj_name + " one object: " + depObj->m_name;
         hint += " reference count: " + to_string(objsDependingSet.size());
         return hint;
     }
@@ -506,10 +549,30 @@ void Orch::doTask()
 {
     for (auto &it : m_consumerMap)
     {
+        auto parked = m_parkedConsumers.find(it.second.get());
+        if (parked != m_parkedConsumers.end())
+        {
+            if (!parked->second())
+            {
+                continue;
+            }
+            m_parkedConsumers.erase(parked);
+        }
+
         it.second->drain();
     }
 }
 
+void Orch::parkConsumer(Consumer &consumer, std::function<bool()> ready)
+{
+    m_parkedConsumers[&consumer] = ready;
+}
+
+void Orch::unparkConsumer(Consumer &consumer)
+{
+    m_parkedConsumers.erase(&consumer);
+}
+
 void Orch::dumpPendingTasks(vector<string> &ts)
 {
     for (auto &it : m_consumerMap)
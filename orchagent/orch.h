@@ -7,6 +7,7 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <functional>
 
 extern "C" {
 #include "sai.h"
@@ -54,20 +55,29 @@ typedef enum
     task_duplicated
 } task_process_status;
 
-typedef struct
-{
-    // m_objsDependingOnMe stores names (without table name) of all objects depending on the current obj
-    std::set<std::string> m_objsDependingOnMe;
-    // m_objsReferencingByMe is a map from a field of the current object's to the object names it references
-    // the object names are with table name
-    // multiple objects being referenced are separated by ','
-    std::map<std::string, std::string> m_objsReferencingByMe;
-    sai_object_id_t m_saiObjectId;
-} referenced_object;
-
-typedef std::map<std::string, referenced_object> object_reference_map;
+struct referenced_object;
+
+typedef std::unordered_map<std::string, referenced_object> object_reference_map;
 typedef std::map<std::string, object_reference_map*> type_map;
 
+/*
+ * Node of the reference graph of the objects of a type_map. The elements of
+ * an object_reference_map keep their address until they are erased, so the
+ * references are kept as node pointers and updated without any name lookup.
+ */
+struct referenced_object
+{
+    // m_objsDependingOnMe stores all objects depending on the current obj
+    std::unordered_set<referenced_object *> m_objsDependingOnMe;
+    // m_objsReferencingByMe is a map from a field of the current object's to the objects it references,
+    // the reference strings are parsed once when the field is set
+    std::map<std::string, std::vector<referenced_object *>> m_objsReferencingByMe;
+    sai_object_id_t m_saiObjectId = SAI_NULL_OBJECT_ID;
+    // Table and name of the current obj, set once it is part of a reference
+    std::string m_table;
+    std::string m_name;
+};
+
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
@@ -235,8 +245,17 @@ protected:
     /* Note: consumer will be owned by this class */
     void addExecutor(Executor* executor);
     Executor *getExecutor(std::string executorName);
+
+    /*
+     * Stop retrying the pending tasks of the consumer from doTask() until
+     * ready() returns true. New data from the consumer table is still handled.
+     */
+    void parkConsumer(Consumer &consumer, std::function<bool()> ready);
+    void unparkConsumer(Consumer &consumer);
 private:
-    void removeMeFromObjsReferencedByMe(type_map &type_maps, const std::string &table, const std::string &obj_name, const std::string &field, const std::string &old_referenced_obj_name);
+    std::map<Executor *, std::function<bool()>> m_parkedConsumers;
+
+    void removeMeFromObjsReferencedByMe(referenced_object &obj, const std::string &field, const std::vector<referenced_object *> &old_referenced_objs);
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri = default_orch_pri);
 };
 
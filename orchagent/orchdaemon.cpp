@@ -493,6 +493,7 @@ bool OrchDaemon::init()
     }
 
     m_orchList.push_back(&CounterCheckOrch::getInstance(m_configDb));
+    m_orchList.push_back(&CounterSnapshotOrch::getInstance(m_configDb));
 
     if (WarmStart::isWarmStart())
     {
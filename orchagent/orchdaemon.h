@@ -25,6 +25,7 @@
 #include "vxlanorch.h"
 #include "vnetorch.h"
 #include "countercheckorch.h"
+#include "countersnapshotorch.h"
 #include "flexcounterorch.h"
 #include "watermarkorch.h"
 #include "policerorch.h"
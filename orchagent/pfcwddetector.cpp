@@ -0,0 +1,428 @@
+#include <inttypes.h>
+#include <hiredis/hiredis.h>
+
+#include "pfcwddetector.h"
+#include "sai_serialize.h"
+#include "redisreply.h"
+#include "logger.h"
+#include "schema.h"
+
+#define PFC_WD_QUEUE_PACKETS            "SAI_QUEUE_STAT_PACKETS"
+#define PFC_WD_QUEUE_OCCUPANCY_BYTES    "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES"
+#define PFC_WD_QUEUE_PAUSE_STATUS       "SAI_QUEUE_ATTR_PAUSE_STATUS"
+#define PFC_WD_DEBUG_STORM              "DEBUG_STORM"
+
+using namespace std;
+using namespace swss;
+
+static bool parseCounter(const redisReply *element, uint64_t &value)
+{
+    if (element == nullptr || element->type != REDIS_REPLY_STRING)
+    {
+        return false;
+    }
+
+    value = strtoull(element->str, nullptr, 10);
+    return true;
+}
+
+static bool isReplyValue(const redisReply *element, const char *value)
+{
+    return element != nullptr && element->type == REDIS_REPLY_STRING && string(element->str) == value;
+}
+
+PfcWdDetector::PfcWdDetector(PfcWdDetectCriteria criteria):
+    m_criteria(criteria)
+{
+    SWSS_LOG_ENTER();
+}
+
+bool PfcWdDetector::getCriteria(const string &platform, PfcWdDetectCriteria &criteria)
+{
+    SWSS_LOG_ENTER();
+
+    static const unordered_map<string, PfcWdDetectCriteria> criteriaMap =
+    {
+        { "broadcom", PfcWdDetectCriteria::PFC_WD_CRITERIA_BROADCOM },
+        { "mellanox", PfcWdDetectCriteria::PFC_WD_CRITERIA_MELLANOX },
+        { "barefoot", PfcWdDetectCriteria::PFC_WD_CRITERIA_BAREFOOT },
+        { "innovium", PfcWdDetectCriteria::PFC_WD_CRITERIA_INNOVIUM },
+        { "nephos",   PfcWdDetectCriteria::PFC_WD_CRITERIA_NEPHOS },
+    };
+
+    auto found = criteriaMap.find(platform);
+    if (found == criteriaMap.end())
+    {
+        return false;
+    }
+
+    criteria = found->second;
+    return true;
+}
+
+void PfcWdDetector::addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+        uint32_t detectionTime, uint32_t restorationTime, bool alert)
+{
+    SWSS_LOG_ENTER();
+
+    auto found = m_queueIndex.find(queueId);
+    if (found == m_queueIndex.end())
+    {
+        found = m_queueIndex.emplace(queueId, m_queues.size()).first;
+        m_queues.emplace_back();
+    }
+
+    PfcWdQueueState &queue = m_queues[found->second];
+    queue = PfcWdQueueState();
+
+    const string prefix = string(COUNTERS_TABLE) + ":";
+    const string pfcPrefix = "SAI_PORT_STAT_PFC_" + to_string(index);
+
+    queue.queueId = queueId;
+    queue.queueKey = prefix + sai_serialize_object_id(queueId);
+    queue.portKey = prefix + sai_serialize_object_id(portId);
+    queue.pfcRxField = pfcPrefix + "_RX_PKTS";
+
+    switch (m_criteria)
+    {
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_BROADCOM:
+            queue.pfcAuxField = pfcPrefix + "_ON2OFF_RX_PKTS";
+            break;
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_MELLANOX:
+            queue.pfcAuxField = pfcPrefix + "_RX_PAUSE_DURATION_US";
+            break;
+        default:
+            queue.pfcAuxField = pfcPrefix + "_RX_PAUSE_DURATION";
+            break;
+    }
+
+    queue.detectionTime = detectionTime;
+    queue.restorationTime = restorationTime;
+    queue.detectionTimeLeft = detectionTime;
+    queue.restorationTimeLeft = restorationTime;
+    queue.alert = alert;
+}
+
+void PfcWdDetector::removeQueue(sai_object_id_t queueId)
+{
+    SWSS_LOG_ENTER();
+
+    auto found = m_queueIndex.find(queueId);
+    if (found == m_queueIndex.end())
+    {
+        return;
+    }
+
+    // Keep the array dense by moving the last queue to the freed slot
+    size_t slot = found->second;
+    m_queueIndex.erase(found);
+    if (slot != m_queues.size() - 1)
+    {
+        m_queues[slot] = std::move(m_queues.back());
+        m_queueIndex[m_queues[slot].queueId] = slot;
+    }
+    m_queues.pop_back();
+}
+
+void PfcWdDetector::setStormed(sai_object_id_t queueId, bool stormed)
+{
+    SWSS_LOG_ENTER();
+
+    auto found = m_queueIndex.find(queueId);
+    if (found == m_queueIndex.end())
+    {
+        return;
+    }
+
+    m_queues[found->second].stormed = stormed;
+}
+
+void PfcWdDetector::reset(void)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &queue : m_queues)
+    {
+        queue.detectionTimeLeft = queue.detectionTime;
+        queue.restorationTimeLeft = queue.restorationTime;
+        queue.hasQueueLast = false;
+        queue.hasPfcRxLast = false;
+        queue.hasPfcAuxLast = false;
+        queue.heldSample = false;
+    }
+}
+
+bool PfcWdDetector::poll(DBConnector *countersDb, uint32_t pollTime, vector<PfcWdDetectEvent> &events)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_queues.empty())
+    {
+        return true;
+    }
+
+    vector<PfcWdQueueSample> samples;
+    if (!readSamples(countersDb, samples))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < m_queues.size(); i++)
+    {
+        string event = evaluateQueue(m_queues[i], samples[i], pollTime);
+        if (!event.empty())
+        {
+            events.push_back({ m_queues[i].queueId, event });
+        }
+    }
+
+    return true;
+}
+
+string PfcWdDetector::evaluate(sai_object_id_t queueId, const PfcWdQueueSample &sample, uint32_t pollTime)
+{
+    SWSS_LOG_ENTER();
+
+    auto found = m_queueIndex.find(queueId);
+    if (found == m_queueIndex.end())
+    {
+        return "";
+    }
+
+    return evaluateQueue(m_queues[found->second], sample, pollTime);
+}
+
+string PfcWdDetector::evaluateQueue(PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime)
+{
+    if (!sample.valid)
+    {
+        return "";
+    }
+
+    // Storm detection keeps running on stormed queues with alert action,
+    // to report the restoration when the storm condition is gone
+    if (!queue.stormed || queue.alert)
+    {
+        return detect(queue, sample, pollTime);
+    }
+
+    return restore(queue, sample, pollTime);
+}
+
+bool PfcWdDetector::isStorm(const PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime) const
+{
+    if (sample.debugStorm)
+    {
+        return true;
+    }
+
+    bool txIdle = sample.packets == queue.packetsLast;
+    bool pfcReceived = sample.pfcRxPackets > queue.pfcRxPacketsLast;
+
+    if (sample.occupancyBytes > 0)
+    {
+        return txIdle && pfcReceived;
+    }
+
+    // Queue is paused for at least 80% of the poll interval
+    bool pausedLong = sample.pfcAux > queue.pfcAuxLast &&
+        (sample.pfcAux - queue.pfcAuxLast) * 5 > static_cast<uint64_t>(pollTime) * 4;
+
+    switch (m_criteria)
+    {
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_BROADCOM:
+            return pfcReceived && sample.pfcAux == queue.pfcAuxLast &&
+                queue.pauseStatusLast && sample.pauseStatus;
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_INNOVIUM:
+            return pfcReceived && pausedLong;
+        default:
+            return txIdle && pausedLong;
+    }
+}
+
+string PfcWdDetector::detect(PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime)
+{
+    if (m_criteria == PfcWdDetectCriteria::PFC_WD_CRITERIA_BROADCOM && !sample.hasPauseStatus)
+    {
+        return "";
+    }
+
+    string event;
+    bool isDeadlock = false;
+
+    if (queue.hasQueueLast && queue.hasPfcRxLast && queue.hasPfcAuxLast)
+    {
+        // Counters are polled by syncd independently from us, so a sample
+        // may be the one we have already seen. Do not let a single repeated
+        // sample interrupt the storm detection countdown.
+        bool repeated = sample.packets == queue.packetsLast &&
+            sample.occupancyBytes == queue.occupancyBytesLast &&
+            sample.pfcRxPackets == queue.pfcRxPacketsLast &&
+            sample.pfcAux == queue.pfcAuxLast &&
+            !sample.debugStorm;
+        if (repeated && !queue.heldSample)
+        {
+            queue.heldSample = true;
+            return "";
+        }
+        queue.heldSample = false;
+
+        if (isStorm(queue, sample, pollTime))
+        {
+            if (queue.detectionTimeLeft <= pollTime)
+            {
+                event = PFC_WD_EVENT_STORM;
+                isDeadlock = true;
+                queue.detectionTimeLeft = queue.detectionTime;
+            }
+            else
+            {
+                queue.detectionTimeLeft -= pollTime;
+            }
+        }
+        else
+        {
+            if (queue.alert && queue.stormed)
+            {
+                event = PFC_WD_EVENT_RESTORE;
+            }
+            queue.detectionTimeLeft = queue.detectionTime;
+        }
+    }
+
+    // Save values for next run
+    queue.hasQueueLast = true;
+    queue.packetsLast = sample.packets;
+    queue.occupancyBytesLast = sample.occupancyBytes;
+    queue.pauseStatusLast = sample.pauseStatus;
+
+    switch (m_criteria)
+    {
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_MELLANOX:
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_BAREFOOT:
+            // Start from scratch after the storm
+            if (isDeadlock)
+            {
+                queue.hasPfcRxLast = false;
+                queue.hasPfcAuxLast = false;
+                return event;
+            }
+            break;
+        case PfcWdDetectCriteria::PFC_WD_CRITERIA_INNOVIUM:
+            if (isDeadlock)
+            {
+                return event;
+            }
+            break;
+        default:
+            break;
+    }
+
+    queue.hasPfcRxLast = true;
+    queue.pfcRxPacketsLast = sample.pfcRxPackets;
+    queue.hasPfcAuxLast = true;
+    queue.pfcAuxLast = sample.pfcAux;
+
+    return event;
+}
+
+string PfcWdDetector::restore(PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime)
+{
+    if (queue.restorationTime == 0)
+    {
+        return "";
+    }
+
+    string event;
+
+    if (queue.hasPfcRxLast)
+    {
+        if (sample.pfcRxPackets == queue.pfcRxPacketsLast && !sample.debugStorm)
+        {
+            if (queue.restorationTimeLeft <= pollTime)
+            {
+                event = PFC_WD_EVENT_RESTORE;
+                queue.restorationTimeLeft = queue.restorationTime;
+            }
+            else
+            {
+                queue.restorationTimeLeft -= pollTime;
+            }
+        }
+        else
+        {
+            queue.restorationTimeLeft = queue.restorationTime;
+        }
+    }
+
+    // Save values for next run
+    queue.hasPfcRxLast = true;
+    queue.pfcRxPacketsLast = sample.pfcRxPackets;
+
+    return event;
+}
+
+bool PfcWdDetector::readSamples(DBConnector *countersDb, vector<PfcWdQueueSample> &samples)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = countersDb->getContext();
+
+    // Pipeline the reads of all queues, so a poll costs one round trip
+    for (const auto &queue : m_queues)
+    {
+        if (redisAppendCommand(ctx, "HMGET %s %s %s %s %s", queue.queueKey.c_str(),
+                    PFC_WD_QUEUE_PACKETS, PFC_WD_QUEUE_OCCUPANCY_BYTES,
+                    PFC_WD_QUEUE_PAUSE_STATUS, PFC_WD_DEBUG_STORM) != REDIS_OK ||
+            redisAppendCommand(ctx, "HMGET %s %s %s", queue.portKey.c_str(),
+                    queue.pfcRxField.c_str(), queue.pfcAuxField.c_str()) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to queue PFC watchdog counters read: %s", ctx->errstr);
+            return false;
+        }
+    }
+
+    samples.assign(m_queues.size(), PfcWdQueueSample());
+
+    for (size_t i = 0; i < m_queues.size(); i++)
+    {
+        redisReply *queueReplyPtr = nullptr;
+        redisReply *portReplyPtr = nullptr;
+
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&queueReplyPtr)) != REDIS_OK)
+        {
+            // The context is unusable after a read error, skip this poll interval
+            SWSS_LOG_ERROR("Failed to read PFC watchdog counters: %s", ctx->errstr);
+            return false;
+        }
+
+        RedisReply queueReply(queueReplyPtr);
+
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&portReplyPtr)) != REDIS_OK)
+        {
+            SWSS_LOG_ERROR("Failed to read PFC watchdog counters: %s", ctx->errstr);
+            return false;
+        }
+
+        RedisReply portReply(portReplyPtr);
+
+        const redisReply *q = queueReply.getContext();
+        const redisReply *p = portReply.getContext();
+        if (q->type != REDIS_REPLY_ARRAY || q->elements != 4 ||
+            p->type != REDIS_REPLY_ARRAY || p->elements != 2)
+        {
+            continue;
+        }
+
+        PfcWdQueueSample &sample = samples[i];
+        sample.valid = parseCounter(q->element[0], sample.packets) &&
+            parseCounter(q->element[1], sample.occupancyBytes) &&
+            parseCounter(p->element[0], sample.pfcRxPackets) &&
+            parseCounter(p->element[1], sample.pfcAux);
+        sample.hasPauseStatus = q->element[2] != nullptr && q->element[2]->type == REDIS_REPLY_STRING;
+        sample.pauseStatus = isReplyValue(q->element[2], "true");
+        sample.debugStorm = isReplyValue(q->element[3], "enabled");
+    }
+
+    return true;
+}
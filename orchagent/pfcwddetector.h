@@ -0,0 +1,115 @@
+#ifndef PFC_WD_DETECTOR_H
+#define PFC_WD_DETECTOR_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "dbconnector.h"
+
+extern "C" {
+#include "sai.h"
+}
+
+#define PFC_WD_EVENT_STORM              "storm"
+#define PFC_WD_EVENT_RESTORE            "restore"
+
+// Vendor specific storm criteria, same as in pfc_detect_<platform>.lua
+enum class PfcWdDetectCriteria
+{
+    PFC_WD_CRITERIA_BROADCOM,
+    PFC_WD_CRITERIA_MELLANOX,
+    PFC_WD_CRITERIA_BAREFOOT,
+    PFC_WD_CRITERIA_INNOVIUM,
+    PFC_WD_CRITERIA_NEPHOS,
+};
+
+// Counters of a lossless queue and of its priority on the port,
+// read from COUNTERS_DB in one poll
+struct PfcWdQueueSample
+{
+    bool valid = false;
+    uint64_t packets = 0;
+    uint64_t occupancyBytes = 0;
+    uint64_t pfcRxPackets = 0;
+    // PFC ON2OFF packets or PFC pause duration depending on criteria
+    uint64_t pfcAux = 0;
+    bool pauseStatus = false;
+    bool hasPauseStatus = false;
+    bool debugStorm = false;
+};
+
+struct PfcWdDetectEvent
+{
+    sai_object_id_t queueId;
+    std::string event;
+};
+
+/*
+ * In-process PFC storm detector. Evaluates the same criteria as the
+ * pfc_detect_<platform>.lua and pfc_restore.lua plugins, but keeps the
+ * previous counters in memory instead of *_last fields in COUNTERS_DB,
+ * and reads the counters of all watched queues in one pipelined batch.
+ */
+class PfcWdDetector
+{
+public:
+    PfcWdDetector(PfcWdDetectCriteria criteria);
+
+    static bool getCriteria(const std::string &platform, PfcWdDetectCriteria &criteria);
+
+    void addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+            uint32_t detectionTime, uint32_t restorationTime, bool alert);
+    void removeQueue(sai_object_id_t queueId);
+    void setStormed(sai_object_id_t queueId, bool stormed);
+    void reset(void);
+    size_t size(void) const
+    {
+        return m_queues.size();
+    }
+
+    bool poll(swss::DBConnector *countersDb, uint32_t pollTime, std::vector<PfcWdDetectEvent> &events);
+    std::string evaluate(sai_object_id_t queueId, const PfcWdQueueSample &sample, uint32_t pollTime);
+
+private:
+    struct PfcWdQueueState
+    {
+        sai_object_id_t queueId = SAI_NULL_OBJECT_ID;
+        std::string queueKey;
+        std::string portKey;
+        std::string pfcRxField;
+        std::string pfcAuxField;
+
+        // Times are in microseconds, restoration time 0 disables restoration
+        uint32_t detectionTime = 0;
+        uint32_t restorationTime = 0;
+        int64_t detectionTimeLeft = 0;
+        int64_t restorationTimeLeft = 0;
+        bool alert = false;
+        bool stormed = false;
+
+        bool hasQueueLast = false;
+        bool hasPfcRxLast = false;
+        bool hasPfcAuxLast = false;
+        bool heldSample = false;
+        uint64_t packetsLast = 0;
+        uint64_t occupancyBytesLast = 0;
+        uint64_t pfcRxPacketsLast = 0;
+        uint64_t pfcAuxLast = 0;
+        bool pauseStatusLast = false;
+    };
+
+    std::string evaluateQueue(PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime);
+    std::string detect(PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime);
+    std::string restore(PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime);
+    bool isStorm(const PfcWdQueueState &queue, const PfcWdQueueSample &sample, uint32_t pollTime) const;
+    bool readSamples(swss::DBConnector *countersDb, std::vector<PfcWdQueueSample> &samples);
+
+    const PfcWdDetectCriteria m_criteria;
+
+    // Flat state array, m_queueIndex maps queue id to the position in it
+    std::vector<PfcWdQueueState> m_queues;
+    std::unordered_map<sai_object_id_t, size_t> m_queueIndex;
+};
+
+#endif /* PFC_WD_DETECTOR_H */
@@ -302,6 +302,7 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
                 vector<FieldValueTuple> fieldValues;
                 fieldValues.emplace_back(POLL_INTERVAL_FIELD, value);
                 m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+                setDetectInterval(value);
             }
             else if (field == BIG_RED_SWITCH_FIELD)
             {
@@ -368,6 +369,12 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::disableBigRedSwitchMode()
     }
 
     m_brsEntryMap.clear();
+
+    // Counters snapshot is stale after the detection was paused
+    if (m_detector)
+    {
+        m_detector->reset();
+    }
 }
 
 template <typename DropHandler, typename ForwardHandler>
@@ -420,6 +427,11 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::enableBigRedSwitchMode()
             entry.second.handler->commitCounters();
             entry.second.handler = nullptr;
         }
+
+        if (m_detector)
+        {
+            m_detector->setStormed(entry.first, false);
+        }
     }
 
     // Create pfcwdaction hanlder on all the ports.
@@ -549,6 +561,12 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
 
+        if (m_detector)
+        {
+            m_detector->addQueue(queueId, port.m_port_id, i, detectionTime * 1000,
+                    restorationTime * 1000, action == PfcWdAction::PFC_WD_ACTION_ALERT);
+        }
+
         string key = getFlexCounterTableKey(queueIdStr);
         m_flexCounterTable->set(key, queueFieldValues);
 
@@ -630,6 +648,11 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
 
         m_entryMap.erase(queueId);
 
+        if (m_detector)
+        {
+            m_detector->removeQueue(queueId);
+        }
+
         // Clean up
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
         this->getCountersDb()->hdel(countersKey, {"PFC_WD_DETECTION_TIME", "PFC_WD_RESTORATION_TIME", "PFC_WD_ACTION", "PFC_WD_STATUS"});
@@ -665,31 +688,50 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
         return;
     }
 
-    string detectSha, restoreSha;
-    string detectPluginName = "pfc_detect_" + platform + ".lua";
-    string restorePluginName = "pfc_restore.lua";
-
-    try
+    // Storm detection runs in orchagent for the platforms with known criteria,
+    // the Lua plugins run by syncd remain as a fallback
+    PfcWdDetectCriteria criteria = PfcWdDetectCriteria::PFC_WD_CRITERIA_BROADCOM;
+    string detectionMode = getenv("PFC_WD_DETECTION_MODE") ? getenv("PFC_WD_DETECTION_MODE") : "";
+    if (detectionMode != "lua" && PfcWdDetector::getCriteria(platform, criteria))
     {
-        string detectLuaScript = swss::loadLuaScript(detectPluginName);
-        detectSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                detectLuaScript);
-
-        string restoreLuaScript = swss::loadLuaScript(restorePluginName);
-        restoreSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                restoreLuaScript);
+        m_detector.reset(new PfcWdDetector(criteria));
+        m_detectorDb = make_shared<DBConnector>("COUNTERS_DB", 0);
 
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+
+        SWSS_LOG_NOTICE("PFC watchdog storm detection runs in orchagent for platform %s", platform.c_str());
     }
-    catch (...)
+    else
     {
-        SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        string detectSha, restoreSha;
+        string detectPluginName = "pfc_detect_" + platform + ".lua";
+        string restorePluginName = "pfc_restore.lua";
+
+        try
+        {
+            string detectLuaScript = swss::loadLuaScript(detectPluginName);
+            detectSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    detectLuaScript);
+
+            string restoreLuaScript = swss::loadLuaScript(restorePluginName);
+            restoreSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    restoreLuaScript);
+
+            vector<FieldValueTuple> fieldValues;
+            fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
+            fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
+            fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
+            m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+        }
+        catch (...)
+        {
+            SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        }
     }
 
     auto consumer = new swss::NotificationConsumer(
@@ -704,6 +746,15 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
     Orch::addExecutor(executor);
     timer->start();
 
+    if (m_detector)
+    {
+        auto detectInterv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+        m_detectTimer = new SelectableTimer(detectInterv);
+        auto detectExecutor = new ExecutableTimer(m_detectTimer, this, "PFC_WD_STORM_DETECT");
+        Orch::addExecutor(detectExecutor);
+        m_detectTimer->start();
+    }
+
     auto ssTable = new swss::SubscriberStateTable(
             m_applDb.get(), APP_PFC_WD_TABLE_NAME, TableConsumable::DEFAULT_POP_BATCH_SIZE, default_orch_pri);
     auto ssConsumer = new Consumer(ssTable, this, APP_PFC_WD_TABLE_NAME);
@@ -883,6 +934,12 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_detectTimer)
+    {
+        detectStorms();
+        return;
+    }
+
     for (auto& handlerPair : m_entryMap)
     {
         if (handlerPair.second.handler != nullptr)
@@ -893,6 +950,56 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 
 }
 
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::detectStorms(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bigRedSwitchFlag)
+    {
+        return;
+    }
+
+    vector<PfcWdDetectEvent> events;
+    if (!m_detector->poll(m_detectorDb.get(), static_cast<uint32_t>(m_pollInterval) * 1000, events))
+    {
+        return;
+    }
+
+    for (const auto &e : events)
+    {
+        if (!startWdActionOnQueue(e.event, e.queueId))
+        {
+            SWSS_LOG_ERROR("Failed to start PFC watchdog %s event action on queue 0x%" PRIx64, e.event.c_str(), e.queueId);
+        }
+    }
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::setDetectInterval(const string &value)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_detectTimer == nullptr)
+    {
+        return;
+    }
+
+    try
+    {
+        m_pollInterval = static_cast<int>(to_uint<uint32_t>(value, 1, PFC_WD_DETECTION_TIME_MAX));
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid PFC watchdog poll interval %s: %s", value.c_str(), e.what());
+        return;
+    }
+
+    auto interv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+    m_detectTimer->setInterval(interv);
+    m_detectTimer->reset();
+}
+
 template <typename DropHandler, typename ForwardHandler>
 bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string &event, sai_object_id_t queueId)
 {
@@ -1007,6 +1114,11 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
         return false;
     }
 
+    if (m_detector)
+    {
+        m_detector->setStormed(queueId, entry->second.handler != nullptr);
+    }
+
     return true;
 }
 
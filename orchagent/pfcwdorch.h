@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "port.h"
 #include "pfcactionhandler.h"
+#include "pfcwddetector.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -113,6 +114,9 @@ private:
     string filterPfcCounters(string counters, set<uint8_t>& losslessTc);
     string getFlexCounterTableKey(string s);
 
+    void detectStorms(void);
+    void setDetectInterval(const string &value);
+
     void disableBigRedSwitchMode();
     void enableBigRedSwitchMode();
     void setBigRedSwitchMode(string value);
@@ -134,6 +138,11 @@ private:
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
+
+    // In-process storm detection, not used when detection runs in the Lua plugins
+    unique_ptr<PfcWdDetector> m_detector = nullptr;
+    shared_ptr<DBConnector> m_detectorDb = nullptr;
+    SelectableTimer *m_detectTimer = nullptr;
 };
 
 #endif
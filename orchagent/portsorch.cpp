@@ -26,6 +26,7 @@
 #include "sai_serialize.h"
 #include "crmorch.h"
 #include "countercheckorch.h"
+#include "countersnapshotorch.h"
 #include "notifier.h"
 #include "fdborch.h"
 
@@ -57,6 +58,9 @@ extern sai_system_port_api_t *sai_system_port_api;
 #define QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS "10000"
 #define PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS    "10000"
 #define PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS   "1000"
+#define COUNTER_MAP_PORTS_PER_ITERATION              16
+#define PORT_INIT_PORTS_PER_ITERATION                16
+#define QUEUE_COUNTER_TIER_EVALUATION_INTERVAL_SEC   10
 
 
 static map<string, sai_port_fec_mode_t> fec_mode_map =
@@ -242,27 +246,35 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
     /* Initialize gearbox */
     m_gearboxTable = unique_ptr<Table>(new Table(db, "_GEARBOX_TABLE"));
 
-    /* Initialize queue tables */
-    m_queueTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_NAME_MAP));
-    m_queuePortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_PORT_MAP));
-    m_queueIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_INDEX_MAP));
-    m_queueTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_QUEUE_TYPE_MAP));
+    /* Initialize queue tables, the maps are written in one transaction per port */
+    m_counterMapPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_counter_db.get()));
+    m_queueTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_QUEUE_NAME_MAP, true));
+    m_queuePortTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_QUEUE_PORT_MAP, true));
+    m_queueIndexTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_QUEUE_INDEX_MAP, true));
+    m_queueTypeTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_QUEUE_TYPE_MAP, true));
 
     /* Initialize ingress priority group tables */
-    m_pgTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_NAME_MAP));
-    m_pgPortTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_PORT_MAP));
-    m_pgIndexTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_PG_INDEX_MAP));
+    m_pgTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_PG_NAME_MAP, true));
+    m_pgPortTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_PG_PORT_MAP, true));
+    m_pgIndexTable = unique_ptr<Table>(new Table(m_counterMapPipeline.get(), COUNTERS_PG_INDEX_MAP, true));
 
     m_flex_db = shared_ptr<DBConnector>(new DBConnector("FLEX_COUNTER_DB", 0));
     m_flexCounterTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_TABLE));
     m_flexCounterGroupTable = unique_ptr<ProducerTable>(new ProducerTable(m_flex_db.get(), FLEX_COUNTER_GROUP_TABLE));
 
+    m_flexCounterPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(m_flex_db.get()));
+    m_flexCounterBufferedTable = unique_ptr<ProducerTable>(new ProducerTable(m_flexCounterPipeline.get(), FLEX_COUNTER_TABLE, true));
+
+    /* Port initialization stage times are reported from the start of PortsOrch */
+    m_portInitStart = chrono::steady_clock::now();
+    m_state_db = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
+    m_portInitStatsTable = unique_ptr<Table>(new Table(m_state_db.get(), STATE_PORT_INIT_STATS_TABLE_NAME));
+
     initGearbox();
 
     string queueWmSha, pgWmSha;
     string queueWmPluginName = "watermark_queue.lua";
     string pgWmPluginName = "watermark_pg.lua";
-    string portRatePluginName = "port_rates.lua";
 
     try
     {
@@ -272,9 +284,6 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
         string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
         pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
 
-        string portRateLuaScript = swss::loadLuaScript(portRatePluginName);
-        string portRateSha = swss::loadRedisScript(m_counter_db.get(), portRateLuaScript);
-
         vector<FieldValueTuple> fieldValues;
         fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, queueWmSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
@@ -287,8 +296,8 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ_AND_CLEAR);
         m_flexCounterGroupTable->set(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
 
+        /* Port rates are computed by CounterSnapshotOrch, no plugin needed */
         fieldValues.clear();
-        fieldValues.emplace_back(PORT_PLUGIN_FIELD, portRateSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS);
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
@@ -298,6 +307,12 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames)
         SWSS_LOG_ERROR("Port flex counter groups were not set successfully: %s", e.what());
     }
 
+    /* Periodically move the queues between the counter polling tiers */
+    m_queueCounterTierTimer = new SelectableTimer(timespec { .tv_sec = QUEUE_COUNTER_TIER_EVALUATION_INTERVAL_SEC, .tv_nsec = 0 });
+    auto executor = new ExecutableTimer(m_queueCounterTierTimer, this, "QUEUE_COUNTER_TIER_POLL");
+    Orch::addExecutor(executor);
+    m_queueCounterTierTimer->start();
+
     uint32_t i, j;
     sai_status_t status;
     sai_attribute_t attr;
@@ -1546,31 +1561,172 @@ bool PortsOrch::isSpeedSupported(const std::string& alias, sai_object_id_t port_
 }
 
 /*
- * If Gearbox is enabled and this is a Gearbox port then set the attributes accordingly.
+ * Set one attribute per entry of port_ids with a single bulk call, a port id
+ * may be repeated to set several attributes of the same port. Falls back to
+ * setting them one by one if the SAI does not implement the bulk set. Both
+ * paths stop at the first failure, the entries after it are left with
+ * SAI_STATUS_NOT_EXECUTED.
  */
-bool PortsOrch::setGearboxPortsAttr(Port &port, sai_port_attr_t id, void *value)
+bool PortsOrch::setPortsAttribute(const vector<sai_object_id_t> &port_ids, const vector<sai_attribute_t> &attrs,
+                                  vector<sai_status_t> &statuses)
 {
-    bool status;
+    SWSS_LOG_ENTER();
+
+    uint32_t count = static_cast<uint32_t>(port_ids.size());
+    statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
+    if (count == 0)
+    {
+        return true;
+    }
 
-    status = setGearboxPortAttr(port, PHY_PORT_TYPE, id, value);
+    if (m_portBulkSetSupported && sai_port_api->set_ports_attribute != NULL)
+    {
+        sai_status_t status = sai_port_api->set_ports_attribute(count, port_ids.data(), attrs.data(),
+                                                                SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return status == SAI_STATUS_SUCCESS;
+        }
+
+        SWSS_LOG_NOTICE("Port attributes bulk set is not supported, setting them one by one");
+        m_portBulkSetSupported = false;
+        statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
+    }
 
-    if (status == true)
+    for (uint32_t i = 0; i < count; i++)
     {
-        status = setGearboxPortAttr(port, LINE_PORT_TYPE, id, value);
+        statuses[i] = sai_port_api->set_port_attribute(port_ids[i], &attrs[i]);
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            return false;
+        }
     }
 
-    return status;
+    return true;
+}
+
+/*
+ * Create ports on switch_id, one per entry of attrs, with a single bulk call.
+ * Falls back to creating them one by one if the SAI does not implement the
+ * bulk create, stops at the first failure either way.
+ */
+bool PortsOrch::createPorts(sai_object_id_t switch_id, const vector<vector<sai_attribute_t>> &attrs,
+                            vector<sai_object_id_t> &port_ids, vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count = static_cast<uint32_t>(attrs.size());
+    port_ids.assign(count, SAI_NULL_OBJECT_ID);
+    statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
+    if (count == 0)
+    {
+        return true;
+    }
+
+    if (m_portBulkCreateSupported && sai_port_api->create_ports != NULL)
+    {
+        vector<uint32_t> attr_counts(count);
+        vector<const sai_attribute_t *> attr_lists(count);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            attr_counts[i] = static_cast<uint32_t>(attrs[i].size());
+            attr_lists[i] = attrs[i].data();
+        }
+
+        sai_status_t status = sai_port_api->create_ports(switch_id, count, attr_counts.data(), attr_lists.data(),
+                                                         SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, port_ids.data(), statuses.data());
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return status == SAI_STATUS_SUCCESS;
+        }
+
+        SWSS_LOG_NOTICE("Port bulk create is not supported, creating them one by one");
+        m_portBulkCreateSupported = false;
+        port_ids.assign(count, SAI_NULL_OBJECT_ID);
+        statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        statuses[i] = sai_port_api->create_port(&port_ids[i], switch_id,
+                                                static_cast<uint32_t>(attrs[i].size()), attrs[i].data());
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /*
- * If Gearbox is enabled and this is a Gearbox port then set the specific lane attribute.
+ * If Gearbox is enabled and this is a Gearbox port then set the attributes
+ * accordingly, both the system and line side ports with one bulk set.
  * Note: the appl_db is also updated (Gearbox config_db tables are TBA).
  */
-bool PortsOrch::setGearboxPortAttr(Port &port, dest_port_type_t port_type, sai_port_attr_t id, void *value)
+bool PortsOrch::setGearboxPortsAttr(Port &port, sai_port_attr_t id, void *value)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_gearboxEnabled || m_gearboxPortListLaneMap.find(port.m_port_id) == m_gearboxPortListLaneMap.end())
+    {
+        return true;
+    }
+
+    vector<dest_port_type_t> port_types;
+    vector<sai_object_id_t> port_ids;
+    vector<sai_attribute_t> attrs;
+    bool success = true;
+
+    for (auto port_type : { PHY_PORT_TYPE, LINE_PORT_TYPE })
+    {
+        sai_object_id_t dest_port_id;
+        sai_attribute_t attr;
+
+        if (!getGearboxPortAttr(port, port_type, id, value, dest_port_id, attr))
+        {
+            success = false;
+            continue;
+        }
+
+        port_types.push_back(port_type);
+        port_ids.push_back(dest_port_id);
+        attrs.push_back(attr);
+    }
+
+    vector<sai_status_t> statuses;
+    if (!setPortsAttribute(port_ids, attrs, statuses))
+    {
+        success = false;
+    }
+
+    for (size_t i = 0; i < statuses.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("BOX: Failed to set %s port attribute %d", port.m_alias.c_str(), id);
+            continue;
+        }
+
+        if (id == SAI_PORT_ATTR_SPEED)
+        {
+            string speed_attr = port_types[i] == PHY_PORT_TYPE ? "system_speed" : "line_speed";
+            string key = "phy:"+to_string(m_gearboxInterfaceMap[port.m_index].phy_id)+":ports:"+to_string(port.m_index);
+            m_gearboxTable->hset(key, speed_attr, to_string(attrs[i].value.u32));
+            SWSS_LOG_NOTICE("BOX: Updated APPL_DB key:%s %s %d", key.c_str(), speed_attr.c_str(), attrs[i].value.u32);
+        }
+    }
+
+    return success;
+}
+
+/*
+ * Build the attribute of the system or line side port of a Gearbox port.
+ */
+bool PortsOrch::getGearboxPortAttr(Port &port, dest_port_type_t port_type, sai_port_attr_t id, void *value,
+                                   sai_object_id_t &dest_port_id, sai_attribute_t &attr)
 {
-    sai_status_t status = SAI_STATUS_SUCCESS;
-    sai_object_id_t dest_port_id;
-    sai_attribute_t attr;
     string speed_attr;
     uint32_t lane_speed = 0;
     sai_uint32_t speed = 0;
@@ -1578,79 +1734,66 @@ bool PortsOrch::setGearboxPortAttr(Port &port, dest_port_type_t port_type, sai_p
 
     SWSS_LOG_ENTER();
 
-    if (m_gearboxEnabled)
+    if (getDestPortId(port.m_port_id, port_type, dest_port_id) == false)
     {
-        if (getDestPortId(port.m_port_id, port_type, dest_port_id) == true)
-        {
-            switch (id)
+        return false;
+    }
+
+    switch (id)
+    {
+        case SAI_PORT_ATTR_FEC_MODE:
+            attr.id = id;
+            attr.value.s32 = *static_cast<sai_int32_t*>(value);
+            SWSS_LOG_NOTICE("BOX: Set %s FEC_MODE %d", port.m_alias.c_str(), attr.value.s32);
+            break;
+        case SAI_PORT_ATTR_ADMIN_STATE:
+            attr.id = id;
+            attr.value.booldata = *static_cast<bool*>(value);
+            SWSS_LOG_NOTICE("BOX: Set %s ADMIN_STATE %d", port.m_alias.c_str(), attr.value.booldata);
+            break;
+        case SAI_PORT_ATTR_SPEED:
+            switch (port_type)
             {
-                case SAI_PORT_ATTR_FEC_MODE:
-                    attr.id = id;
-                    attr.value.s32 = *static_cast<sai_int32_t*>(value);
-                    SWSS_LOG_NOTICE("BOX: Set %s FEC_MODE %d", port.m_alias.c_str(), attr.value.s32);
+                case PHY_PORT_TYPE:
+                    lanes = static_cast<uint32_t>(m_gearboxInterfaceMap[port.m_index].system_lanes.size());
+                    speed_attr = "system_speed";
                     break;
-                case SAI_PORT_ATTR_ADMIN_STATE:
-                    attr.id = id;
-                    attr.value.booldata = *static_cast<bool*>(value);
-                    SWSS_LOG_NOTICE("BOX: Set %s ADMIN_STATE %d", port.m_alias.c_str(), attr.value.booldata);
-                    break;
-                case SAI_PORT_ATTR_SPEED:
-                    switch (port_type)
-                    {
-                        case PHY_PORT_TYPE:
-                            lanes = static_cast<uint32_t>(m_gearboxInterfaceMap[port.m_index].system_lanes.size());
-                            speed_attr = "system_speed";
-                            break;
-                        case LINE_PORT_TYPE:
-                            lanes = static_cast<uint32_t>(m_gearboxInterfaceMap[port.m_index].line_lanes.size());
-                            speed_attr = "line_speed";
-                            break;
-                        default:
-                            return false;
-                    }
-
-                    // Gearbox expects speed per lane
-                    speed = *static_cast<sai_int32_t*>(value);
-                    if (speed % lanes == 0)
-                    {
-                        lane_speed = speed / lanes;
-                    }
-                    if (isSpeedSupported(port.m_alias, dest_port_id, lane_speed))
-                    {
-                        // Gearbox may not implement speed check, so
-                        // invalidate speed if it doesn't make sense.
-                        if (to_string(lane_speed).size() < 5)
-                        {
-                            lane_speed = 0;
-                        }
-
-                        attr.id = SAI_PORT_ATTR_SPEED;
-                        attr.value.u32 = lane_speed;
-                    }
-                    SWSS_LOG_NOTICE("BOX: Set %s lane %s %d", port.m_alias.c_str(), speed_attr.c_str(), lane_speed);
+                case LINE_PORT_TYPE:
+                    lanes = static_cast<uint32_t>(m_gearboxInterfaceMap[port.m_index].line_lanes.size());
+                    speed_attr = "line_speed";
                     break;
                 default:
                     return false;
             }
 
-            status = sai_port_api->set_port_attribute(dest_port_id, &attr);
-            if (status == SAI_STATUS_SUCCESS)
+            // Gearbox expects speed per lane
+            speed = *static_cast<sai_int32_t*>(value);
+            if (lanes != 0 && speed % lanes == 0)
             {
-                if (id == SAI_PORT_ATTR_SPEED)
-                {
-                    string key = "phy:"+to_string(m_gearboxInterfaceMap[port.m_index].phy_id)+":ports:"+to_string(port.m_index);
-                    m_gearboxTable->hset(key, speed_attr, to_string(lane_speed));
-                    SWSS_LOG_NOTICE("BOX: Updated APPL_DB key:%s %s %d", key.c_str(), speed_attr.c_str(), lane_speed);
-                }
+                lane_speed = speed / lanes;
             }
-            else
+            if (!isSpeedSupported(port.m_alias, dest_port_id, lane_speed))
             {
-                SWSS_LOG_ERROR("BOX: Failed to set %s port attribute %d", port.m_alias.c_str(), id);
+                SWSS_LOG_ERROR("BOX: Unsupported %s lane %s %d", port.m_alias.c_str(), speed_attr.c_str(), lane_speed);
+                return false;
             }
-        }
+
+            // Gearbox may not implement speed check, so
+            // invalidate speed if it doesn't make sense.
+            if (to_string(lane_speed).size() < 5)
+            {
+                lane_speed = 0;
+            }
+
+            attr.id = SAI_PORT_ATTR_SPEED;
+            attr.value.u32 = lane_speed;
+            SWSS_LOG_NOTICE("BOX: Set %s lane %s %d", port.m_alias.c_str(), speed_attr.c_str(), lane_speed);
+            break;
+        default:
+            return false;
     }
 
-    return status == SAI_STATUS_SUCCESS;
+    return true;
 }
 
 bool PortsOrch::setPortSpeed(Port &port, sai_uint32_t speed)
@@ -1710,6 +1853,22 @@ bool PortsOrch::setPortAdvSpeed(sai_object_id_t port_id, sai_uint32_t speed)
     return status == SAI_STATUS_SUCCESS;
 }
 
+static string getQueueTypeName(int32_t type, sai_object_id_t queue_id)
+{
+    switch (type)
+    {
+    case SAI_QUEUE_TYPE_ALL:
+        return "SAI_QUEUE_TYPE_ALL";
+    case SAI_QUEUE_TYPE_UNICAST:
+        return "SAI_QUEUE_TYPE_UNICAST";
+    case SAI_QUEUE_TYPE_MULTICAST:
+        return "SAI_QUEUE_TYPE_MULTICAST";
+    default:
+        SWSS_LOG_ERROR("Got unsupported queue type %d for %" PRIu64 " queue", type, queue_id);
+        throw runtime_error("Got unsupported queue type");
+    }
+}
+
 bool PortsOrch::getQueueTypeAndIndex(sai_object_id_t queue_id, string &type, uint8_t &index)
 {
     SWSS_LOG_ENTER();
@@ -1725,25 +1884,77 @@ bool PortsOrch::getQueueTypeAndIndex(sai_object_id_t queue_id, string &type, uin
         return false;
     }
 
-    switch (attr[0].value.s32)
+    type = getQueueTypeName(attr[0].value.s32, queue_id);
+    index = attr[1].value.u8;
+
+    return true;
+}
+
+/*
+ * Get the type and index of all the queues with a single bulk get, falls back
+ * to one get per queue if the SAI does not implement bulk get.
+ * Queues whose attributes could not be read are left out of queue_info.
+ */
+void PortsOrch::getQueuesTypeAndIndex(const vector<sai_object_id_t> &queue_ids, map<sai_object_id_t, pair<string, uint8_t>> &queue_info)
+{
+    SWSS_LOG_ENTER();
+
+    if (queue_ids.empty())
     {
-    case SAI_QUEUE_TYPE_ALL:
-        type = "SAI_QUEUE_TYPE_ALL";
-        break;
-    case SAI_QUEUE_TYPE_UNICAST:
-        type = "SAI_QUEUE_TYPE_UNICAST";
-        break;
-    case SAI_QUEUE_TYPE_MULTICAST:
-        type = "SAI_QUEUE_TYPE_MULTICAST";
-        break;
-    default:
-        SWSS_LOG_ERROR("Got unsupported queue type %d for %" PRIu64 " queue", attr[0].value.s32, queue_id);
-        throw runtime_error("Got unsupported queue type");
+        return;
     }
 
-    index = attr[1].value.u8;
+    if (m_queueBulkGetSupported)
+    {
+        uint32_t count = static_cast<uint32_t>(queue_ids.size());
+        vector<sai_object_key_t> keys(count);
+        vector<uint32_t> attr_counts(count, 2);
+        vector<sai_attribute_t> attrs(count * 2);
+        vector<sai_attribute_t *> attr_lists(count);
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
 
-    return true;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            keys[i].key.object_id = queue_ids[i];
+            attrs[i * 2].id = SAI_QUEUE_ATTR_TYPE;
+            attrs[i * 2 + 1].id = SAI_QUEUE_ATTR_INDEX;
+            attr_lists[i] = &attrs[i * 2];
+        }
+
+        sai_status_t status = sai_bulk_get_attribute(gSwitchId, SAI_OBJECT_TYPE_QUEUE, count, keys.data(),
+                                                     attr_counts.data(), attr_lists.data(), statuses.data());
+        if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            SWSS_LOG_NOTICE("Queue attributes bulk get is not supported, getting them one by one");
+            m_queueBulkGetSupported = false;
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (statuses[i] != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to get queue type and index for queue %" PRIu64 " rv:%d", queue_ids[i], statuses[i]);
+                    continue;
+                }
+
+                queue_info[queue_ids[i]] = make_pair(getQueueTypeName(attr_lists[i][0].value.s32, queue_ids[i]),
+                                                     attr_lists[i][1].value.u8);
+            }
+            return;
+        }
+    }
+
+    for (const auto &queue_id : queue_ids)
+    {
+        string type;
+        uint8_t index = 0;
+
+        if (getQueueTypeAndIndex(queue_id, type, index))
+        {
+            queue_info[queue_id] = make_pair(type, index);
+        }
+    }
 }
 
 bool PortsOrch::setPortAutoNeg(sai_object_id_t id, int an)
@@ -1896,78 +2107,328 @@ string PortsOrch::getPriorityGroupWatermarkFlexCounterTableKey(string key)
     return string(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" + key;
 }
 
-bool PortsOrch::initPort(const string &alias, const int index, const set<int> &lane_set)
+/*
+ * Ports are initialized in stages, each stage handles all the new ports
+ * before the next one starts:
+ * 1) The PG and queue lists, admin status and speed are read with bulk gets
+ * 2) The host interfaces are created, portsyncd sends PortInitDone once all
+ *    of their netdevs show up
+ * 3) The counter maps, flex counters and gearbox ports are deferred, see
+ *    initPortsDeferredSlice()
+ */
+bool PortsOrch::initPorts()
 {
     SWSS_LOG_ENTER();
 
-    /* Determine if the lane combination exists in switch */
-    if (m_portListLaneMap.find(lane_set) != m_portListLaneMap.end())
+    vector<Port> ports;
+
+    for (const auto &it : m_lanesAliasSpeedMap)
     {
-        sai_object_id_t id = m_portListLaneMap[lane_set];
+        const string &alias = get<0>(it.second);
+
+        /* Determine if the lane combination exists in switch */
+        auto lanes = m_portListLaneMap.find(it.first);
+        if (lanes == m_portListLaneMap.end())
+        {
+            SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
+            return false;
+        }
 
         /* Determine if the port has already been initialized before */
-        if (m_portList.find(alias) != m_portList.end() && m_portList[alias].m_port_id == id)
+        if (m_portList.find(alias) != m_portList.end() && m_portList[alias].m_port_id == lanes->second)
         {
             SWSS_LOG_DEBUG("Port has already been initialized before alias:%s", alias.c_str());
+            continue;
         }
-        else
+
+        Port p(alias, Port::PHY);
+
+        p.m_index = get<4>(it.second);
+        p.m_port_id = lanes->second;
+        ports.push_back(p);
+    }
+
+    if (ports.empty())
+    {
+        return true;
+    }
+
+    auto start = chrono::steady_clock::now();
+    if (!initializePortsAttributes(ports))
+    {
+        return false;
+    }
+    addPortInitStageTime("attributes", start);
+
+    /* Initialize the ports and create corresponding host interfaces */
+    start = chrono::steady_clock::now();
+    for (auto &p : ports)
+    {
+        if (!initializePort(p))
         {
-            Port p(alias, Port::PHY);
+            SWSS_LOG_ERROR("Failed to initialize port %s", p.m_alias.c_str());
+            return false;
+        }
+    }
+    addPortInitStageTime("host_interfaces", start);
+
+    for (auto &p : ports)
+    {
+        /* Add port to port list */
+        m_portList[p.m_alias] = p;
+        m_port_ref_count[p.m_alias] = 0;
+        m_portOidToIndex[p.m_port_id] = p.m_index;
+
+        PortUpdate update = { p, true };
+        notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+
+        m_portList[p.m_alias].m_init = true;
+
+        if (m_pendingPortInitSet.insert(p.m_alias).second)
+        {
+            m_pendingPortInitPorts.push_back(p.m_alias);
+        }
+
+        SWSS_LOG_NOTICE("Initialized port %s", p.m_alias.c_str());
+    }
+
+    updatePortInitStats();
+
+    return true;
+}
+
+/*
+ * Get the PG and queue lists, admin status and speed of the ports with bulk
+ * gets, falls back to getting them port by port if the SAI does not
+ * implement bulk get.
+ */
+bool PortsOrch::initializePortsAttributes(vector<Port> &ports)
+{
+    SWSS_LOG_ENTER();
 
-            p.m_index = index;
-            p.m_port_id = id;
+    if (m_portBulkGetSupported)
+    {
+        const uint32_t attr_count = 4;
+        uint32_t count = static_cast<uint32_t>(ports.size());
+        vector<sai_object_key_t> keys(count);
+        vector<uint32_t> attr_counts(count, attr_count);
+        vector<sai_attribute_t> attrs(count * attr_count);
+        vector<sai_attribute_t *> attr_lists(count);
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
 
-            /* Initialize the port and create corresponding host interface */
-            if (initializePort(p))
+        for (uint32_t i = 0; i < count; i++)
+        {
+            keys[i].key.object_id = ports[i].m_port_id;
+            attrs[i * attr_count].id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
+            attrs[i * attr_count + 1].id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
+            attrs[i * attr_count + 2].id = SAI_PORT_ATTR_ADMIN_STATE;
+            attrs[i * attr_count + 3].id = SAI_PORT_ATTR_SPEED;
+            attr_lists[i] = &attrs[i * attr_count];
+        }
+
+        sai_status_t status = sai_bulk_get_attribute(gSwitchId, SAI_OBJECT_TYPE_PORT, count, keys.data(),
+                                                     attr_counts.data(), attr_lists.data(), statuses.data());
+        if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+        {
+            SWSS_LOG_NOTICE("Port attributes bulk get is not supported, getting them one by one");
+            m_portBulkGetSupported = false;
+        }
+        else
+        {
+            /* Second pass gets the PG and queue lists, sized by the first one */
+            vector<sai_object_key_t> list_keys;
+            vector<uint32_t> list_attr_counts;
+            vector<sai_attribute_t> list_attrs(count * 2);
+            vector<sai_attribute_t *> list_attr_lists;
+            vector<Port *> list_ports;
+
+            for (uint32_t i = 0; i < count; i++)
             {
-                /* Create associated Gearbox lane mapping */
-                initGearboxPort(p);
-
-                /* Add port to port list */
-                m_portList[alias] = p;
-                m_port_ref_count[alias] = 0;
-                m_portOidToIndex[id] = index;
-
-                /* Add port name map to counter table */
-                FieldValueTuple tuple(p.m_alias, sai_serialize_object_id(p.m_port_id));
-                vector<FieldValueTuple> fields;
-                fields.push_back(tuple);
-                m_counterTable->set("", fields);
-                // Install a flex counter for this port to track stats
-                std::unordered_set<std::string> counter_stats;
-                for (const auto& it: port_stat_ids)
+                Port &port = ports[i];
+
+                if (statuses[i] != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to get initial attributes of port %s rv:%d", port.m_alias.c_str(), statuses[i]);
+                    return false;
+                }
+
+                uint32_t pg_count = attr_lists[i][0].value.u32;
+                uint32_t queue_count = attr_lists[i][1].value.u32;
+                port.m_admin_state_up = attr_lists[i][2].value.booldata;
+                port.m_speed = attr_lists[i][3].value.u32;
+
+                SWSS_LOG_INFO("Get %d priority groups and %d queues for port %s", pg_count, queue_count, port.m_alias.c_str());
+
+                port.m_priority_group_ids.resize(pg_count);
+                port.m_priority_group_lock.resize(pg_count);
+                port.m_priority_group_pending_profile.resize(pg_count);
+                port.m_queue_ids.resize(queue_count);
+                port.m_queue_lock.resize(queue_count);
+
+                sai_attribute_t *list_attr = &list_attrs[i * 2];
+                uint32_t list_count = 0;
+
+                if (pg_count)
                 {
-                    counter_stats.emplace(sai_serialize_port_stat(it));
+                    list_attr[list_count].id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
+                    list_attr[list_count].value.objlist.count = pg_count;
+                    list_attr[list_count].value.objlist.list = port.m_priority_group_ids.data();
+                    list_count++;
                 }
-                port_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, counter_stats);
-                std::unordered_set<std::string> port_buffer_drop_stats;
-                for (const auto& it: port_buffer_drop_stat_ids)
+
+                if (queue_count)
                 {
-                    port_buffer_drop_stats.emplace(sai_serialize_port_stat(it));
+                    list_attr[list_count].id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
+                    list_attr[list_count].value.objlist.count = queue_count;
+                    list_attr[list_count].value.objlist.list = port.m_queue_ids.data();
+                    list_count++;
                 }
-                port_buffer_drop_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, port_buffer_drop_stats);
 
-                PortUpdate update = { p, true };
-                notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
+                if (!list_count)
+                {
+                    continue;
+                }
 
-                m_portList[alias].m_init = true;
+                list_keys.emplace_back();
+                list_keys.back().key.object_id = port.m_port_id;
+                list_attr_counts.push_back(list_count);
+                list_attr_lists.push_back(list_attr);
+                list_ports.push_back(&port);
+            }
 
-                SWSS_LOG_NOTICE("Initialized port %s", alias.c_str());
+            if (list_keys.empty())
+            {
+                return true;
             }
-            else
+
+            count = static_cast<uint32_t>(list_keys.size());
+            statuses.assign(count, SAI_STATUS_FAILURE);
+
+            sai_bulk_get_attribute(gSwitchId, SAI_OBJECT_TYPE_PORT, count, list_keys.data(),
+                                   list_attr_counts.data(), list_attr_lists.data(), statuses.data());
+
+            for (uint32_t i = 0; i < count; i++)
             {
-                SWSS_LOG_ERROR("Failed to initialize port %s", alias.c_str());
-                return false;
+                if (statuses[i] != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("Failed to get priority group and queue lists for port %s rv:%d",
+                                   list_ports[i]->m_alias.c_str(), statuses[i]);
+                    throw runtime_error("PortsOrch initialization failure.");
+                }
             }
+
+            return true;
         }
     }
-    else
+
+    for (auto &port : ports)
+    {
+        initializePriorityGroups(port);
+        initializeQueues(port);
+
+        /* initialize port admin status */
+        if (!getPortAdminStatus(port.m_port_id, port.m_admin_state_up))
+        {
+            SWSS_LOG_ERROR("Failed to get initial port admin status %s", port.m_alias.c_str());
+            return false;
+        }
+
+        /* initialize port admin speed */
+        if (!getPortSpeed(port.m_port_id, port.m_speed))
+        {
+            SWSS_LOG_ERROR("Failed to get initial port admin speed %d", port.m_speed);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Set up the parts of the port which are not needed for the host interface to
+ * come up. Done in the background by initPortsDeferredSlice(), or before the
+ * port is configured since the gearbox ports have to exist by then.
+ */
+void PortsOrch::initPortDeferred(const string &alias)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_pendingPortInitSet.erase(alias))
+    {
+        return;
+    }
+
+    /* The port might have been removed while waiting */
+    auto found = m_portList.find(alias);
+    if (found == m_portList.end())
+    {
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
+    Port &p = found->second;
+
+    /* Create associated Gearbox lane mapping */
+    initGearboxPort(p);
+
+    /* Add port name map to counter table */
+    FieldValueTuple tuple(p.m_alias, sai_serialize_object_id(p.m_port_id));
+    vector<FieldValueTuple> fields;
+    fields.push_back(tuple);
+    m_counterTable->set("", fields);
+    // Install a flex counter for this port to track stats
+    std::unordered_set<std::string> counter_stats;
+    for (const auto& it: port_stat_ids)
+    {
+        counter_stats.emplace(sai_serialize_port_stat(it));
+    }
+    port_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, counter_stats);
+    CounterSnapshotOrch::getInstance().addObject(CounterSnapshotGroup::PORT, sai_serialize_object_id(p.m_port_id));
+    std::unordered_set<std::string> port_buffer_drop_stats;
+    for (const auto& it: port_buffer_drop_stat_ids)
+    {
+        port_buffer_drop_stats.emplace(sai_serialize_port_stat(it));
+    }
+    port_buffer_drop_stat_manager.setCounterIdList(p.m_port_id, CounterType::PORT, port_buffer_drop_stats);
+
+    addPortInitStageTime("deferred", start);
+}
+
+void PortsOrch::initPortsDeferredSlice()
+{
+    if (m_pendingPortInitPorts.empty())
+    {
+        return;
+    }
+
+    for (int i = 0; i < PORT_INIT_PORTS_PER_ITERATION && !m_pendingPortInitPorts.empty(); i++)
+    {
+        initPortDeferred(m_pendingPortInitPorts.front());
+        m_pendingPortInitPorts.pop_front();
+    }
+
+    if (m_pendingPortInitPorts.empty())
+    {
+        updatePortInitStats();
+    }
+}
+
+void PortsOrch::addPortInitStageTime(const string &stage, chrono::steady_clock::time_point start)
+{
+    auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+    m_portInitStageTime[stage] += static_cast<uint64_t>(duration.count());
+}
+
+void PortsOrch::updatePortInitStats()
+{
+    vector<FieldValueTuple> fvs;
+
+    for (const auto &it : m_portInitStageTime)
     {
-        SWSS_LOG_ERROR("Failed to locate port lane combination alias:%s", alias.c_str());
-        return false;
+        fvs.emplace_back(it.first + "_ms", to_string(it.second / 1000));
     }
 
-    return true;
+    m_portInitStatsTable->set("PORT_INIT", fvs);
 }
 
 void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
@@ -1977,8 +2438,17 @@ void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
     Port p(alias, Port::PHY);
     p.m_port_id = port_id;
 
+    /* The counters of the port were never installed */
+    if (m_pendingPortInitSet.erase(alias))
+    {
+        m_portList[alias].m_init = false;
+        SWSS_LOG_NOTICE("De-Initialized port %s", alias.c_str());
+        return;
+    }
+
     /* remove port from flex_counter_table for updating counters  */
     port_stat_manager.clearCounterIdList(p.m_port_id);
+    CounterSnapshotOrch::getInstance().removeObject(CounterSnapshotGroup::PORT, sai_serialize_object_id(p.m_port_id));
 
     /* remove port name map from counter table */
     m_counter_db->hdel(COUNTERS_PORT_NAME_MAP, alias);
@@ -2131,6 +2601,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 addSystemPorts();
                 m_initDone = true;
                 SWSS_LOG_INFO("Get PortInitDone notification from portsyncd.");
+
+                addPortInitStageTime("port_init_done", m_portInitStart);
+                updatePortInitStats();
             }
 
             it = consumer.m_toSync.erase(it);
@@ -2253,6 +2726,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
              */
             if (m_portConfigState == PORT_CONFIG_RECEIVED || m_portConfigState == PORT_CONFIG_DONE)
             {
+                auto start = chrono::steady_clock::now();
+
                 for (auto it = m_portListLaneMap.begin(); it != m_portListLaneMap.end();)
                 {
                     if (m_lanesAliasSpeedMap.find(it->first) == m_lanesAliasSpeedMap.end())
@@ -2269,7 +2744,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
-                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
+                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end(); it++)
                 {
                     if (m_portListLaneMap.find(it->first) == m_portListLaneMap.end())
                     {
@@ -2278,13 +2753,13 @@ void PortsOrch::doPortTask(Consumer &consumer)
                             throw runtime_error("PortsOrch initialization failure.");
                         }
                     }
+                }
 
-                    if (!initPort(get<0>(it->second), get<4>(it->second), it->first))
-                    {
-                        throw runtime_error("PortsOrch initialization failure.");
-                    }
+                addPortInitStageTime("create", start);
 
-                    it++;
+                if (!initPorts())
+                {
+                    throw runtime_error("PortsOrch initialization failure.");
                 }
 
                 m_portConfigState = PORT_CONFIG_DONE;
@@ -2315,6 +2790,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 m_pendingPortSet.erase(alias);
             }
 
+            /* The gearbox ports have to exist before the port is configured */
+            initPortDeferred(alias);
+
             Port p;
             if (!getPort(alias, p))
             {
@@ -2551,49 +3029,32 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
+                map<sai_port_attr_t, vector<uint32_t>> serdes_attrs;
                 if (pre_emphasis.size() != 0)
                 {
-                    if (setPortSerdesAttribute(p.m_port_id, SAI_PORT_ATTR_SERDES_PREEMPHASIS, pre_emphasis))
-                    {
-                        SWSS_LOG_NOTICE("Set port %s  preemphasis is success", alias.c_str());
-                    }
-                    else
-                    {
-                        SWSS_LOG_ERROR("Failed to set port %s pre-emphasis", alias.c_str());
-                        it++;
-                        continue;
-                    }
-
+                    serdes_attrs[SAI_PORT_ATTR_SERDES_PREEMPHASIS] = pre_emphasis;
                 }
-
                 if (idriver.size() != 0)
                 {
-                    if (setPortSerdesAttribute(p.m_port_id, SAI_PORT_ATTR_SERDES_IDRIVER, idriver))
-                    {
-                        SWSS_LOG_NOTICE("Set port %s idriver is success", alias.c_str());
-                    }
-                    else
-                    {
-                        SWSS_LOG_ERROR("Failed to set port %s idriver", alias.c_str());
-                        it++;
-                        continue;
-                    }
-
+                    serdes_attrs[SAI_PORT_ATTR_SERDES_IDRIVER] = idriver;
                 }
-
                 if (ipredriver.size() != 0)
                 {
-                    if (setPortSerdesAttribute(p.m_port_id, SAI_PORT_ATTR_SERDES_IPREDRIVER, ipredriver))
+                    serdes_attrs[SAI_PORT_ATTR_SERDES_IPREDRIVER] = ipredriver;
+                }
+
+                if (!serdes_attrs.empty())
+                {
+                    if (setPortSerdesAttributes(p.m_port_id, serdes_attrs))
                     {
-                        SWSS_LOG_NOTICE("Set port %s ipredriver is success", alias.c_str());
+                        SWSS_LOG_NOTICE("Set port %s serdes attributes is success", alias.c_str());
                     }
                     else
                     {
-                        SWSS_LOG_ERROR("Failed to set port %s ipredriver", alias.c_str());
+                        SWSS_LOG_ERROR("Failed to set port %s serdes attributes", alias.c_str());
                         it++;
                         continue;
                     }
-
                 }
 
                 /* Last step set port admin status */
@@ -3032,6 +3493,10 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /* New members are created with one bulk call after the first pass */
+    vector<LagMemberBulkContext> toCreate;
+    map<string, string> pendingPorts;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -3076,16 +3541,33 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
                     status = fvValue(i);
             }
 
-            if (lag.m_members.find(port_alias) == lag.m_members.end())
+            /* The port is added to one LAG per pass */
+            if (pendingPorts.find(port_alias) != pendingPorts.end())
             {
-                /* Assert the port doesn't belong to any LAG already */
-                assert(!port.m_lag_id && !port.m_lag_member_id);
+                it++;
+                continue;
+            }
 
-                if (!addLagMember(lag, port, (status == "enabled")))
+            if (lag.m_members.find(port_alias) == lag.m_members.end())
+            {
+                /* A port moving between LAGs is first removed from the old one */
+                if (port.m_lag_id || port.m_lag_member_id)
                 {
                     it++;
                     continue;
                 }
+
+                /* The member is created with its forwarding status */
+                toCreate.emplace_back();
+                auto &ctx = toCreate.back();
+                ctx.sync_it = it;
+                ctx.lag_alias = lag_alias;
+                ctx.port_alias = port_alias;
+                addLagMember(lag, port, (status == "enabled"), ctx.attrs);
+                pendingPorts[port_alias] = lag_alias;
+
+                it++;
+                continue;
             }
 
             /* Sync an enabled member */
@@ -3126,6 +3608,14 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
         /* Remove a LAG member */
         else if (op == DEL_COMMAND)
         {
+            /* Removed after the pending add of the member */
+            auto pending = pendingPorts.find(port_alias);
+            if (pending != pendingPorts.end() && pending->second == lag_alias)
+            {
+                it++;
+                continue;
+            }
+
             /* Assert the LAG member exists */
             assert(lag.m_members.find(port_alias) != lag.m_members.end());
 
@@ -3152,6 +3642,50 @@ void PortsOrch::doLagMemberTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (toCreate.empty())
+    {
+        return;
+    }
+
+    vector<vector<sai_attribute_t>> attrs;
+    for (const auto &ctx : toCreate)
+    {
+        attrs.push_back(ctx.attrs);
+    }
+
+    vector<sai_object_id_t> lag_member_ids;
+    vector<sai_status_t> statuses;
+    createLagMembers(attrs, lag_member_ids, statuses);
+
+    /* Members not created are left in m_toSync and retried */
+    for (size_t i = 0; i < toCreate.size(); i++)
+    {
+        auto &ctx = toCreate[i];
+
+        Port lag, port;
+        if (!getPort(ctx.lag_alias, lag) || !getPort(ctx.port_alias, port))
+        {
+            continue;
+        }
+
+        if (statuses[i] == SAI_STATUS_NOT_EXECUTED)
+        {
+            continue;
+        }
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64 " rv:%d",
+                    port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id, statuses[i]);
+            continue;
+        }
+
+        if (addLagMemberPost(lag, port, lag_member_ids[i]))
+        {
+            consumer.m_toSync.erase(ctx.sync_it);
+        }
+    }
 }
 
 void PortsOrch::doTask()
@@ -3180,6 +3714,9 @@ void PortsOrch::doTask()
             consumer->drain();
         }
     }
+
+    initPortsDeferredSlice();
+    generateCounterMapsSlice();
 }
 
 void PortsOrch::doTask(Consumer &consumer)
@@ -3297,8 +3834,7 @@ bool PortsOrch::initializePort(Port &port)
 
     SWSS_LOG_NOTICE("Initializing port alias:%s pid:%" PRIx64, port.m_alias.c_str(), port.m_port_id);
 
-    initializePriorityGroups(port);
-    initializeQueues(port);
+    /* The PG and queue lists, admin status and speed are set by initializePortsAttributes */
 
     /* Create host interface */
     if (!addHostIntfs(port, port.m_alias, port.m_hif_id))
@@ -3342,20 +3878,6 @@ bool PortsOrch::initializePort(Port &port)
         port.m_oper_status = SAI_PORT_OPER_STATUS_DOWN;
     }
 
-    /* initialize port admin status */
-    if (!getPortAdminStatus(port.m_port_id, port.m_admin_state_up))
-    {
-        SWSS_LOG_ERROR("Failed to get initial port admin status %s", port.m_alias.c_str());
-        return false;
-    }
-
-    /* initialize port admin speed */
-    if (!getPortSpeed(port.m_port_id, port.m_speed))
-    {
-        SWSS_LOG_ERROR("Failed to get initial port admin speed %d", port.m_speed);
-        return false;
-    }
-
     /*
      * always initialize Port SAI_HOSTIF_ATTR_OPER_STATUS based on oper_status value in appDB.
      */
@@ -3888,7 +4410,11 @@ void PortsOrch::getLagMember(Port &lag, vector<Port> &portv)
     }
 }
 
-bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
+/*
+ * Build the attributes of a new LAG member, the member is created by the bulk
+ * create of doLagMemberTask and completed by addLagMemberPost.
+ */
+void PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding, vector<sai_attribute_t> &attrs)
 {
     SWSS_LOG_ENTER();
 
@@ -3899,7 +4425,6 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
     }
 
     sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
 
     attr.id = SAI_LAG_MEMBER_ATTR_LAG_ID;
     attr.value.oid = lag.m_lag_id;
@@ -3919,16 +4444,11 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
         attr.value.booldata = true;
         attrs.push_back(attr);
     }
+}
 
-    sai_object_id_t lag_member_id;
-    sai_status_t status = sai_lag_api->create_lag_member(&lag_member_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
-
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
-                port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id);
-        return false;
-    }
+bool PortsOrch::addLagMemberPost(Port &lag, Port &port, sai_object_id_t lag_member_id)
+{
+    SWSS_LOG_ENTER();
 
     SWSS_LOG_NOTICE("Add member %s to LAG %s lid:%" PRIx64 " pid:%" PRIx64,
             port.m_alias.c_str(), lag.m_alias.c_str(), lag.m_lag_id, port.m_port_id);
@@ -3956,6 +4476,61 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
     return true;
 }
 
+/*
+ * Create LAG members, one per entry of attrs, with a single bulk call. Falls
+ * back to creating them one by one if the SAI does not implement the bulk
+ * create, stops at the first failure either way.
+ */
+bool PortsOrch::createLagMembers(const vector<vector<sai_attribute_t>> &attrs,
+                                 vector<sai_object_id_t> &lag_member_ids, vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count = static_cast<uint32_t>(attrs.size());
+    lag_member_ids.assign(count, SAI_NULL_OBJECT_ID);
+    statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
+    if (count == 0)
+    {
+        return true;
+    }
+
+    if (m_lagMemberBulkCreateSupported && sai_lag_api->create_lag_members != NULL)
+    {
+        vector<uint32_t> attr_counts(count);
+        vector<const sai_attribute_t *> attr_lists(count);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            attr_counts[i] = static_cast<uint32_t>(attrs[i].size());
+            attr_lists[i] = attrs[i].data();
+        }
+
+        sai_status_t status = sai_lag_api->create_lag_members(gSwitchId, count, attr_counts.data(), attr_lists.data(),
+                                                              SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, lag_member_ids.data(), statuses.data());
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return status == SAI_STATUS_SUCCESS;
+        }
+
+        SWSS_LOG_NOTICE("LAG member bulk create is not supported, creating them one by one");
+        m_lagMemberBulkCreateSupported = false;
+        lag_member_ids.assign(count, SAI_NULL_OBJECT_ID);
+        statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        statuses[i] = sai_lag_api->create_lag_member(&lag_member_ids[i], gSwitchId,
+                                                     static_cast<uint32_t>(attrs[i].size()), attrs[i].data());
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool PortsOrch::removeLagMember(Port &lag, Port &port)
 {
     sai_status_t status = sai_lag_api->remove_lag_member(port.m_lag_member_id);
@@ -4082,11 +4657,12 @@ void PortsOrch::generateQueueMap()
         return;
     }
 
+    /* The maps are generated from doTask(), so that they don't hold up port bring-up */
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
         {
-            generateQueueMapPerPort(it.second);
+            m_pendingQueueMapPorts.push_back(it.first);
         }
     }
 
@@ -4102,6 +4678,20 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
     vector<FieldValueTuple> queueIndexVector;
     vector<FieldValueTuple> queueTypeVector;
 
+    map<sai_object_id_t, pair<string, uint8_t>> queueInfo;
+    getQueuesTypeAndIndex(port.m_queue_ids, queueInfo);
+
+    string delimiter("");
+    std::ostringstream counters_stream;
+    for (const auto& it: queueWatermarkStatIds)
+    {
+        counters_stream << delimiter << sai_serialize_queue_stat(it);
+        delimiter = comma;
+    }
+
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
+
     for (size_t queueIndex = 0; queueIndex < port.m_queue_ids.size(); ++queueIndex)
     {
         std::ostringstream name;
@@ -4112,43 +4702,36 @@ void PortsOrch::generateQueueMapPerPort(const Port& port)
         queueVector.emplace_back(name.str(), id);
         queuePortVector.emplace_back(id, sai_serialize_object_id(port.m_port_id));
 
-        string queueType;
-        uint8_t queueRealIndex = 0;
-        if (getQueueTypeAndIndex(port.m_queue_ids[queueIndex], queueType, queueRealIndex))
-        {
-            queueTypeVector.emplace_back(id, queueType);
-            queueIndexVector.emplace_back(id, to_string(queueRealIndex));
-        }
+        CounterSnapshotOrch::getInstance().addObject(CounterSnapshotGroup::QUEUE, id);
 
-        // Install a flex counter for this queue to track stats
-        std::unordered_set<string> counter_stats;
-        for (const auto& it: queue_stat_ids)
+        auto info = queueInfo.find(port.m_queue_ids[queueIndex]);
+        if (info != queueInfo.end())
         {
-            counter_stats.emplace(sai_serialize_queue_stat(it));
+            queueTypeVector.emplace_back(id, info->second.first);
+            queueIndexVector.emplace_back(id, to_string(info->second.second));
         }
-        queue_stat_manager.setCounterIdList(port.m_queue_ids[queueIndex], CounterType::QUEUE, counter_stats);
 
         /* add watermark queue counters */
         string key = getQueueWatermarkFlexCounterTableKey(id);
 
-        string delimiter("");
-        std::ostringstream counters_stream;
-        for (const auto& it: queueWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_queue_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, counters_stream.str());
+        m_flexCounterBufferedTable->set(key, fieldValues);
+    }
 
-        m_flexCounterTable->set(key, fieldValues);
+    // Install a flex counter for the queues to track stats
+    std::unordered_set<string> counter_stats;
+    for (const auto& it: queue_stat_ids)
+    {
+        counter_stats.emplace(sai_serialize_queue_stat(it));
     }
+    queue_stat_manager.setCounterIdList(port.m_queue_ids, CounterType::QUEUE, counter_stats);
+
+    m_flexCounterBufferedTable->flush();
 
     m_queueTable->set("", queueVector);
     m_queuePortTable->set("", queuePortVector);
     m_queueIndexTable->set("", queueIndexVector);
     m_queueTypeTable->set("", queueTypeVector);
+    m_counterMapPipeline->flush();
 
     CounterCheckOrch::getInstance().addPort(port);
 }
@@ -4160,11 +4743,12 @@ void PortsOrch::generatePriorityGroupMap()
         return;
     }
 
+    /* The maps are generated from doTask(), so that they don't hold up port bring-up */
     for (const auto& it: m_portList)
     {
         if (it.second.m_type == Port::PHY)
         {
-            generatePriorityGroupMapPerPort(it.second);
+            m_pendingPriorityGroupMapPorts.push_back(it.first);
         }
     }
 
@@ -4179,6 +4763,18 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port)
     vector<FieldValueTuple> pgPortVector;
     vector<FieldValueTuple> pgIndexVector;
 
+    std::string delimiter = "";
+    std::ostringstream counters_stream;
+    /* Add watermark counters to flex_counter */
+    for (const auto& it: ingressPriorityGroupWatermarkStatIds)
+    {
+        counters_stream << delimiter << sai_serialize_ingress_priority_group_stat(it);
+        delimiter = comma;
+    }
+
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back(PG_COUNTER_ID_LIST, counters_stream.str());
+
     for (size_t pgIndex = 0; pgIndex < port.m_priority_group_ids.size(); ++pgIndex)
     {
         std::ostringstream name;
@@ -4192,28 +4788,89 @@ void PortsOrch::generatePriorityGroupMapPerPort(const Port& port)
 
         string key = getPriorityGroupWatermarkFlexCounterTableKey(id);
 
-        std::string delimiter = "";
-        std::ostringstream counters_stream;
-        /* Add watermark counters to flex_counter */
-        for (const auto& it: ingressPriorityGroupWatermarkStatIds)
-        {
-            counters_stream << delimiter << sai_serialize_ingress_priority_group_stat(it);
-            delimiter = comma;
-        }
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(PG_COUNTER_ID_LIST, counters_stream.str());
-
-        m_flexCounterTable->set(key, fieldValues);
+        m_flexCounterBufferedTable->set(key, fieldValues);
     }
 
+    m_flexCounterBufferedTable->flush();
+
     m_pgTable->set("", pgVector);
     m_pgPortTable->set("", pgPortVector);
     m_pgIndexTable->set("", pgIndexVector);
+    m_counterMapPipeline->flush();
 
     CounterCheckOrch::getInstance().addPort(port);
 }
 
+/*
+ * Generate the queue and PG maps of the next few pending ports. Called on
+ * every iteration of the main loop so that a large port count is spread over
+ * several iterations instead of stalling the other tasks.
+ */
+void PortsOrch::generateCounterMapsSlice()
+{
+    if (m_pendingQueueMapPorts.empty() && m_pendingPriorityGroupMapPorts.empty())
+    {
+        return;
+    }
+
+    if (!allPortsReady())
+    {
+        return;
+    }
+
+    for (int i = 0; i < COUNTER_MAP_PORTS_PER_ITERATION && !m_pendingQueueMapPorts.empty(); i++)
+    {
+        /* The port might have been removed while waiting */
+        auto it = m_portList.find(m_pendingQueueMapPorts.front());
+        if (it != m_portList.end())
+        {
+            generateQueueMapPerPort(it->second);
+        }
+        m_pendingQueueMapPorts.pop_front();
+    }
+
+    for (int i = 0; i < COUNTER_MAP_PORTS_PER_ITERATION && !m_pendingPriorityGroupMapPorts.empty(); i++)
+    {
+        auto it = m_portList.find(m_pendingPriorityGroupMapPorts.front());
+        if (it != m_portList.end())
+        {
+            generatePriorityGroupMapPerPort(it->second);
+        }
+        m_pendingPriorityGroupMapPorts.pop_front();
+    }
+}
+
+void PortsOrch::updateQueueCounterPollInterval(uint32_t interval)
+{
+    SWSS_LOG_ENTER();
+
+    queue_stat_manager.updateGroupPollingInterval(interval);
+}
+
+void PortsOrch::updateQueueCounterStatus(bool enabled)
+{
+    SWSS_LOG_ENTER();
+
+    if (enabled)
+    {
+        queue_stat_manager.enableFlexCounterGroup();
+    }
+    else
+    {
+        queue_stat_manager.disableFlexCounterGroup();
+    }
+}
+
+void PortsOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (&timer == m_queueCounterTierTimer)
+    {
+        queue_stat_manager.evaluateTiers();
+    }
+}
+
 void PortsOrch::doTask(NotificationConsumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -4426,27 +5083,46 @@ bool PortsOrch::removeAclTableGroup(const Port &p)
     return true;
 }
 
-bool PortsOrch::setPortSerdesAttribute(sai_object_id_t port_id, sai_attr_id_t attr_id,
-                                       vector<uint32_t> &serdes_val)
+/*
+ * Set all the serdes attributes of a port with one bulk set, the port id is
+ * repeated once per attribute.
+ */
+bool PortsOrch::setPortSerdesAttributes(sai_object_id_t port_id, map<sai_port_attr_t, vector<uint32_t>> &serdes_attrs)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
+    vector<sai_object_id_t> port_ids;
+    vector<sai_attribute_t> attrs;
+
+    for (auto &it : serdes_attrs)
+    {
+        sai_attribute_t attr;
 
-    memset(&attr, 0, sizeof(attr));
-    attr.id = attr_id;
+        memset(&attr, 0, sizeof(attr));
+        attr.id = it.first;
 
-    attr.value.u32list.count = (uint32_t)serdes_val.size();
-    attr.value.u32list.list = serdes_val.data();
+        attr.value.u32list.count = (uint32_t)it.second.size();
+        attr.value.u32list.list = it.second.data();
 
-    sai_status_t status = sai_port_api->set_port_attribute(port_id, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+        port_ids.push_back(port_id);
+        attrs.push_back(attr);
+    }
+
+    vector<sai_status_t> statuses;
+    if (setPortsAttribute(port_ids, attrs, statuses))
     {
-        SWSS_LOG_ERROR("Failed to set serdes attribute %d to port pid:%" PRIx64,
-                       attr_id, port_id);
-        return false;
+        return true;
     }
-    return true;
+
+    for (size_t i = 0; i < statuses.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS && statuses[i] != SAI_STATUS_NOT_EXECUTED)
+        {
+            SWSS_LOG_ERROR("Failed to set serdes attribute %d to port pid:%" PRIx64,
+                           attrs[i].id, port_id);
+        }
+    }
+    return false;
 }
 
 void PortsOrch::getPortSerdesVal(const std::string& val_str,
@@ -4542,8 +5218,12 @@ void PortsOrch::initGearbox()
 bool PortsOrch::initGearboxPort(Port &port)
 {
     vector<sai_attribute_t> attrs;
-    vector<uint32_t> lanes;
-    vector<uint32_t> vals;
+    vector<sai_attribute_t> systemAttrs;
+    vector<sai_attribute_t> lineAttrs;
+    vector<uint32_t> systemLanes;
+    vector<uint32_t> lineLanes;
+    vector<uint32_t> adverSpeeds;
+    vector<uint32_t> adverFecs;
     sai_attribute_t attr;
     sai_object_id_t systemPort;
     sai_object_id_t linePort;
@@ -4572,137 +5252,141 @@ bool PortsOrch::initGearboxPort(Port &port)
 
             sai_deserialize_object_id(phyOidStr, phyOid);
 
-            /* Create SYSTEM-SIDE port */
-            attrs.clear();
+            /* SYSTEM-SIDE port attributes */
 
             attr.id = SAI_PORT_ATTR_ADMIN_STATE;
             attr.value.booldata = port.m_admin_state_up;
-            attrs.push_back(attr);
+            systemAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_SPEED;
             attr.value.u32 = (uint32_t) m_gearboxPortMap[port.m_index].system_speed;
             if (isSpeedSupported(port.m_alias, port.m_port_id, attr.value.u32))
             {
-                attrs.push_back(attr);
+                systemAttrs.push_back(attr);
             }
 
             attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
             attr.value.booldata = m_gearboxPortMap[port.m_index].system_auto_neg;
-            attrs.push_back(attr);
+            systemAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_FEC_MODE;
             attr.value.s32 = fec_mode_map[m_gearboxPortMap[port.m_index].system_fec];
-            attrs.push_back(attr);
+            systemAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_INTERNAL_LOOPBACK_MODE;
             attr.value.u32 = loopback_mode_map[m_gearboxPortMap[port.m_index].system_loopback];
-            attrs.push_back(attr);
+            systemAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_LINK_TRAINING_ENABLE;
             attr.value.booldata = m_gearboxPortMap[port.m_index].system_training;
-            attrs.push_back(attr);
+            systemAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
-            lanes.assign(m_gearboxInterfaceMap[port.m_index].system_lanes.begin(), m_gearboxInterfaceMap[port.m_index].system_lanes.end());
-            attr.value.u32list.list = lanes.data();
-            attr.value.u32list.count = static_cast<uint32_t>(lanes.size());
-            attrs.push_back(attr);
+            systemLanes.assign(m_gearboxInterfaceMap[port.m_index].system_lanes.begin(), m_gearboxInterfaceMap[port.m_index].system_lanes.end());
+            attr.value.u32list.list = systemLanes.data();
+            attr.value.u32list.count = static_cast<uint32_t>(systemLanes.size());
+            systemAttrs.push_back(attr);
 
             for (uint32_t i = 0; i < attr.value.u32list.count; i++)
             {
                 SWSS_LOG_DEBUG("BOX: list[%d] = %d", i, attr.value.u32list.list[i]);
             }
 
-            status = sai_port_api->create_port(&systemPort, phyOid, static_cast<uint32_t>(attrs.size()), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("BOX: Failed to create Gearbox system-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
-                        port.m_alias.c_str(), port.m_port_id, port.m_index, status);
-                return false;
-            }
-            SWSS_LOG_NOTICE("BOX: Created Gearbox system-side port 0x%" PRIx64 " for alias:%s index:%d",
-                    systemPort, port.m_alias.c_str(), port.m_index);
-
-            /* Create LINE-SIDE port */
-            attrs.clear();
+            /* LINE-SIDE port attributes */
 
             attr.id = SAI_PORT_ATTR_ADMIN_STATE;
             attr.value.booldata = port.m_admin_state_up;
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_SPEED;
             attr.value.u32 = (uint32_t) m_gearboxPortMap[port.m_index].line_speed;
             if (isSpeedSupported(port.m_alias, port.m_port_id, attr.value.u32))
             {
-                attrs.push_back(attr);
+                lineAttrs.push_back(attr);
             }
 
             attr.id = SAI_PORT_ATTR_AUTO_NEG_MODE;
             attr.value.booldata = m_gearboxPortMap[port.m_index].line_auto_neg;
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_FEC_MODE;
             attr.value.s32 = fec_mode_map[m_gearboxPortMap[port.m_index].line_fec];
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_MEDIA_TYPE;
             attr.value.u32 = media_type_map[m_gearboxPortMap[port.m_index].line_media_type];
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_INTERNAL_LOOPBACK_MODE;
             attr.value.u32 = loopback_mode_map[m_gearboxPortMap[port.m_index].line_loopback];
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_LINK_TRAINING_ENABLE;
             attr.value.booldata = m_gearboxPortMap[port.m_index].line_training;
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_INTERFACE_TYPE;
             attr.value.u32 = interface_type_map[m_gearboxPortMap[port.m_index].line_intf_type];
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_ADVERTISED_SPEED;
-            vals.assign(m_gearboxPortMap[port.m_index].line_adver_speed.begin(), m_gearboxPortMap[port.m_index].line_adver_speed.end());
-            attr.value.u32list.list = vals.data();
-            attr.value.u32list.count = static_cast<uint32_t>(vals.size());
-            attrs.push_back(attr);
+            adverSpeeds.assign(m_gearboxPortMap[port.m_index].line_adver_speed.begin(), m_gearboxPortMap[port.m_index].line_adver_speed.end());
+            attr.value.u32list.list = adverSpeeds.data();
+            attr.value.u32list.count = static_cast<uint32_t>(adverSpeeds.size());
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_ADVERTISED_FEC_MODE;
-            vals.assign(m_gearboxPortMap[port.m_index].line_adver_fec.begin(), m_gearboxPortMap[port.m_index].line_adver_fec.end());
-            attr.value.u32list.list = vals.data();
-            attr.value.u32list.count = static_cast<uint32_t>(vals.size());
-            attrs.push_back(attr);
+            adverFecs.assign(m_gearboxPortMap[port.m_index].line_adver_fec.begin(), m_gearboxPortMap[port.m_index].line_adver_fec.end());
+            attr.value.u32list.list = adverFecs.data();
+            attr.value.u32list.count = static_cast<uint32_t>(adverFecs.size());
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_ADVERTISED_AUTO_NEG_MODE;
             attr.value.booldata = m_gearboxPortMap[port.m_index].line_adver_auto_neg;
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_ADVERTISED_ASYMMETRIC_PAUSE_MODE;
             attr.value.booldata = m_gearboxPortMap[port.m_index].line_adver_asym_pause;
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_ADVERTISED_MEDIA_TYPE;
             attr.value.u32 = media_type_map[m_gearboxPortMap[port.m_index].line_adver_media_type];
-            attrs.push_back(attr);
+            lineAttrs.push_back(attr);
 
             attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
-            lanes.assign(m_gearboxInterfaceMap[port.m_index].line_lanes.begin(), m_gearboxInterfaceMap[port.m_index].line_lanes.end());
-            attr.value.u32list.list = lanes.data();
-            attr.value.u32list.count = static_cast<uint32_t>(lanes.size());
-            attrs.push_back(attr);
+            lineLanes.assign(m_gearboxInterfaceMap[port.m_index].line_lanes.begin(), m_gearboxInterfaceMap[port.m_index].line_lanes.end());
+            attr.value.u32list.list = lineLanes.data();
+            attr.value.u32list.count = static_cast<uint32_t>(lineLanes.size());
+            lineAttrs.push_back(attr);
 
             for (uint32_t i = 0; i < attr.value.u32list.count; i++)
             {
                 SWSS_LOG_DEBUG("BOX: list[%d] = %d", i, attr.value.u32list.list[i]);
             }
 
-            status = sai_port_api->create_port(&linePort, phyOid, static_cast<uint32_t>(attrs.size()), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
+            /* Both sides are created with one bulk call on the PHY */
+            vector<vector<sai_attribute_t>> portAttrs = { systemAttrs, lineAttrs };
+            vector<sai_object_id_t> phyPorts;
+            vector<sai_status_t> statuses;
+
+            createPorts(phyOid, portAttrs, phyPorts, statuses);
+            if (statuses[0] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("BOX: Failed to create Gearbox system-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
+                        port.m_alias.c_str(), port.m_port_id, port.m_index, statuses[0]);
+                return false;
+            }
+            systemPort = phyPorts[0];
+            SWSS_LOG_NOTICE("BOX: Created Gearbox system-side port 0x%" PRIx64 " for alias:%s index:%d",
+                    systemPort, port.m_alias.c_str(), port.m_index);
+
+            if (statuses[1] != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("BOX: Failed to create Gearbox line-side port for alias:%s port_id:0x%" PRIx64 " index:%d status:%d",
-                   port.m_alias.c_str(), port.m_port_id, port.m_index, status);
+                   port.m_alias.c_str(), port.m_port_id, port.m_index, statuses[1]);
                 return false;
             }
+            linePort = phyPorts[1];
             SWSS_LOG_NOTICE("BOX: Created Gearbox line-side port 0x%" PRIx64 " for alias:%s index:%d",
                 linePort, port.m_alias.c_str(), port.m_index);
 
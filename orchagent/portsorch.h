@@ -2,6 +2,8 @@
 #define SWSS_PORTSORCH_H
 
 #include <map>
+#include <deque>
+#include <chrono>
 
 #include "acltable.h"
 #include "orch.h"
@@ -10,6 +12,7 @@
 #include "macaddress.h"
 #include "producertable.h"
 #include "flex_counter_manager.h"
+#include "tiered_flex_counter_manager.h"
 #include "gearboxutils.h"
 #include "saihelper.h"
 
@@ -23,6 +26,8 @@
 #define QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP "QUEUE_WATERMARK_STAT_COUNTER"
 #define PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP "PG_WATERMARK_STAT_COUNTER"
 
+#define STATE_PORT_INIT_STATS_TABLE_NAME "PORT_INIT_STATS_TABLE"
+
 
 typedef std::vector<sai_uint32_t> PortSupportedSpeeds;
 
@@ -63,6 +68,15 @@ struct LagMemberUpdate
     bool add;
 };
 
+/* A LAG member waiting for the bulk create of doLagMemberTask */
+struct LagMemberBulkContext
+{
+    SyncMap::iterator sync_it;
+    string lag_alias;
+    string port_alias;
+    vector<sai_attribute_t> attrs;
+};
+
 struct VlanMemberUpdate
 {
     Port vlan;
@@ -121,6 +135,8 @@ public:
 
     void generateQueueMap();
     void generatePriorityGroupMap();
+    void updateQueueCounterPollInterval(uint32_t interval);
+    void updateQueueCounterStatus(bool enabled);
 
     void refreshPortStatus();
     bool removeAclTableGroup(const Port &p);
@@ -158,16 +174,23 @@ private:
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
+    /* Buffered writers used while generating the queue and PG maps */
+    unique_ptr<RedisPipeline> m_counterMapPipeline;
+    unique_ptr<RedisPipeline> m_flexCounterPipeline;
+    unique_ptr<ProducerTable> m_flexCounterBufferedTable;
+
     std::string getQueueWatermarkFlexCounterTableKey(std::string s);
     std::string getPriorityGroupWatermarkFlexCounterTableKey(std::string s);
     std::string getPortRateFlexCounterTableKey(std::string s);
 
     shared_ptr<DBConnector> m_counter_db;
     shared_ptr<DBConnector> m_flex_db;
+    shared_ptr<DBConnector> m_state_db;
 
     FlexCounterManager port_stat_manager;
     FlexCounterManager port_buffer_drop_stat_manager;
-    FlexCounterManager queue_stat_manager;
+    TieredFlexCounterManager queue_stat_manager;
+    SelectableTimer *m_queueCounterTierTimer = nullptr;
 
     std::map<sai_object_id_t, PortSupportedSpeeds> m_portSupportedSpeeds;
 
@@ -218,6 +241,7 @@ private:
     void doLagMemberTask(Consumer &consumer);
 
     void doTask(NotificationConsumer &consumer);
+    void doTask(SelectableTimer &timer);
 
     void removePortFromLanesMap(string alias);
     void removePortFromPortListMap(sai_object_id_t port_id);
@@ -238,16 +262,39 @@ private:
 
     bool addLag(string lag);
     bool removeLag(Port lag);
-    bool addLagMember(Port &lag, Port &port, bool enableForwarding);
+    void addLagMember(Port &lag, Port &port, bool enableForwarding, vector<sai_attribute_t> &attrs);
+    bool addLagMemberPost(Port &lag, Port &port, sai_object_id_t lag_member_id);
+    bool createLagMembers(const vector<vector<sai_attribute_t>> &attrs,
+                          vector<sai_object_id_t> &lag_member_ids, vector<sai_status_t> &statuses);
+    bool m_lagMemberBulkCreateSupported = true;
     bool removeLagMember(Port &lag, Port &port);
     bool setCollectionOnLagMember(Port &lagMember, bool enableCollection);
     bool setDistributionOnLagMember(Port &lagMember, bool enableDistribution);
 
     bool addPort(const set<int> &lane_set, uint32_t speed, int an=0, string fec="");
     sai_status_t removePort(sai_object_id_t port_id);
-    bool initPort(const string &alias, const int index, const set<int> &lane_set);
+    bool initPorts();
+    bool initializePortsAttributes(vector<Port> &ports);
+    bool m_portBulkGetSupported = true;
     void deInitPort(string alias, sai_object_id_t port_id);
 
+    /*
+     * The counter maps, flex counters and gearbox ports of the initialized
+     * ports are set up a few ports per iteration of the main loop, or when
+     * the port is first configured
+     */
+    deque<string> m_pendingPortInitPorts;
+    unordered_set<string> m_pendingPortInitSet;
+    void initPortDeferred(const string &alias);
+    void initPortsDeferredSlice();
+
+    /* Time spent in each port initialization stage, in microseconds */
+    std::chrono::steady_clock::time_point m_portInitStart;
+    map<string, uint64_t> m_portInitStageTime;
+    unique_ptr<Table> m_portInitStatsTable;
+    void addPortInitStageTime(const string &stage, std::chrono::steady_clock::time_point start);
+    void updatePortInitStats();
+
     bool setPortAdminStatus(Port &port, bool up);
     bool getPortAdminStatus(sai_object_id_t id, bool& up);
     bool setPortMtu(sai_object_id_t id, sai_uint32_t mtu);
@@ -263,11 +310,29 @@ private:
     bool setPortSpeed(Port &port, sai_uint32_t speed);
     bool getPortSpeed(sai_object_id_t id, sai_uint32_t &speed);
     bool setGearboxPortsAttr(Port &port, sai_port_attr_t id, void *value);
-    bool setGearboxPortAttr(Port &port, dest_port_type_t port_type, sai_port_attr_t id, void *value);
+    bool getGearboxPortAttr(Port &port, dest_port_type_t port_type, sai_port_attr_t id, void *value,
+                            sai_object_id_t &dest_port_id, sai_attribute_t &attr);
+
+    bool setPortsAttribute(const vector<sai_object_id_t> &port_ids, const vector<sai_attribute_t> &attrs,
+                           vector<sai_status_t> &statuses);
+    bool m_portBulkSetSupported = true;
+    bool createPorts(sai_object_id_t switch_id, const vector<vector<sai_attribute_t>> &attrs,
+                     vector<sai_object_id_t> &port_ids, vector<sai_status_t> &statuses);
+    bool m_portBulkCreateSupported = true;
 
     bool setPortAdvSpeed(sai_object_id_t port_id, sai_uint32_t speed);
 
     bool getQueueTypeAndIndex(sai_object_id_t queue_id, string &type, uint8_t &index);
+    void getQueuesTypeAndIndex(const vector<sai_object_id_t> &queue_ids, map<sai_object_id_t, pair<string, uint8_t>> &queue_info);
+    bool m_queueBulkGetSupported = true;
+
+    /*
+     * The maps are generated a few ports per iteration of the main loop,
+     * the aliases of the ports still waiting for their maps are queued here
+     */
+    deque<string> m_pendingQueueMapPorts;
+    deque<string> m_pendingPriorityGroupMapPorts;
+    void generateCounterMapsSlice();
 
     bool m_isQueueMapGenerated = false;
     void generateQueueMapPerPort(const Port& port);
@@ -283,8 +348,7 @@ private:
 
     void getPortSerdesVal(const std::string& s, std::vector<uint32_t> &lane_values);
 
-    bool setPortSerdesAttribute(sai_object_id_t port_id, sai_attr_id_t attr_id,
-                                vector<uint32_t> &serdes_val);
+    bool setPortSerdesAttributes(sai_object_id_t port_id, map<sai_port_attr_t, vector<uint32_t>> &serdes_attrs);
     bool getSaiAclBindPointType(Port::Type                type,
                                 sai_acl_bind_point_type_t &sai_acl_bind_type);
     void initGearbox();
@@ -359,9 +359,16 @@ void RouteOrch::doPrefixTask(Consumer& consumer)
 {
     SWSS_LOG_ENTER();
 
+    unparkConsumer(consumer);
+    m_crmExhausted.clear();
+    m_crmParkedCount = 0;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
+        // CRM counters are updated after the bulk is flushed
+        m_crmAdmitted.clear();
+
         // Route bulk results will be stored in a map
         std::map<
                 std::pair<
@@ -665,7 +672,9 @@ void RouteOrch::doPrefixTask(Consumer& consumer)
                     /* subnet route, vrf leaked route, etc */
                     else
                     {
-                        if (addRoute(ctx, nhg))
+                        if (!admitRoute(ctx))
+                            it++;
+                        else if (addRoute(ctx, nhg))
                             it = consumer.m_toSync.erase(it);
                         else
                             it++;
@@ -681,7 +690,9 @@ void RouteOrch::doPrefixTask(Consumer& consumer)
                     m_syncdRoutes.at(vrf_id).at(ip_prefix) != RouteNhg(nhg, ctx.nhg_index) ||
                     ctx.is_temp)
                 {
-                    if (addRoute(ctx, nhg))
+                    if (!admitRoute(ctx))
+                        it++;
+                    else if (addRoute(ctx, nhg))
                         it = consumer.m_toSync.erase(it);
                     else
                         it++;
@@ -695,7 +706,7 @@ void RouteOrch::doPrefixTask(Consumer& consumer)
 
                 // If already exhaust the nexthop groups, and there are pending removing routes in bulker,
                 // flush the bulker and possibly collect some released nexthop groups
-                if (gNhgOrch->getSyncedNhgCount() >= gNhgOrch->getMaxNhgCount() &&
+                if (gNhgOrch->isNhgExhausted() &&
                     gRouteBulker.removing_entries_count() > 0)
                 {
                     break;
@@ -802,6 +813,46 @@ void RouteOrch::doPrefixTask(Consumer& consumer)
             }
         }
     }
+
+    /*
+     * If all the pending routes are waiting for free route entries, don't
+     * retry them on every loop, but only once some entries are freed.
+     */
+    if (!m_crmExhausted.empty() && m_crmParkedCount == consumer.m_toSync.size())
+    {
+        SWSS_LOG_NOTICE("%zu routes are waiting for route resources", m_crmParkedCount);
+
+        auto exhausted = m_crmExhausted;
+        parkConsumer(consumer, [exhausted]() { return gCrmOrch->isAnyCrmResAvailable(exhausted); });
+    }
+}
+
+/*
+ * Check the predicted CRM availability before a new route entry is
+ * programmed, rather than finding out from a failed create.
+ */
+bool RouteOrch::admitRoute(const RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    auto vrf = m_syncdRoutes.find(ctx.vrf_id);
+    if (vrf != m_syncdRoutes.end() && vrf->second.find(ctx.ip_prefix) != vrf->second.end())
+    {
+        return true;
+    }
+
+    auto resource = ctx.ip_prefix.isV4() ? CrmResourceType::CRM_IPV4_ROUTE : CrmResourceType::CRM_IPV6_ROUTE;
+    uint32_t &admitted = m_crmAdmitted[resource];
+    if (!gCrmOrch->isCrmResAvailable(resource, admitted + 1))
+    {
+        SWSS_LOG_INFO("No resources left for route %s", ctx.ip_prefix.to_string().c_str());
+        m_crmExhausted.insert(resource);
+        m_crmParkedCount++;
+        return false;
+    }
+
+    admitted++;
+    return true;
 }
 
 void RouteOrch::doLabelTask(Consumer& consumer)
@@ -1081,7 +1132,7 @@ void RouteOrch::doLabelTask(Consumer& consumer)
 
                 // If already exhaust the nexthop groups, and there are pending removing routes in bulker,
                 // flush the bulker and possibly collect some released nexthop groups
-                if (gNhgOrch->getSyncedNhgCount() >= gNhgOrch->getMaxNhgCount() &&
+                if (gNhgOrch->isNhgExhausted() &&
                     gRouteBulker.removing_entries_count() > 0)
                 {
                     break;
@@ -1383,7 +1434,7 @@ bool RouteOrch::createFineGrainedNextHopGroup(sai_object_id_t &next_hop_group_id
 {
     SWSS_LOG_ENTER();
 
-    if (gNhgOrch->getSyncedNhgCount() >= gNhgOrch->getMaxNhgCount())
+    if (gNhgOrch->isNhgExhausted())
     {
         SWSS_LOG_DEBUG("Failed to create new next hop group. \
                 Reaching maximum number of next hop groups.");
@@ -1430,7 +1481,7 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
 
     assert(!hasNextHopGroup(nexthops));
 
-    if (gNhgOrch->getSyncedNhgCount() >= gNhgOrch->getMaxNhgCount())
+    if (gNhgOrch->isNhgExhausted())
     {
         SWSS_LOG_WARN("Reached maximum next hop groups of %u",
                         gNhgOrch->getMaxNhgCount());
@@ -14,6 +14,7 @@
 #include "nexthopgroupkey.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
+#include "crmorch.h"
 #include <map>
 
 /* Maximum next hop group number */
@@ -198,6 +199,14 @@ private:
 
     std::set<NextHopGroupKey> m_bulkNhgReducedRefCnt;
 
+    /*
+     * New route entries admitted against the CRM prediction in the current
+     * bulk, and the route resources which pending routes are waiting for
+     */
+    std::map<CrmResourceType, uint32_t> m_crmAdmitted;
+    std::set<CrmResourceType> m_crmExhausted;
+    size_t m_crmParkedCount = 0;
+
     NextHopObserverTable m_nextHopObservers;
 
     EntityBulker<sai_route_api_t>           gRouteBulker;
@@ -205,6 +214,7 @@ private:
     ObjectBulker<sai_next_hop_group_api_t>  gNextHopGroupMemberBulker;
 
     void addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
+    bool admitRoute(const RouteBulkContext& ctx);
     bool addRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
     bool removeRoute(RouteBulkContext& ctx);
     bool addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
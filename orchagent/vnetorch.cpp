@@ -546,75 +546,205 @@ bool VNetOrch::delOperation(const Request& request)
  * Vnet Route Handling
  */
 
-static bool del_route(sai_object_id_t vr_id, sai_ip_prefix_t& ip_pfx)
+VNetRouteOrch::VNetRouteOrch(DBConnector *db, vector<string> &tableNames, VNetOrch *vnetOrch)
+                                  : Orch2(db, tableNames, request_), vnet_orch_(vnetOrch),
+                                  route_bulker_(sai_route_api)
+{
+    SWSS_LOG_ENTER();
+
+    handler_map_.insert(handler_pair(APP_VNET_RT_TABLE_NAME, &VNetRouteOrch::handleRoutes));
+    handler_map_.insert(handler_pair(APP_VNET_RT_TUNNEL_TABLE_NAME, &VNetRouteOrch::handleTunnel));
+}
+
+void VNetRouteOrch::delRouteEntry(VNetRouteBulkContext& ctx, sai_object_id_t vr_id)
 {
     sai_route_entry_t route_entry;
     route_entry.vr_id = vr_id;
     route_entry.switch_id = gSwitchId;
-    route_entry.destination = ip_pfx;
-
-    sai_status_t status = sai_route_api->remove_route_entry(&route_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("SAI Failed to remove route");
-        return false;
-    }
-
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-    }
-    else
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
+    copy(route_entry.destination, ctx.ip_prefix);
 
-    return true;
+    ctx.vr_ids.push_back(vr_id);
+    ctx.object_statuses.emplace_back();
+    route_bulker_.remove_entry(&ctx.object_statuses.back(), &route_entry);
 }
 
-static bool add_route(sai_object_id_t vr_id, sai_ip_prefix_t& ip_pfx, sai_object_id_t nh_id)
+void VNetRouteOrch::addRouteEntry(VNetRouteBulkContext& ctx, sai_object_id_t vr_id, sai_object_id_t nh_id)
 {
     sai_route_entry_t route_entry;
     route_entry.vr_id = vr_id;
     route_entry.switch_id = gSwitchId;
-    route_entry.destination = ip_pfx;
+    copy(route_entry.destination, ctx.ip_prefix);
 
     sai_attribute_t route_attr;
 
     route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
     route_attr.value.oid = nh_id;
 
-    sai_status_t status = sai_route_api->create_route_entry(&route_entry, 1, &route_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    /* A route already pending in the bulker gets SAI_STATUS_ITEM_ALREADY_EXISTS */
+    ctx.vr_ids.push_back(vr_id);
+    ctx.object_statuses.emplace_back();
+    route_bulker_.create_entry(&ctx.object_statuses.back(), &route_entry, 1, &route_attr);
+}
+
+void VNetRouteOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    // Route bulk results will be stored in a map
+    std::map<
+            std::pair<
+                    std::string,            // Key
+                    std::string             // Op
+            >,
+            VNetRouteBulkContext
+    >                                       toBulk;
+
+    // Add or remove routes with the route bulker
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        KeyOpFieldsValuesTuple t = it->second;
+
+        auto rc = toBulk.emplace(std::piecewise_construct,
+                std::forward_as_tuple(kfvKey(t), kfvOp(t)),
+                std::forward_as_tuple());
+
+        auto& ctx = rc.first->second;
+        if (!rc.second)
+        {
+            ctx.clear();
+        }
+
+        bool erase_from_queue = true;
+        try
+        {
+            request_.parse(t);
+            auto table_name = consumer.getTableName();
+            request_.setTableName(table_name);
+            erase_from_queue = handleRequest(request_, ctx);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            SWSS_LOG_ERROR("Parse error: %s", e.what());
+        }
+        catch (const std::logic_error& e)
+        {
+            SWSS_LOG_ERROR("Logic error: %s", e.what());
+        }
+        catch (const std::exception& e)
+        {
+            SWSS_LOG_ERROR("Exception was catched in the request parser: %s", e.what());
+        }
+        catch (...)
+        {
+            SWSS_LOG_ERROR("Unknown exception was catched in the request parser");
+        }
+        request_.clear();
+
+        /* Requests with routes in the bulker are completed after the flush */
+        if (erase_from_queue && ctx.object_statuses.empty())
+        {
+            it = consumer.m_toSync.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    // Flush the route bulker, so routes will be written to syncd and ASIC
+    route_bulker_.flush();
+
+    // Go through the bulker results
+    it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        const string& key = kfvKey(it->second);
+        const string& op = kfvOp(it->second);
+
+        auto found = toBulk.find(make_pair(key, op));
+        if (found == toBulk.end() || found->second.object_statuses.empty())
+        {
+            it++;
+            continue;
+        }
+
+        if (handleRequestPost(found->second, op))
+        {
+            it = consumer.m_toSync.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+bool VNetRouteOrch::handleRequestPost(VNetRouteBulkContext& ctx, const string& op)
+{
+    SWSS_LOG_ENTER();
+
+    bool success = true;
+    for (size_t i = 0; i < ctx.object_statuses.size(); i++)
+    {
+        sai_status_t status = ctx.object_statuses[i];
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Route %s failed for %s, vr_id '0x%" PRIx64 "', rv:%d",
+                           (op == SET_COMMAND) ? "add" : "del", ctx.ip_prefix.to_string().c_str(),
+                           ctx.vr_ids[i], status);
+            success = false;
+            continue;
+        }
+
+        CrmResourceType resource = ctx.ip_prefix.isV4() ? CrmResourceType::CRM_IPV4_ROUTE : CrmResourceType::CRM_IPV6_ROUTE;
+        if (op == SET_COMMAND)
+        {
+            gCrmOrch->incCrmResUsedCounter(resource);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(resource);
+        }
+    }
+
+    /* Failed tunnel routes are retried, other routes are kept as they are */
+    if (!success && ctx.is_tunnel)
     {
-        SWSS_LOG_ERROR("SAI failed to create route");
         return false;
     }
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    if (!vnet_orch_->isVnetExists(ctx.vnet))
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        SWSS_LOG_WARN("VNET %s doesn't exist for prefix %s, op %s",
+                      ctx.vnet.c_str(), ctx.ip_prefix.to_string().c_str(), op.c_str());
+        return true;
+    }
+
+    auto *vrf_obj = vnet_orch_->getTypePtr<VNetVrfObject>(ctx.vnet);
+    if (op == SET_COMMAND)
+    {
+        if (ctx.is_tunnel)
+        {
+            vrf_obj->addRoute(ctx.ip_prefix, ctx.endp);
+        }
+        else
+        {
+            vrf_obj->addRoute(ctx.ip_prefix, ctx.nh);
+        }
     }
     else
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        vrf_obj->removeRoute(ctx.ip_prefix);
     }
 
     return true;
 }
 
-VNetRouteOrch::VNetRouteOrch(DBConnector *db, vector<string> &tableNames, VNetOrch *vnetOrch)
-                                  : Orch2(db, tableNames, request_), vnet_orch_(vnetOrch)
-{
-    SWSS_LOG_ENTER();
-
-    handler_map_.insert(handler_pair(APP_VNET_RT_TABLE_NAME, &VNetRouteOrch::handleRoutes));
-    handler_map_.insert(handler_pair(APP_VNET_RT_TUNNEL_TABLE_NAME, &VNetRouteOrch::handleTunnel));
-}
-
 template<>
 bool VNetRouteOrch::doRouteTask<VNetVrfObject>(const string& vnet, IpPrefix& ipPrefix,
-                                               tunnelEndpoint& endp, string& op)
+                                               tunnelEndpoint& endp, string& op,
+                                               VNetRouteBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -646,31 +776,29 @@ bool VNetRouteOrch::doRouteTask<VNetVrfObject>(const string& vnet, IpPrefix& ipP
     }
 
     auto *vrf_obj = vnet_orch_->getTypePtr<VNetVrfObject>(vnet);
-    sai_ip_prefix_t pfx;
-    copy(pfx, ipPrefix);
     sai_object_id_t nh_id = (op == SET_COMMAND)?vrf_obj->getTunnelNextHop(endp):SAI_NULL_OBJECT_ID;
 
+    ctx.vnet = vnet;
+    ctx.ip_prefix = ipPrefix;
+    ctx.is_tunnel = true;
+    ctx.endp = endp;
+
     for (auto vr_id : vr_set)
     {
-        if (op == SET_COMMAND && !add_route(vr_id, pfx, nh_id))
+        if (op == SET_COMMAND)
         {
-            SWSS_LOG_ERROR("Route add failed for %s, vr_id '0x%" PRIx64, ipPrefix.to_string().c_str(), vr_id);
-            return false;
+            addRouteEntry(ctx, vr_id, nh_id);
         }
-        else if (op == DEL_COMMAND && !del_route(vr_id, pfx))
+        else
         {
-            SWSS_LOG_ERROR("Route del failed for %s, vr_id '0x%" PRIx64, ipPrefix.to_string().c_str(), vr_id);
-            return false;
+            delRouteEntry(ctx, vr_id);
         }
     }
 
-    if (op == SET_COMMAND)
+    /* The VRF object is updated by handleRequestPost() once the bulker is flushed */
+    if (ctx.object_statuses.empty())
     {
-        vrf_obj->addRoute(ipPrefix, endp);
-    }
-    else
-    {
-        vrf_obj->removeRoute(ipPrefix);
+        return handleRequestPost(ctx, op);
     }
 
     return true;
@@ -678,7 +806,8 @@ bool VNetRouteOrch::doRouteTask<VNetVrfObject>(const string& vnet, IpPrefix& ipP
 
 template<>
 bool VNetRouteOrch::doRouteTask<VNetVrfObject>(const string& vnet, IpPrefix& ipPrefix,
-                                               nextHop& nh, string& op)
+                                               nextHop& nh, string& op,
+                                               VNetRouteBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -743,8 +872,6 @@ bool VNetRouteOrch::doRouteTask<VNetVrfObject>(const string& vnet, IpPrefix& ipP
         l_fn(peer);
     }
 
-    sai_ip_prefix_t pfx;
-    copy(pfx, ipPrefix);
     sai_object_id_t nh_id=SAI_NULL_OBJECT_ID;
 
     if (is_subnet)
@@ -772,37 +899,36 @@ bool VNetRouteOrch::doRouteTask<VNetVrfObject>(const string& vnet, IpPrefix& ipP
         return true;
     }
 
+    ctx.vnet = vnet;
+    ctx.ip_prefix = ipPrefix;
+    ctx.nh = nh;
+
     for (auto vr_id : vr_set)
     {
         if (vr_id == SAI_NULL_OBJECT_ID)
         {
             continue;
         }
-        if (op == SET_COMMAND && !add_route(vr_id, pfx, nh_id))
+        if (op == SET_COMMAND)
         {
-            SWSS_LOG_INFO("Route add failed for %s", ipPrefix.to_string().c_str());
-            break;
+            addRouteEntry(ctx, vr_id, nh_id);
         }
-        else if (op == DEL_COMMAND && !del_route(vr_id, pfx))
+        else
         {
-            SWSS_LOG_INFO("Route del failed for %s", ipPrefix.to_string().c_str());
-            break;
+            delRouteEntry(ctx, vr_id);
         }
     }
 
-    if (op == SET_COMMAND)
+    /* The VRF object is updated by handleRequestPost() once the bulker is flushed */
+    if (ctx.object_statuses.empty())
     {
-        vrf_obj->addRoute(ipPrefix, nh);
-    }
-    else
-    {
-        vrf_obj->removeRoute(ipPrefix);
+        return handleRequestPost(ctx, op);
     }
 
     return true;
 }
 
-bool VNetRouteOrch::handleRoutes(const Request& request)
+bool VNetRouteOrch::handleRoutes(const Request& request, VNetRouteBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -846,7 +972,7 @@ bool VNetRouteOrch::handleRoutes(const Request& request)
 
     if (vnet_orch_->isVnetExecVrf())
     {
-        return doRouteTask<VNetVrfObject>(vnet_name, ip_pfx, nh, op);
+        return doRouteTask<VNetVrfObject>(vnet_name, ip_pfx, nh, op, ctx);
     }
 
     return true;
@@ -1037,7 +1163,7 @@ void VNetRouteOrch::delRoute(const IpPrefix& ipPrefix)
     syncd_routes_.erase(route_itr);
 }
 
-bool VNetRouteOrch::handleTunnel(const Request& request)
+bool VNetRouteOrch::handleTunnel(const Request& request, VNetRouteBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -1077,13 +1203,13 @@ bool VNetRouteOrch::handleTunnel(const Request& request)
 
     if (vnet_orch_->isVnetExecVrf())
     {
-        return doRouteTask<VNetVrfObject>(vnet_name, ip_pfx, endp, op);
+        return doRouteTask<VNetVrfObject>(vnet_name, ip_pfx, endp, op, ctx);
     }
 
     return true;
 }
 
-bool VNetRouteOrch::addOperation(const Request& request)
+bool VNetRouteOrch::handleRequest(const Request& request, VNetRouteBulkContext& ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -1096,39 +1222,50 @@ bool VNetRouteOrch::addOperation(const Request& request)
             return true;
         }
 
-        return ((this->*(handler_map_[tn]))(request));
+        return ((this->*(handler_map_[tn]))(request, ctx));
     }
     catch(std::runtime_error& _)
     {
-        SWSS_LOG_ERROR("VNET add operation error %s ", _.what());
+        SWSS_LOG_ERROR("VNET %s operation error %s ",
+                       (request.getOperation() == SET_COMMAND) ? "add" : "del", _.what());
         return true;
     }
 
     return true;
 }
 
-bool VNetRouteOrch::delOperation(const Request& request)
+/*
+ * doTask() bulks the routes of all the pending requests, these handle a
+ * single request on its own.
+ */
+bool VNetRouteOrch::addOperation(const Request& request)
 {
     SWSS_LOG_ENTER();
 
-    try
+    VNetRouteBulkContext ctx;
+    bool done = handleRequest(request, ctx);
+    if (ctx.object_statuses.empty())
     {
-        auto& tn = request.getTableName();
-        if (handler_map_.find(tn) == handler_map_.end())
-        {
-            SWSS_LOG_ERROR(" %s handler is not initialized", tn.c_str());
-            return true;
-        }
-
-        return ((this->*(handler_map_[tn]))(request));
+        return done;
     }
-    catch(std::runtime_error& _)
+
+    route_bulker_.flush();
+    return handleRequestPost(ctx, SET_COMMAND);
+}
+
+bool VNetRouteOrch::delOperation(const Request& request)
+{
+    SWSS_LOG_ENTER();
+
+    VNetRouteBulkContext ctx;
+    bool done = handleRequest(request, ctx);
+    if (ctx.object_statuses.empty())
     {
-        SWSS_LOG_ERROR("VNET del operation error %s ", _.what());
-        return true;
+        return done;
     }
 
-    return true;
+    route_bulker_.flush();
+    return handleRequestPost(ctx, DEL_COMMAND);
 }
 
 VNetCfgRouteOrch::VNetCfgRouteOrch(DBConnector *db, DBConnector *appDb, vector<string> &tableNames)
@@ -7,11 +7,13 @@
 #include <algorithm>
 #include <bitset>
 #include <tuple>
+#include <deque>
 
 #include "request_parser.h"
 #include "ipaddresses.h"
 #include "producerstatetable.h"
 #include "observer.h"
+#include "bulker.h"
 
 #define VNET_BITMAP_SIZE 32
 #define VNET_TUNNEL_SIZE 40960
@@ -281,36 +283,73 @@ struct VNetNextHopObserverEntry
 /* NextHopObserverTable: Destination IP address, next hop observer entry */
 typedef std::map<IpAddress, VNetNextHopObserverEntry> VNetNextHopObserverTable;
 
+struct VNetRouteBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    std::vector<sai_object_id_t>        vr_ids;             // Virtual router of each status
+    std::string                         vnet;
+    IpPrefix                            ip_prefix;
+    bool                                is_tunnel;
+    tunnelEndpoint                      endp;
+    nextHop                             nh;
+
+    VNetRouteBulkContext()
+        : is_tunnel(false)
+    {
+    }
+
+    // Disable any copy constructors
+    VNetRouteBulkContext(const VNetRouteBulkContext&) = delete;
+    VNetRouteBulkContext(VNetRouteBulkContext&&) = delete;
+
+    void clear()
+    {
+        object_statuses.clear();
+        vr_ids.clear();
+        is_tunnel = false;
+    }
+};
+
 class VNetRouteOrch : public Orch2, public Subject
 {
 public:
     VNetRouteOrch(DBConnector *db, vector<string> &tableNames, VNetOrch *);
 
-    typedef pair<string, bool (VNetRouteOrch::*) (const Request& )> handler_pair;
-    typedef map<string, bool (VNetRouteOrch::*) (const Request& )> handler_map;
+    typedef pair<string, bool (VNetRouteOrch::*) (const Request&, VNetRouteBulkContext&)> handler_pair;
+    typedef map<string, bool (VNetRouteOrch::*) (const Request&, VNetRouteBulkContext&)> handler_map;
 
     void attach(Observer* observer, const IpAddress& dstAddr);
     void detach(Observer* observer, const IpAddress& dstAddr);
 
+    using Orch::doTask;
+
 private:
+    void doTask(Consumer& consumer);
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
+    bool handleRequest(const Request& request, VNetRouteBulkContext& ctx);
+    bool handleRequestPost(VNetRouteBulkContext& ctx, const string& op);
+
     void addRoute(const std::string & vnet, const IpPrefix & ipPrefix, const nextHop& nh);
     void delRoute(const IpPrefix& ipPrefix);
 
-    bool handleRoutes(const Request&);
-    bool handleTunnel(const Request&);
+    bool handleRoutes(const Request&, VNetRouteBulkContext&);
+    bool handleTunnel(const Request&, VNetRouteBulkContext&);
 
     template<typename T>
-    bool doRouteTask(const string& vnet, IpPrefix& ipPrefix, tunnelEndpoint& endp, string& op);
+    bool doRouteTask(const string& vnet, IpPrefix& ipPrefix, tunnelEndpoint& endp, string& op, VNetRouteBulkContext& ctx);
 
     template<typename T>
-    bool doRouteTask(const string& vnet, IpPrefix& ipPrefix, nextHop& nh, string& op);
+    bool doRouteTask(const string& vnet, IpPrefix& ipPrefix, nextHop& nh, string& op, VNetRouteBulkContext& ctx);
+
+    void addRouteEntry(VNetRouteBulkContext& ctx, sai_object_id_t vr_id, sai_object_id_t nh_id);
+    void delRouteEntry(VNetRouteBulkContext& ctx, sai_object_id_t vr_id);
 
     VNetOrch *vnet_orch_;
     VNetRouteRequest request_;
     handler_map handler_map_;
+    EntityBulker<sai_route_api_t> route_bulker_;
 
     VNetRouteTable syncd_routes_;
     VNetNextHopObserverTable next_hop_observers_;
@@ -15,6 +15,7 @@
 #include "swssnet.h"
 #include "warm_restart.h"
 #include "tokenize.h"
+#include "bulker.h"
 
 /* Global variables */
 extern sai_object_id_t gSwitchId;
@@ -25,6 +26,10 @@ extern Directory<Orch*> gDirectory;
 extern PortsOrch*       gPortsOrch;
 extern sai_object_id_t  gUnderlayIfId;
 
+/* Seconds an unused tunnel next hop is kept for reuse */
+#define VXLAN_NH_HOLD_DOWN_SEC  2
+#define VXLAN_NH_CACHE_SWEEP_SEC 1
+
 const map<MAP_T, uint32_t> vxlanTunnelMap =
 {
     { MAP_T::VNI_TO_VLAN_ID, SAI_TUNNEL_MAP_TYPE_VNI_TO_VLAN_ID },
@@ -573,7 +578,8 @@ void VxlanTunnel::updateNextHop(IpAddress& ipAddr, MacAddress macAddress,
     auto it = nh_tunnels_.find(key);
     if (it == nh_tunnels_.end())
     {
-        nh_tunnels_[key] = {nh_id, 1};
+        nh_tunnels_[key] = {nh_id, 1, {}};
+        nh_cache_stats_.misses++;
         return;
     } 
     else 
@@ -602,6 +608,7 @@ void VxlanTunnel::incNextHopRefCount(IpAddress& ipAddr, MacAddress macAddress, u
 {
     auto key = nh_key_t(ipAddr, macAddress, vni);
     nh_tunnels_[key].ref_count ++;
+    nh_cache_stats_.hits++;
     SWSS_LOG_INFO("refcnt increment NH tunnel for ip %s, mac %s, vni %d, ref_count %d",
             ipAddr.to_string().c_str(), macAddress.to_string().c_str(), vni,
             nh_tunnels_[key].ref_count);
@@ -623,7 +630,7 @@ bool VxlanTunnel::removeNextHop(IpAddress& ipAddr, MacAddress macAddress, uint32
     auto key = nh_key_t(ipAddr, macAddress, vni);
 
     auto it = nh_tunnels_.find(key);
-    if (it == nh_tunnels_.end())
+    if (it == nh_tunnels_.end() || it->second.ref_count <= 0)
     {
         SWSS_LOG_INFO("remove NH tunnel for ip %s, mac %s, vni %d doesn't exist",
                         ipAddr.to_string().c_str(), macAddress.to_string().c_str(), vni);
@@ -637,23 +644,62 @@ bool VxlanTunnel::removeNextHop(IpAddress& ipAddr, MacAddress macAddress, uint32
     //Decrement ref count if already exists
     nh_tunnels_[key].ref_count --;
 
+    /* The next hop is removed once the hold down expires without a new user */
     if (!nh_tunnels_[key].ref_count)
     {
-        if (sai_next_hop_api->remove_next_hop(nh_tunnels_[key].nh_id) != SAI_STATUS_SUCCESS)
+        nh_tunnels_[key].hold_down_expiry = std::chrono::steady_clock::now() +
+                                            std::chrono::seconds(VXLAN_NH_HOLD_DOWN_SEC);
+    }
+
+    SWSS_LOG_INFO("NH tunnel for ip '%s', mac '%s' vni %d updated",
+                    ipAddr.to_string().c_str(), macAddress.to_string().c_str(), vni);
+
+    return true;
+}
+
+void VxlanTunnel::removeIdleNextHops(bool force)
+{
+    auto now = std::chrono::steady_clock::now();
+    vector<nh_key_t> keys;
+
+    for (const auto& nh : nh_tunnels_)
+    {
+        if (!nh.second.ref_count && (force || nh.second.hold_down_expiry <= now))
         {
-            SWSS_LOG_INFO("delete NH tunnel for ip '%s', mac '%s' vni %d failed",
-                            ipAddr.to_string().c_str(), macAddress.to_string().c_str(), vni);
-            string err_msg = "NH tunnel delete failed for " + ipAddr.to_string();
-            throw std::runtime_error(err_msg);
+            keys.push_back(nh.first);
         }
+    }
 
-        nh_tunnels_.erase(key);
+    if (keys.empty())
+    {
+        return;
     }
 
-    SWSS_LOG_INFO("NH tunnel for ip '%s', mac '%s' vni %d updated/deleted",
-                    ipAddr.to_string().c_str(), macAddress.to_string().c_str(), vni);
+    ObjectBulker<sai_next_hop_api_t> bulker(sai_next_hop_api, gSwitchId);
+    vector<sai_status_t> statuses(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        bulker.remove_entry(&statuses[i], nh_tunnels_[keys[i]].nh_id);
+    }
+    bulker.flush();
 
-    return true;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        const auto& key = keys[i];
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            /* Retried by the next sweep */
+            SWSS_LOG_ERROR("delete NH tunnel for ip '%s', mac '%s' vni %d failed, rv:%d",
+                            key.ip_addr.to_string().c_str(), key.mac_address.to_string().c_str(),
+                            key.vni, statuses[i]);
+            continue;
+        }
+
+        SWSS_LOG_INFO("deleted NH tunnel for ip %s, mac %s, vni %d",
+                        key.ip_addr.to_string().c_str(), key.mac_address.to_string().c_str(), key.vni);
+        nh_tunnels_.erase(key);
+        nh_cache_stats_.teardowns++;
+    }
 }
 
 bool VxlanTunnel::deleteMapperHw(uint8_t mapper_list, tunnel_map_use_t map_src)
@@ -840,6 +886,15 @@ bool VxlanTunnel::deleteTunnelHw(uint8_t mapper_list, tunnel_map_use_t map_src,
 {
     try
     {
+        /* Next hops held down for reuse still refer to the tunnel */
+        removeIdleNextHops(true);
+        if (!nh_tunnels_.empty())
+        {
+            SWSS_LOG_WARN("Tunnel %s not deleted as %zu next hops still refer to it",
+                          tunnel_name_.c_str(), nh_tunnels_.size());
+            return false;
+        }
+
         if (with_term)
         {
             remove_tunnel_termination(ids_.tunnel_term_id);
@@ -912,14 +967,28 @@ void VxlanTunnel::deletePendingSIPTunnel()
 
        TUNNELMAP_SET_VLAN(mapper_list);
        TUNNELMAP_SET_VRF(mapper_list);
-       deleteTunnelHw(mapper_list, TUNNEL_MAP_USE_DEDICATED_ENCAP_DECAP);
-       del_tnl_hw_pending = false;
-       SWSS_LOG_INFO("Removing SIP Tunnel HW which is pending");
+       if (deleteTunnelHw(mapper_list, TUNNEL_MAP_USE_DEDICATED_ENCAP_DECAP))
+       {
+           del_tnl_hw_pending = false;
+           SWSS_LOG_INFO("Removing SIP Tunnel HW which is pending");
+       }
    }
 
    return;
 }
 
+void VxlanTunnel::deletePendingDIPTunnels()
+{
+    // A DIP still in use again or still refused is dropped or queued back by the delete
+    auto dips = pending_dip_deletes_;
+    pending_dip_deletes_.clear();
+
+    for (const auto& dip : dips)
+    {
+        deleteDynamicDIPTunnel(dip, TUNNEL_USER_IMR, false);
+    }
+}
+
 int VxlanTunnel::getDipTunnelCnt()
 {
     int ret;
@@ -1139,7 +1208,14 @@ bool VxlanTunnel::deleteDynamicDIPTunnel(const std::string dip, tunnel_user_t us
  
         TUNNELMAP_SET_VLAN(mapper_list);
         TUNNELMAP_SET_VRF(mapper_list);
-        dip_tunnel->deleteTunnelHw(mapper_list,TUNNEL_MAP_USE_COMMON_ENCAP_DECAP, false);
+        if (!dip_tunnel->deleteTunnelHw(mapper_list,TUNNEL_MAP_USE_COMMON_ENCAP_DECAP, false))
+        {
+            // The DIP keeps its user entry so that the SIP tunnel isn't removed before it
+            SWSS_LOG_WARN("P2P Tunnel %s deletion is pending", tunnel_name.c_str());
+            pending_dip_deletes_.insert(dip);
+            return true;
+        }
+        pending_dip_deletes_.erase(dip);
  
         tnl_users_.erase(dip);
  
@@ -1156,6 +1232,74 @@ bool VxlanTunnel::deleteDynamicDIPTunnel(const std::string dip, tunnel_user_t us
 
 //------------------- VxlanTunnelOrch Implementation --------------------------//
 
+VxlanTunnelOrch::VxlanTunnelOrch(DBConnector *statedb, DBConnector *db, const std::string& tableName) :
+                    Orch2(db, tableName, request_),
+                    m_stateVxlanTable(statedb, STATE_VXLAN_TUNNEL_TABLE_NAME),
+                    m_stateVxlanNhCacheTable(statedb, STATE_VXLAN_NH_CACHE_TABLE_NAME)
+{
+    auto interv = timespec { .tv_sec = VXLAN_NH_CACHE_SWEEP_SEC, .tv_nsec = 0 };
+    m_nhCacheTimer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(m_nhCacheTimer, this, "VXLAN_NH_CACHE_TIMER");
+    Orch::addExecutor(executor);
+    m_nhCacheTimer->start();
+}
+
+void VxlanTunnelOrch::doTask(SelectableTimer&)
+{
+    SWSS_LOG_ENTER();
+
+    // Deleting a DIP tunnel removes it from the table, pending deletes run after the sweep
+    vector<VxlanTunnel*> pending_deletes;
+
+    for (const auto& it : vxlan_tunnel_table_)
+    {
+        const auto& tunnel_name = it.first;
+        auto tunnel_obj = it.second.get();
+
+        tunnel_obj->removeIdleNextHops();
+        if (tunnel_obj->hasPendingDIPTunnels() || tunnel_obj->del_tnl_hw_pending)
+        {
+            pending_deletes.push_back(tunnel_obj);
+        }
+
+        const auto& stats = tunnel_obj->getNextHopCacheStats();
+        if (!stats.hits && !stats.misses)
+        {
+            continue;
+        }
+
+        auto& published = m_publishedNhCacheStats[tunnel_name];
+        if (published.hits == stats.hits && published.misses == stats.misses &&
+            published.teardowns == stats.teardowns)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvVector;
+        fvVector.emplace_back("hits", to_string(stats.hits));
+        fvVector.emplace_back("misses", to_string(stats.misses));
+        fvVector.emplace_back("teardowns", to_string(stats.teardowns));
+        m_stateVxlanNhCacheTable.set(tunnel_name, fvVector);
+
+        published = stats;
+    }
+
+    // The DIP tunnels go first, the SIP tunnel is only removed once none is left
+    for (auto tunnel_obj : pending_deletes)
+    {
+        tunnel_obj->deletePendingDIPTunnels();
+        tunnel_obj->deletePendingSIPTunnel();
+    }
+}
+
+void VxlanTunnelOrch::removeNextHopCacheStats(const std::string& tunnel_name)
+{
+    if (m_publishedNhCacheStats.erase(tunnel_name))
+    {
+        m_stateVxlanNhCacheTable.del(tunnel_name);
+    }
+}
+
 sai_object_id_t
 VxlanTunnelOrch::createNextHopTunnel(string tunnelName, IpAddress& ipAddr, 
                                      MacAddress macAddress, uint32_t vni)
@@ -1405,7 +1549,18 @@ bool VxlanTunnelOrch::delOperation(const Request& request)
         return false;
     }
 
+    if (vtep_ptr)
+    {
+        vtep_ptr->removeIdleNextHops(true);
+        if (vtep_ptr->hasNextHops())
+        {
+            SWSS_LOG_WARN("VTEP %s not deleted as next hops still refer to it", tunnel_name.c_str());
+            return false;
+        }
+    }
+
     vxlan_tunnel_table_.erase(tunnel_name);
+    removeNextHopCacheStats(tunnel_name);
 
     SWSS_LOG_NOTICE("Vxlan tunnel '%s' was removed", tunnel_name.c_str());
 
@@ -1810,7 +1965,11 @@ bool VxlanTunnelMapOrch::delOperation(const Request& request)
           uint8_t mapper_list=0;
           TUNNELMAP_SET_VLAN(mapper_list);
           TUNNELMAP_SET_VRF(mapper_list);
-          tunnel_obj->deleteTunnelHw(mapper_list, TUNNEL_MAP_USE_DEDICATED_ENCAP_DECAP);
+          // Retried by the next hop cache sweep if next hops still refer to the tunnel
+          if (!tunnel_obj->deleteTunnelHw(mapper_list, TUNNEL_MAP_USE_DEDICATED_ENCAP_DECAP))
+          {
+              tunnel_obj->del_tnl_hw_pending = true;
+          }
       }
       else
       {
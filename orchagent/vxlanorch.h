@@ -4,10 +4,15 @@
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <chrono>
+#include <boost/functional/hash.hpp>
 #include "request_parser.h"
 #include "portsorch.h"
 #include "vrforch.h"
 
+// STATE_DB table with the next hop cache counters of each tunnel
+#define STATE_VXLAN_NH_CACHE_TABLE_NAME "VXLAN_TUNNEL_NH_CACHE_TABLE"
+
 enum class MAP_T
 {
     MAP_TO_INVALID,
@@ -86,9 +91,23 @@ struct nh_key_hash
 {
     size_t operator() (const nh_key_t& key) const
     {
-        stringstream ss;
-        ss << key.ip_addr.to_string() << key.mac_address.to_string() << std::to_string(key.vni);
-        return std::hash<std::string>() (ss.str());
+        size_t seed = 0;
+        const auto& ip = key.ip_addr.getIp();
+        const uint8_t *mac = key.mac_address.getMac();
+
+        boost::hash_combine(seed, ip.family);
+        if (ip.family == AF_INET)
+        {
+            boost::hash_combine(seed, ip.ip_addr.ipv4_addr);
+        }
+        else
+        {
+            boost::hash_range(seed, ip.ip_addr.ipv6_addr, ip.ip_addr.ipv6_addr + sizeof(ip.ip_addr.ipv6_addr));
+        }
+        boost::hash_range(seed, mac, mac + sizeof(sai_mac_t));
+        boost::hash_combine(seed, key.vni);
+
+        return seed;
     }
 };
 
@@ -96,6 +115,16 @@ struct nh_tunnel_t
 {
     sai_object_id_t nh_id;
     int             ref_count;
+    // A next hop without users is kept until then, so that it is reused
+    // when the remote VTEP flaps back
+    std::chrono::steady_clock::time_point hold_down_expiry;
+};
+
+struct nh_cache_stats_t
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t teardowns = 0;
 };
 
 typedef enum {
@@ -178,12 +207,29 @@ public:
 
     void incNextHopRefCount(IpAddress& ipAddr, MacAddress macAddress, uint32_t vni);
     void decNextHopRefCount(IpAddress& ipAddr, MacAddress macAddress, uint32_t vni);
+    // Removes the unused next hops whose hold down expired, or all of them
+    void removeIdleNextHops(bool force = false);
+    bool hasNextHops() const
+    {
+        return !nh_tunnels_.empty();
+    }
+
+    const nh_cache_stats_t& getNextHopCacheStats() const
+    {
+        return nh_cache_stats_;
+    }
 
     bool deleteMapperHw(uint8_t mapper_list, tunnel_map_use_t map_src);
     bool createMapperHw(uint8_t mapper_list, tunnel_map_use_t map_src);
     bool createTunnelHw(uint8_t mapper_list, tunnel_map_use_t map_src, bool with_term = true);
     bool deleteTunnelHw(uint8_t mapper_list, tunnel_map_use_t map_src, bool with_term = true);
     void deletePendingSIPTunnel();
+    // Retries the DIP tunnels whose HW delete was refused while next hops referred to them
+    void deletePendingDIPTunnels();
+    bool hasPendingDIPTunnels() const
+    {
+        return !pending_dip_deletes_.empty();
+    }
     void increment_spurious_imr_add(const std::string remote_vtep);
     void increment_spurious_imr_del(const std::string remote_vtep);
     void updateDipTunnelRefCnt(bool , tunnel_refcnt_t& , tunnel_user_t );
@@ -207,11 +253,13 @@ private:
 
     TunnelMapEntries tunnel_map_entries_;
     TunnelNHs nh_tunnels_;
+    nh_cache_stats_t nh_cache_stats_;
 
     IpAddress src_ip_;
     IpAddress dst_ip_ = 0x0;
 
     TunnelUsers tnl_users_;
+    std::set<std::string> pending_dip_deletes_;
     VxlanTunnel* vtep_ptr=NULL;
     tunnel_creation_src_t src_creation_;
     uint8_t encap_dedicated_mappers_ = 0;
@@ -241,11 +289,9 @@ typedef std::map<IpAddress, VxlanTunnel*> VTEPTable;
 class VxlanTunnelOrch : public Orch2
 {
 public:
-    VxlanTunnelOrch(DBConnector *statedb, DBConnector *db, const std::string& tableName) :
-                    Orch2(db, tableName, request_),
-                    m_stateVxlanTable(statedb, STATE_VXLAN_TUNNEL_TABLE_NAME)
-    {}
+    VxlanTunnelOrch(DBConnector *statedb, DBConnector *db, const std::string& tableName);
 
+    using Orch::doTask;
 
     bool isTunnelExists(const std::string& tunnelName) const
     {
@@ -266,6 +312,7 @@ public:
     bool delTunnel(const std::string tunnel_name)
     {
        vxlan_tunnel_table_.erase(tunnel_name);
+       removeNextHopCacheStats(tunnel_name);
        return true;
     }
 
@@ -343,12 +390,19 @@ public:
 private:
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
+    void doTask(SelectableTimer &timer);
+
+    void removeNextHopCacheStats(const std::string& tunnel_name);
 
     VxlanTunnelTable vxlan_tunnel_table_;
     VxlanTunnelRequest request_;
     VxlanVniVlanMapTable vxlan_vni_vlan_map_table_;
     VTEPTable vtep_table_;
     Table m_stateVxlanTable;
+    Table m_stateVxlanNhCacheTable;
+    // Next hop cache counters last written to STATE_DB
+    std::map<std::string, nh_cache_stats_t> m_publishedNhCacheStats;
+    SelectableTimer *m_nhCacheTimer = nullptr;
 };
 
 const request_description_t vxlan_tunnel_map_request_description = {
@@ -18,42 +18,33 @@ local rets = {}
 
 redis.call('SELECT', counters_db)
 
+-- Write the watermark only when it grows, stored values are left untouched otherwise
+local function update_wm(table_name, key, field, new_wm)
+    local old_wm = tonumber(redis.call('HGET', table_name .. ':' .. key, field))
+    if not old_wm or new_wm > old_wm then
+        redis.call('HSET', table_name .. ':' .. key, field, new_wm)
+    end
+end
+
 -- Iterate through each buffer pool oid
 local n = table.getn(KEYS)
 for i = n, 1, -1 do
-    -- Get new watermark value from COUNTERS
-    local buffer_pool_wm = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-    local hdrm_pool_wm = redis.call('HGET', counters_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-
-    -- Get last value from *_WATERMARKS
-    local user_buffer_pool_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-    local persistent_buffer_pool_wm = redis.call('HGET', persistent_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-    local periodic_buffer_pool_wm = redis.call('HGET', periodic_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name)
-
-    local user_hdrm_pool_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-    local persistent_hdrm_pool_wm = redis.call('HGET', persistent_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
-    local periodic_hdrm_pool_wm = redis.call('HGET', periodic_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
+    -- Get new watermark values from COUNTERS
+    local wms = redis.call('HMGET', counters_table_name .. ':' .. KEYS[i],
+                           sai_buffer_pool_watermark_stat_name, sai_hdrm_pool_watermark_stat_name)
+    local buffer_pool_wm = tonumber(wms[1])
+    local hdrm_pool_wm = tonumber(wms[2])
 
     if buffer_pool_wm then
-        buffer_pool_wm = tonumber(buffer_pool_wm)
-
-        redis.call('HSET', user_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
-                   user_buffer_pool_wm and math.max(buffer_pool_wm, user_buffer_pool_wm) or buffer_pool_wm)
-        redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
-                   persistent_buffer_pool_wm and math.max(buffer_pool_wm, persistent_buffer_pool_wm) or buffer_pool_wm)
-        redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
-                   periodic_buffer_pool_wm and math.max(buffer_pool_wm, periodic_buffer_pool_wm) or buffer_pool_wm)
+        update_wm(user_table_name, KEYS[i], sai_buffer_pool_watermark_stat_name, buffer_pool_wm)
+        update_wm(persistent_table_name, KEYS[i], sai_buffer_pool_watermark_stat_name, buffer_pool_wm)
+        update_wm(periodic_table_name, KEYS[i], sai_buffer_pool_watermark_stat_name, buffer_pool_wm)
     end
 
     if hdrm_pool_wm then
-        hdrm_pool_wm = tonumber(hdrm_pool_wm)
-
-        redis.call('HSET', user_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
-                   user_hdrm_pool_wm and math.max(hdrm_pool_wm, user_hdrm_pool_wm) or hdrm_pool_wm)
-        redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
-                   persistent_hdrm_pool_wm and math.max(hdrm_pool_wm, persistent_hdrm_pool_wm) or hdrm_pool_wm)
-        redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
-                   periodic_hdrm_pool_wm and math.max(hdrm_pool_wm, periodic_hdrm_pool_wm) or hdrm_pool_wm)
+        update_wm(user_table_name, KEYS[i], sai_hdrm_pool_watermark_stat_name, hdrm_pool_wm)
+        update_wm(persistent_table_name, KEYS[i], sai_hdrm_pool_watermark_stat_name, hdrm_pool_wm)
+        update_wm(periodic_table_name, KEYS[i], sai_hdrm_pool_watermark_stat_name, hdrm_pool_wm)
     end
 end
 
@@ -1,4 +1,5 @@
 #include <string.h>
+#include <inttypes.h>
 #include <errno.h>
 #include <system_error>
 #include <sys/socket.h>
@@ -27,6 +28,8 @@ using namespace swss;
 #define VLAN_DRV_NAME   "bridge"
 #define TEAM_DRV_NAME   "team"
 
+#define LINK_SYNC_STATS_INTERVAL 1000
+
 const string MGMT_PREFIX = "eth";
 const string INTFS_PREFIX = "Ethernet";
 const string LAG_PREFIX = "PortChannel";
@@ -42,10 +45,11 @@ struct if_nameindex
 extern "C" { extern struct if_nameindex *if_nameindex (void) __THROW; }
 
 LinkSync::LinkSync(DBConnector *appl_db, DBConnector *state_db) :
+    m_statePipeline(state_db),
     m_portTableProducer(appl_db, APP_PORT_TABLE_NAME),
     m_portTable(appl_db, APP_PORT_TABLE_NAME),
-    m_statePortTable(state_db, STATE_PORT_TABLE_NAME),
-    m_stateMgmtPortTable(state_db, STATE_MGMT_PORT_TABLE_NAME)
+    m_statePortTable(&m_statePipeline, STATE_PORT_TABLE_NAME, true),
+    m_stateMgmtPortTable(&m_statePipeline, STATE_MGMT_PORT_TABLE_NAME, true)
 {
     struct if_nameindex *if_ni, *idx_p;
     if_ni = if_nameindex();
@@ -88,6 +92,7 @@ LinkSync::LinkSync(DBConnector *appl_db, DBConnector *state_db) :
                 fvs.push_back(fv);
 
                 m_stateMgmtPortTable.set(key, fvs);
+                m_mgmtOperStatus[key] = res;
                 SWSS_LOG_INFO("Store %s oper status %s to state DB",
                         key.c_str(), res.c_str());
             }
@@ -95,6 +100,8 @@ LinkSync::LinkSync(DBConnector *appl_db, DBConnector *state_db) :
         }
     }
 
+    flush();
+
     if (!WarmStart::isWarmStart())
     {
         /* See the comments for g_portSet in portsyncd.cpp */
@@ -153,6 +160,27 @@ LinkSync::LinkSync(DBConnector *appl_db, DBConnector *state_db) :
     }
 }
 
+void LinkSync::flush()
+{
+    m_statePipeline.flush();
+}
+
+void LinkSync::updateStats(bool published, chrono::steady_clock::time_point start)
+{
+    m_msgCount++;
+    if (published)
+    {
+        m_publishedCount++;
+    }
+    m_msgTime += static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+
+    if (m_msgCount % LINK_SYNC_STATS_INTERVAL == 0)
+    {
+        SWSS_LOG_NOTICE("Link messages:%" PRIu64 " published:%" PRIu64 " suppressed:%" PRIu64 "%% average time:%" PRIu64 "us",
+                m_msgCount, m_publishedCount, (m_msgCount - m_publishedCount) * 100 / m_msgCount, m_msgTime / m_msgCount);
+    }
+}
+
 void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
 {
     SWSS_LOG_ENTER();
@@ -162,6 +190,13 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
         return;
     }
 
+    auto start = chrono::steady_clock::now();
+    bool published = handleMsg(nlmsg_type, obj);
+    updateStats(published, start);
+}
+
+bool LinkSync::handleMsg(int nlmsg_type, struct nl_object *obj)
+{
     struct rtnl_link *link = (struct rtnl_link *)obj;
     string key = rtnl_link_get_name(link);
 
@@ -169,7 +204,7 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
         key.compare(0, LAG_PREFIX.length(), LAG_PREFIX) &&
         key.compare(0, MGMT_PREFIX.length(), MGMT_PREFIX))
     {
-        return;
+        return false;
     }
 
     unsigned int flags = rtnl_link_get_flags(link);
@@ -196,19 +231,27 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
 
     if (!key.compare(0, MGMT_PREFIX.length(), MGMT_PREFIX))
     {
-        FieldValueTuple fv("oper_status", oper ? "up" : "down");
+        string operStatus = oper ? "up" : "down";
+        auto found = m_mgmtOperStatus.find(key);
+        if (found != m_mgmtOperStatus.end() && found->second == operStatus)
+        {
+            return false;
+        }
+
+        FieldValueTuple fv("oper_status", operStatus);
         vector<FieldValueTuple> fvs;
         fvs.push_back(fv);
         m_stateMgmtPortTable.set(key, fvs);
+        m_mgmtOperStatus[key] = operStatus;
         SWSS_LOG_INFO("Store %s oper status %s to state DB",
-                key.c_str(), oper ? "up" : "down");
-        return;
+                key.c_str(), operStatus.c_str());
+        return true;
     }
 
     /* teamd instances are dealt in teamsyncd */
     if (type && !strcmp(type, TEAM_DRV_NAME))
     {
-        return;
+        return false;
     }
 
     /* If netlink for this port has master, we ignore that for now
@@ -216,7 +259,7 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
      */
     if (master)
     {
-        return;
+        return false;
     }
 
     /* In the event of swss restart, it is possible to get netlink messages during bridge
@@ -230,7 +273,7 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
     {
         SWSS_LOG_INFO("nlmsg type:%d Ignoring message for old interface %s(%d)",
                 nlmsg_type, key.c_str(), ifindex);
-        return;
+        return false;
     }
 
     /* Insert or update the ifindex to key map */
@@ -239,8 +282,15 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
     if (nlmsg_type == RTM_DELLINK)
     {
         m_statePortTable.del(key);
+        m_statePortOk.erase(key);
         SWSS_LOG_NOTICE("Delete %s(ok) from state db", key.c_str());
-        return;
+        return true;
+    }
+
+    /* The port state is already published, nothing else is synced from the link */
+    if (m_statePortOk.find(key) != m_statePortOk.end())
+    {
+        return false;
     }
 
     /* front panel interfaces: Check if the port is in the PORT_TABLE
@@ -254,10 +304,14 @@ void LinkSync::onMsg(int nlmsg_type, struct nl_object *obj)
         vector<FieldValueTuple> vector;
         vector.push_back(tuple);
         m_statePortTable.set(key, vector);
+        m_statePortOk.insert(key);
         SWSS_LOG_NOTICE("Publish %s(ok) to state db", key.c_str());
+        return true;
     }
     else
     {
         SWSS_LOG_NOTICE("Cannot find %s in port table", key.c_str());
     }
+
+    return false;
 }
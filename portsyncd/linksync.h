@@ -3,9 +3,12 @@
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redispipeline.h"
 #include "netmsg.h"
 
 #include <map>
+#include <set>
+#include <chrono>
 
 namespace swss {
 
@@ -18,10 +21,30 @@ public:
 
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
+    /* Write the STATE_DB updates of the handled netlink messages */
+    void flush();
+
 private:
+    /* Returns true if the message updated STATE_DB */
+    bool handleMsg(int nlmsg_type, struct nl_object *obj);
+    void updateStats(bool published, std::chrono::steady_clock::time_point start);
+
+    RedisPipeline m_statePipeline;
     ProducerStateTable m_portTableProducer;
     Table m_portTable, m_statePortTable, m_stateMgmtPortTable;
 
+    /*
+     * Shadow of what is published to STATE_DB, netlink messages which don't
+     * change it are dropped without any DB access
+     */
+    std::map<std::string, std::string> m_mgmtOperStatus;
+    std::set<std::string> m_statePortOk;
+
+    /* Netlink message handling stats, logged every LINK_SYNC_STATS_INTERVAL messages */
+    uint64_t m_msgCount = 0;
+    uint64_t m_publishedCount = 0;
+    uint64_t m_msgTime = 0;
+
     std::map<unsigned int, std::string> m_ifindexNameMap;
     std::map<unsigned int, std::string> m_ifindexOldNameMap;
 };
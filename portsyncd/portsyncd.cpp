@@ -124,6 +124,12 @@ int main(int argc, char **argv)
 
             if (temps == static_cast<Selectable*>(&netlink))
             {
+                /*
+                 * STATE_DB updates of the messages read in this round, written
+                 * before PortInitDone so that the ports are seen as ready
+                 */
+                sync.flush();
+
                 /* on netlink message, check if PortInitDone should be sent out */
                 if (!g_init && g_portSet.empty())
                 {
@@ -5,6 +5,7 @@
 #include <linux/if.h>
 #include <netlink/route/link.h>
 #include <chrono>
+#include <algorithm>
 #include "logger.h"
 #include "netmsg.h"
 #include "dbconnector.h"
@@ -23,8 +24,9 @@ using namespace swss;
 
 TeamSync::TeamSync(DBConnector *db, DBConnector *stateDb, Select *select) :
     m_select(select),
-    m_lagTable(db, APP_LAG_TABLE_NAME),
-    m_lagMemberTable(db, APP_LAG_MEMBER_TABLE_NAME),
+    m_pipeline(db),
+    m_lagTable(&m_pipeline, APP_LAG_TABLE_NAME, true),
+    m_lagMemberTable(&m_pipeline, APP_LAG_MEMBER_TABLE_NAME, true),
     m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME)
 {
     WarmStart::initialize(TEAMSYNCD_APP_NAME, "teamd");
@@ -57,6 +59,59 @@ void TeamSync::periodic()
     }
 
     doSelectableTask();
+    doLagMemberTask();
+
+    m_pipeline.flush();
+}
+
+int TeamSync::getSelectTimeout()
+{
+    int timeout = DEFAULT_SELECT_TIMEOUT;
+    auto now = steady_clock::now();
+
+    for (const auto &it : m_teamSelectables)
+    {
+        if (!it.second->isChangePending())
+        {
+            continue;
+        }
+
+        auto elapsed = duration_cast<milliseconds>(now - it.second->getChangeTime()).count();
+        int remaining = static_cast<int>(max<int64_t>(DEFAULT_LAG_MEMBER_SYNC_DELAY - elapsed, 0));
+        timeout = min(timeout, remaining);
+    }
+
+    return timeout;
+}
+
+void TeamSync::doLagMemberTask()
+{
+    bool expired = false;
+    auto now = steady_clock::now();
+
+    for (const auto &it : m_teamSelectables)
+    {
+        if (it.second->isChangePending() &&
+            duration_cast<milliseconds>(now - it.second->getChangeTime()).count() >= DEFAULT_LAG_MEMBER_SYNC_DELAY)
+        {
+            expired = true;
+            break;
+        }
+    }
+
+    if (!expired)
+    {
+        return;
+    }
+
+    /* The changes of all the LAGs are published in the same batch */
+    for (const auto &it : m_teamSelectables)
+    {
+        if (it.second->isChangePending())
+        {
+            it.second->syncLagMembers();
+        }
+    }
 }
 
 void TeamSync::doSelectableTask()
@@ -85,6 +140,7 @@ void TeamSync::applyState()
 
     m_lagTable.apply_temp_view();
     m_lagMemberTable.apply_temp_view();
+    m_pipeline.flush();
 
     for(auto &it: m_stateLagTablePreserved)
     {
@@ -222,6 +278,8 @@ void TeamSync::cleanTeamSync()
         /* Cleanup LAG */
         removeLag(it.first);
     }
+
+    m_pipeline.flush();
     return;
 }
 
@@ -299,7 +357,23 @@ TeamSync::TeamPortSync::~TeamPortSync()
     }
 }
 
+/*
+ * teamd notifies each port and option change, the members are synced after
+ * DEFAULT_LAG_MEMBER_SYNC_DELAY so that a burst of changes, like the members
+ * flapping on a linecard reset, is published once with its net result.
+ */
 int TeamSync::TeamPortSync::onChange()
+{
+    if (!m_changePending)
+    {
+        m_changePending = true;
+        m_changeTime = steady_clock::now();
+    }
+
+    return 0;
+}
+
+void TeamSync::TeamPortSync::syncLagMembers()
 {
     struct team_port *port;
     map<string, bool> tmp_lag_members;
@@ -360,7 +434,7 @@ int TeamSync::TeamPortSync::onChange()
 
     /* Replace the old LAG members with the new ones */
     m_lagMembers = tmp_lag_members;
-    return 0;
+    m_changePending = false;
 }
 
 int TeamSync::TeamPortSync::teamdHandler(struct team_handle *team, void *arg,
@@ -6,6 +6,7 @@
 #include <memory>
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redispipeline.h"
 #include "selectable.h"
 #include "select.h"
 #include "netmsg.h"
@@ -14,6 +15,9 @@
 #define TEAMSYNCD_APP_NAME  "teamsyncd"
 // seconds
 const uint32_t DEFAULT_WR_PENDING_TIMEOUT = 70;
+// milliseconds
+const int DEFAULT_LAG_MEMBER_SYNC_DELAY = 100;
+const int DEFAULT_SELECT_TIMEOUT = 1000;
 
 using namespace std::chrono;
 
@@ -27,6 +31,9 @@ public:
     void periodic();
     void cleanTeamSync();
 
+    /* Select timeout to wake up for the pending LAG member changes, in milliseconds */
+    int getSelectTimeout();
+
     /* Listen to RTM_NEWLINK, RTM_DELLINK to track team devices */
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
@@ -43,6 +50,11 @@ public:
 
         /* member_name -> enabled|disabled */
         std::map<std::string, bool> m_lagMembers;
+
+        bool isChangePending() const {return m_changePending;}
+        steady_clock::time_point getChangeTime() const {return m_changeTime;}
+        /* Publish the net changes of the LAG members since the last sync */
+        void syncLagMembers();
     protected:
         int onChange();
         static int teamdHandler(struct team_handle *th, void *arg,
@@ -53,6 +65,10 @@ public:
         struct team_handle *m_team;
         std::string m_lagName;
         int m_ifindex;
+
+        /* Set by the teamd callbacks, cleared once the members are synced */
+        bool m_changePending = false;
+        steady_clock::time_point m_changeTime;
     };
 
 protected:
@@ -66,8 +82,13 @@ protected:
     /* Handle all selectables add/removal events */
     void doSelectableTask();
 
+    /* Publish the LAG member changes once the oldest one is older than the sync delay */
+    void doLagMemberTask();
+
 private:
     Select *m_select;
+    /* LAG and LAG member updates are written in batches, flushed in periodic() */
+    RedisPipeline m_pipeline;
     ProducerStateTable m_lagTable;
     ProducerStateTable m_lagMemberTable;
     Table m_stateLagTable;
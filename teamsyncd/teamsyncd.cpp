@@ -43,7 +43,7 @@ int main(int argc, char **argv)
         while (!received_sigterm)
         {
             Selectable *temps;
-            s.select(&temps, 1000); // block for a second
+            s.select(&temps, sync.getSelectTimeout()); // block for a second at most
             sync.periodic();
         }
         sync.cleanTeamSync();
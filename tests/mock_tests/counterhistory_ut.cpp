@@ -0,0 +1,106 @@
+#include "ut_helper.h"
+#include "counterhistory.h"
+
+namespace counterhistory_test
+{
+    using namespace std;
+
+    // One packet (narrow) and one octet (wide) stat
+    const size_t pktStat = 0;
+    const size_t octetStat = 1;
+    const size_t capacity = 4;
+
+    struct CounterHistoryTest : public ::testing::Test
+    {
+        CounterHistory history;
+        vector<vector<uint64_t>> counters;
+        uint64_t now = 0;
+
+        CounterHistoryTest() :
+            history({ false, true }, capacity),
+            counters(2)
+        {
+        }
+
+        size_t addRow()
+        {
+            counters[pktStat].push_back(0);
+            counters[octetStat].push_back(0);
+            return history.addRow();
+        }
+
+        void push()
+        {
+            history.push(++now, counters, vector<bool>(counters[pktStat].size(), true));
+        }
+    };
+
+    TEST_F(CounterHistoryTest, KeepsLatestSamples)
+    {
+        size_t row = addRow();
+
+        for (uint64_t i = 1; i <= 6; i++)
+        {
+            counters[pktStat][row] = i * 10;
+            counters[octetStat][row] = i * 10000000000ULL;
+            push();
+        }
+
+        vector<uint64_t> values;
+        ASSERT_EQ(history.get(row, pktStat, 10, values), capacity);
+        ASSERT_EQ(values, (vector<uint64_t>{ 30, 40, 50, 60 }));
+
+        ASSERT_EQ(history.get(row, octetStat, 2, values), 2);
+        ASSERT_EQ(values, (vector<uint64_t>{ 50000000000ULL, 60000000000ULL }));
+
+        vector<uint64_t> timestamps;
+        history.getTimestamps(row, 10, timestamps);
+        ASSERT_EQ(timestamps, (vector<uint64_t>{ 3, 4, 5, 6 }));
+    }
+
+    TEST_F(CounterHistoryTest, RebuildsOverflowAndClearedCounters)
+    {
+        size_t row = addRow();
+
+        counters[pktStat][row] = 5;
+        push();
+        // Delta doesn't fit a narrow cell
+        counters[pktStat][row] = 5 + (1ULL << 40);
+        push();
+        // Counter cleared
+        counters[pktStat][row] = 7;
+        push();
+
+        vector<uint64_t> values;
+        history.get(row, pktStat, capacity, values);
+        ASSERT_EQ(values, (vector<uint64_t>{ 5, 5 + (1ULL << 40), 7 }));
+    }
+
+    TEST_F(CounterHistoryTest, RemoveRowMovesLastRow)
+    {
+        size_t first = addRow();
+        size_t second = addRow();
+
+        for (uint64_t i = 1; i <= 3; i++)
+        {
+            counters[pktStat][first] = i;
+            counters[pktStat][second] = i * 100 + (i == 3 ? (1ULL << 33) : 0);
+            push();
+        }
+
+        history.removeRow(first);
+
+        vector<uint64_t> values;
+        history.get(first, pktStat, capacity, values);
+        ASSERT_EQ(values, (vector<uint64_t>{ 100, 200, 300 + (1ULL << 33) }));
+
+        // Rows added later only report their own samples
+        counters[pktStat].pop_back();
+        counters[octetStat].pop_back();
+        size_t added = addRow();
+        counters[pktStat][added] = 42;
+        push();
+        ASSERT_EQ(history.get(added, pktStat, capacity, values), 1);
+        ASSERT_EQ(values[0], 42);
+    }
+}
@@ -0,0 +1,141 @@
+#include "ut_helper.h"
+#include "mock_table.h"
+
+namespace countersnapshotorch_test
+{
+    using namespace std;
+
+    const string portOid = "oid:0x1000000000001";
+    const string alpha = "0.5";
+
+    // Port stats, in the order of the PORT snapshot group
+    enum PortStat
+    {
+        IN_UCAST_PKTS,
+        IN_NON_UCAST_PKTS,
+        OUT_UCAST_PKTS,
+        OUT_NON_UCAST_PKTS,
+        IN_OCTETS,
+        OUT_OCTETS,
+        PORT_STAT_COUNT
+    };
+
+    struct CounterSnapshotOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_counters_db;
+        CounterSnapshotOrch *m_orch = nullptr;
+        vector<vector<uint64_t>> m_counters;
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+            m_orch = Portal::CounterSnapshotOrchInternal::create(m_counters_db.get());
+            m_orch->addObject(CounterSnapshotGroup::PORT, portOid);
+
+            m_counters.assign(PORT_STAT_COUNT, { 0 });
+        }
+
+        virtual void TearDown() override
+        {
+            Portal::CounterSnapshotOrchInternal::destroy(m_orch);
+            m_orch = nullptr;
+            ::testing_db::reset();
+        }
+
+        // Samples the port one poll interval (1s) after the previous sample
+        void sample(const map<PortStat, uint64_t> &deltas)
+        {
+            for (const auto &delta : deltas)
+            {
+                m_counters[delta.first][0] += delta.second;
+            }
+            Portal::CounterSnapshotOrchInternal::sample(m_orch, CounterSnapshotGroup::PORT, m_counters, alpha);
+        }
+
+        bool getRates(map<string, double> &rates)
+        {
+            Table ratesTable(m_counters_db.get(), "RATES");
+            vector<FieldValueTuple> fvs;
+            if (!ratesTable.get(portOid, fvs))
+            {
+                return false;
+            }
+
+            rates.clear();
+            for (const auto &fv : fvs)
+            {
+                rates[fvField(fv)] = stod(fvValue(fv));
+            }
+            return true;
+        }
+    };
+
+    TEST_F(CounterSnapshotOrchTest, FirstSampleOnlyRecordsCounters)
+    {
+        map<string, double> rates;
+
+        sample({ { IN_UCAST_PKTS, 1000 }, { IN_OCTETS, 100000 } });
+        ASSERT_FALSE(getRates(rates));
+
+        // The first rate is taken from the counters of the first sample, not from 0
+        sample({ { IN_UCAST_PKTS, 100 }, { IN_OCTETS, 10000 } });
+        ASSERT_TRUE(getRates(rates));
+        ASSERT_DOUBLE_EQ(rates["RX_PPS"], 100);
+        ASSERT_DOUBLE_EQ(rates["RX_BPS"], 10000);
+        ASSERT_DOUBLE_EQ(rates["TX_PPS"], 0);
+        ASSERT_DOUBLE_EQ(rates["TX_BPS"], 0);
+    }
+
+    TEST_F(CounterSnapshotOrchTest, RatesAreSmoothed)
+    {
+        map<string, double> rates;
+
+        sample({});
+
+        // The first rate is not smoothed
+        sample({ { IN_UCAST_PKTS, 200 }, { IN_NON_UCAST_PKTS, 100 }, { IN_OCTETS, 20000 },
+                 { OUT_UCAST_PKTS, 100 }, { OUT_NON_UCAST_PKTS, 50 }, { OUT_OCTETS, 10000 } });
+        ASSERT_TRUE(getRates(rates));
+        ASSERT_DOUBLE_EQ(rates["RX_PPS"], 300);
+        ASSERT_DOUBLE_EQ(rates["RX_BPS"], 20000);
+        ASSERT_DOUBLE_EQ(rates["TX_PPS"], 150);
+        ASSERT_DOUBLE_EQ(rates["TX_BPS"], 10000);
+
+        // The next ones are alpha * rate + (1 - alpha) * previous value
+        sample({ { IN_UCAST_PKTS, 100 }, { IN_OCTETS, 10000 } });
+        ASSERT_TRUE(getRates(rates));
+        ASSERT_DOUBLE_EQ(rates["RX_PPS"], 200);
+        ASSERT_DOUBLE_EQ(rates["RX_BPS"], 15000);
+        ASSERT_DOUBLE_EQ(rates["TX_PPS"], 75);
+        ASSERT_DOUBLE_EQ(rates["TX_BPS"], 5000);
+
+        // An unchanged snapshot may be a repeated read, it only counts as idle on the next poll
+        sample({});
+        ASSERT_TRUE(getRates(rates));
+        ASSERT_DOUBLE_EQ(rates["RX_PPS"], 200);
+
+        sample({});
+        ASSERT_TRUE(getRates(rates));
+        ASSERT_DOUBLE_EQ(rates["RX_PPS"], 100);
+        ASSERT_DOUBLE_EQ(rates["RX_BPS"], 7500);
+        ASSERT_DOUBLE_EQ(rates["TX_PPS"], 37.5);
+        ASSERT_DOUBLE_EQ(rates["TX_BPS"], 2500);
+    }
+
+    TEST_F(CounterSnapshotOrchTest, RestartsAfterCountersAreCleared)
+    {
+        map<string, double> rates;
+
+        sample({});
+        sample({ { IN_UCAST_PKTS, 100 }, { IN_OCTETS, 10000 } });
+
+        // Counters going back don't make a negative rate
+        m_counters.assign(PORT_STAT_COUNT, { 0 });
+        sample({ { IN_UCAST_PKTS, 10 } });
+        ASSERT_TRUE(getRates(rates));
+        ASSERT_DOUBLE_EQ(rates["RX_PPS"], 50);
+        ASSERT_DOUBLE_EQ(rates["RX_BPS"], 5000);
+    }
+}
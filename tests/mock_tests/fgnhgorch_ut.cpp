@@ -0,0 +1,264 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+extern sai_next_hop_group_api_t *sai_next_hop_group_api;
+
+namespace fgnhgorch_test
+{
+    using namespace std;
+
+    const IpPrefix fgPrefix("2.2.2.0/24");
+
+    const sai_object_id_t nh1Id = 0x4000000000001;
+    const sai_object_id_t nh2Id = 0x4000000000002;
+    const sai_object_id_t nh3Id = 0x4000000000003;
+    const sai_object_id_t memberBase = 0x2d000000000000;
+
+    // Next hop of each hash bucket member as seen by the fake SAI
+    map<sai_object_id_t, sai_object_id_t> asicMembers;
+    sai_object_id_t failingMember;
+
+    sai_status_t setMemberAttribute(sai_object_id_t member, const sai_attribute_t *attr)
+    {
+        if (member == failingMember)
+        {
+            return SAI_STATUS_FAILURE;
+        }
+
+        asicMembers[member] = attr->value.oid;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t setMembersAttribute(uint32_t count, const sai_object_id_t *members, const sai_attribute_t *attrs,
+                                     sai_bulk_op_error_mode_t mode, sai_status_t *statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                statuses[i] = SAI_STATUS_NOT_EXECUTED;
+                continue;
+            }
+
+            statuses[i] = setMemberAttribute(members[i], &attrs[i]);
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    struct FgNhgOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+        sai_next_hop_group_api_t m_next_hop_group_api;
+        sai_next_hop_group_api_t *m_saved_next_hop_group_api;
+
+        FgNhgOrchTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            const int fgnhgorch_pri = 15;
+
+            vector<table_name_with_pri_t> fgnhg_tables = {
+                { CFG_FG_NHG,                 fgnhgorch_pri },
+                { CFG_FG_NHG_PREFIX,          fgnhgorch_pri },
+                { CFG_FG_NHG_MEMBER,          fgnhgorch_pri }
+            };
+
+            ASSERT_EQ(gFgNhgOrch, nullptr);
+            gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+            // Hash bucket members are rewritten through the fake SAI
+            m_saved_next_hop_group_api = sai_next_hop_group_api;
+            m_next_hop_group_api = {};
+            m_next_hop_group_api.set_next_hop_group_member_attribute = setMemberAttribute;
+#ifdef HAVE_SAI_BULK_NHGM_SET
+            m_next_hop_group_api.set_next_hop_group_members_attribute = setMembersAttribute;
+#endif
+            sai_next_hop_group_api = &m_next_hop_group_api;
+
+            asicMembers.clear();
+            failingMember = SAI_NULL_OBJECT_ID;
+        }
+
+        virtual void TearDown() override
+        {
+            sai_next_hop_group_api = m_saved_next_hop_group_api;
+
+            delete gFgNhgOrch;
+            gFgNhgOrch = nullptr;
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+
+            ::testing_db::reset();
+        }
+
+        static void SetUpTestCase()
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+
+        static void TearDownTestCase()
+        {
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+        }
+    };
+
+    TEST_F(FgNhgOrchTest, HashBucketChangesRolledBackOnPartialFailure)
+    {
+        NextHopKey nh1("10.0.0.1@Ethernet0");
+        NextHopKey nh2("10.0.0.2@Ethernet4");
+        NextHopKey nh3("10.0.0.3@Ethernet8");
+
+        Portal::NeighOrchInternal::addSyncdNextHop(gNeighOrch, nh1, nh1Id);
+        Portal::NeighOrchInternal::addSyncdNextHop(gNeighOrch, nh2, nh2Id);
+        Portal::NeighOrchInternal::addSyncdNextHop(gNeighOrch, nh3, nh3Id);
+
+        // A single bank of 6 hash buckets, 2 per next hop
+        FgNhgEntry fgNhgEntry;
+        fgNhgEntry.fg_nhg_name = "fgnhg_v4";
+        fgNhgEntry.configured_bucket_size = 6;
+        fgNhgEntry.real_bucket_size = 6;
+        fgNhgEntry.hash_bucket_indices = { { 0, 5 } };
+        fgNhgEntry.match_mode = ROUTE_BASED;
+
+        FGNextHopGroupEntry routeEntry;
+        routeEntry.next_hop_group_id = 0x5000000000001;
+        routeEntry.active_nexthops = { nh1, nh2, nh3 };
+        routeEntry.syncd_fgnhg_map = { { { nh1, { 0, 1 } }, { nh2, { 2, 3 } }, { nh3, { 4, 5 } } } };
+        routeEntry.inactive_to_active_map = { { 0, 0 } };
+
+        Table fgRouteTable(m_state_db.get(), STATE_FG_ROUTE_TABLE_NAME);
+        vector<FieldValueTuple> bucketNextHops;
+        for (uint32_t i = 0; i < fgNhgEntry.real_bucket_size; i++)
+        {
+            sai_object_id_t member = memberBase + i;
+            routeEntry.nhopgroup_members.push_back(member);
+
+            const NextHopKey &nh = (i < 2) ? nh1 : (i < 4) ? nh2 : nh3;
+            asicMembers[member] = gNeighOrch->getNextHopId(nh);
+            bucketNextHops.emplace_back(to_string(i), nh.to_string());
+        }
+        fgRouteTable.set(fgPrefix.to_string(), bucketNextHops);
+
+        auto prevFgnhgMap = routeEntry.syncd_fgnhg_map;
+        auto prevActiveNextHops = routeEntry.active_nexthops;
+        auto prevAsicMembers = asicMembers;
+
+        // nh3 goes down, buckets 4 and 5 move to nh1 and nh2 but the rewrite of bucket 5 fails
+        BankMemberChanges bankMemberChange;
+        bankMemberChange.nhs_to_del = { nh3 };
+        bankMemberChange.active_nhs = { nh1, nh2 };
+        vector<BankMemberChanges> bankMemberChanges = { bankMemberChange };
+        map<NextHopKey, sai_object_id_t> nhopgroupMembersSet = { { nh1, nh1Id }, { nh2, nh2Id } };
+
+        failingMember = memberBase + 5;
+
+        ASSERT_FALSE(Portal::FgNhgOrchInternal::computeAndSetHashBucketChanges(gFgNhgOrch, &routeEntry,
+                &fgNhgEntry, bankMemberChanges, nhopgroupMembersSet, fgPrefix));
+
+        // The route keeps its buckets and next hops so that the change is retried from scratch
+        ASSERT_EQ(routeEntry.syncd_fgnhg_map, prevFgnhgMap);
+        ASSERT_EQ(routeEntry.active_nexthops, prevActiveNextHops);
+
+        // The bucket already rewritten is set back to its previous next hop
+        ASSERT_EQ(asicMembers, prevAsicMembers);
+
+        for (uint32_t i = 0; i < fgNhgEntry.real_bucket_size; i++)
+        {
+            string value;
+            ASSERT_TRUE(fgRouteTable.hget(fgPrefix.to_string(), to_string(i), value));
+            ASSERT_EQ(value, fvValue(bucketNextHops[i]));
+        }
+
+        // Once the member can be written the change goes through
+        failingMember = SAI_NULL_OBJECT_ID;
+
+        ASSERT_TRUE(Portal::FgNhgOrchInternal::computeAndSetHashBucketChanges(gFgNhgOrch, &routeEntry,
+                &fgNhgEntry, bankMemberChanges, nhopgroupMembersSet, fgPrefix));
+
+        ASSERT_EQ(routeEntry.active_nexthops, ActiveNextHops({ nh1, nh2 }));
+        ASSERT_EQ(asicMembers[memberBase + 4], nh1Id);
+        ASSERT_EQ(asicMembers[memberBase + 5], nh2Id);
+
+        string value;
+        ASSERT_TRUE(fgRouteTable.hget(fgPrefix.to_string(), "4", value));
+        ASSERT_EQ(value, nh1.to_string());
+        ASSERT_TRUE(fgRouteTable.hget(fgPrefix.to_string(), "5", value));
+        ASSERT_EQ(value, nh2.to_string());
+    }
+}
@@ -0,0 +1,396 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "muxorch.h"
+
+extern Directory<Orch*> gDirectory;
+extern string gMySwitchType;
+
+namespace neighorch_test
+{
+    using namespace std;
+
+    const sai_object_id_t rifId = 0x6000000000001;
+    const sai_object_id_t nextHopIdBase = 0x4000000000000;
+
+    // Neighbors and next hops created through the fake SAI
+    vector<sai_neighbor_entry_t> createdNeighbors;
+    vector<sai_object_id_t> createdNextHops;
+    vector<uint32_t> bulkNeighborCreates;
+    vector<uint32_t> bulkNextHopCreates;
+
+    sai_status_t createNeighbor(const sai_neighbor_entry_t *neighbor_entry, uint32_t attr_count,
+                                const sai_attribute_t *attr_list)
+    {
+        createdNeighbors.push_back(*neighbor_entry);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeNeighbor(const sai_neighbor_entry_t *neighbor_entry)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNeighbors(uint32_t object_count, const sai_neighbor_entry_t *neighbor_entry,
+                                 const uint32_t *attr_count, const sai_attribute_t **attr_list,
+                                 sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkNeighborCreates.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = createNeighbor(&neighbor_entry[i], attr_count[i], attr_list[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNeighborsNotImplemented(uint32_t object_count, const sai_neighbor_entry_t *neighbor_entry,
+                                               const uint32_t *attr_count, const sai_attribute_t **attr_list,
+                                               sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkNeighborCreates.push_back(object_count);
+        return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+
+    sai_status_t createNextHop(sai_object_id_t *next_hop_id, sai_object_id_t switch_id, uint32_t attr_count,
+                               const sai_attribute_t *attr_list)
+    {
+        *next_hop_id = nextHopIdBase + createdNextHops.size() + 1;
+        createdNextHops.push_back(*next_hop_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeNextHop(sai_object_id_t next_hop_id)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNextHops(sai_object_id_t switch_id, uint32_t object_count, const uint32_t *attr_count,
+                                const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+                                sai_object_id_t *object_id, sai_status_t *object_statuses)
+    {
+        bulkNextHopCreates.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = createNextHop(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNextHopsNotImplemented(sai_object_id_t switch_id, uint32_t object_count, const uint32_t *attr_count,
+                                              const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+                                              sai_object_id_t *object_id, sai_status_t *object_statuses)
+    {
+        bulkNextHopCreates.push_back(object_count);
+        return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+
+    struct NeighborBulkObserver : public Observer
+    {
+        vector<NeighborBulkUpdate> bulkUpdates;
+
+        void update(SubjectType type, void *cntx) override
+        {
+            if (type == SUBJECT_TYPE_NEIGH_BULK_CHANGE)
+            {
+                bulkUpdates.push_back(*static_cast<NeighborBulkUpdate *>(cntx));
+            }
+        }
+    };
+
+    struct NeighOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+        sai_neighbor_api_t m_neighbor_api;
+        sai_next_hop_api_t m_next_hop_api;
+        sai_neighbor_api_t *m_saved_neighbor_api;
+        sai_next_hop_api_t *m_saved_next_hop_api;
+        string m_saved_switch_type;
+
+        MuxOrch *m_mux_orch = nullptr;
+
+        NeighOrchTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            // Neighbors are only bulked on a non VOQ switch
+            m_saved_switch_type = gMySwitchType;
+            gMySwitchType = "switch";
+
+            // Neighbors and next hops are created through the fake SAI
+            m_saved_neighbor_api = sai_neighbor_api;
+            m_neighbor_api = {};
+            m_neighbor_api.create_neighbor_entry = createNeighbor;
+            m_neighbor_api.remove_neighbor_entry = removeNeighbor;
+            m_neighbor_api.create_neighbor_entries = createNeighbors;
+            sai_neighbor_api = &m_neighbor_api;
+
+            m_saved_next_hop_api = sai_next_hop_api;
+            m_next_hop_api = {};
+            m_next_hop_api.create_next_hop = createNextHop;
+            m_next_hop_api.remove_next_hop = removeNextHop;
+            m_next_hop_api.create_next_hops = createNextHops;
+            sai_next_hop_api = &m_next_hop_api;
+
+            createdNeighbors.clear();
+            createdNextHops.clear();
+            bulkNeighborCreates.clear();
+            bulkNextHopCreates.clear();
+        }
+
+        virtual void TearDown() override
+        {
+            if (m_mux_orch)
+            {
+                Portal::DirectoryInternal::remove<MuxOrch *>(gDirectory);
+                delete m_mux_orch;
+                m_mux_orch = nullptr;
+            }
+
+            delete gFgNhgOrch;
+            gFgNhgOrch = nullptr;
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+
+            sai_neighbor_api = m_saved_neighbor_api;
+            sai_next_hop_api = m_saved_next_hop_api;
+            gMySwitchType = m_saved_switch_type;
+
+            ::testing_db::reset();
+        }
+
+        // The bulkers take the SAI API when NeighOrch is created
+        void createOrchs()
+        {
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables);
+
+            // A routed port with its router interface
+            Port port("Ethernet0", Port::PHY);
+            port.m_rif_id = rifId;
+            port.m_oper_status = SAI_PORT_OPER_STATUS_UP;
+            Portal::PortsOrchInternal::addPort(gPortsOrch, port);
+            Portal::PortsOrchInternal::setInitDone(gPortsOrch);
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            const int fgnhgorch_pri = 15;
+
+            vector<table_name_with_pri_t> fgnhg_tables = {
+                { CFG_FG_NHG,                 fgnhgorch_pri },
+                { CFG_FG_NHG_PREFIX,          fgnhgorch_pri },
+                { CFG_FG_NHG_MEMBER,          fgnhgorch_pri }
+            };
+
+            ASSERT_EQ(gFgNhgOrch, nullptr);
+            gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+            vector<string> mux_tables = { CFG_MUX_CABLE_TABLE_NAME, CFG_PEER_SWITCH_TABLE_NAME };
+            m_mux_orch = new MuxOrch(m_config_db.get(), mux_tables, nullptr, gNeighOrch);
+            gDirectory.set(m_mux_orch);
+        }
+
+        void addNeighbors(const vector<string> &ips)
+        {
+            Table neighTable(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+            for (size_t i = 0; i < ips.size(); i++)
+            {
+                neighTable.set("Ethernet0:" + ips[i],
+                    {
+                        { "neigh", "00:00:00:00:01:0" + to_string(i + 1) },
+                        { "family", "IPv4" }
+                    });
+            }
+
+            gNeighOrch->addExistingData(&neighTable);
+            static_cast<Orch *>(gNeighOrch)->doTask();
+        }
+
+        size_t pendingNeighbors()
+        {
+            auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+            return consumer->m_toSync.size();
+        }
+
+        void checkNeighbors(const vector<string> &ips)
+        {
+            for (const auto &ip : ips)
+            {
+                NextHopKey nexthop(IpAddress(ip), "Ethernet0");
+                ASSERT_TRUE(gNeighOrch->hasNextHop(nexthop));
+                ASSERT_NE(find(createdNextHops.begin(), createdNextHops.end(), gNeighOrch->getNextHopId(nexthop)),
+                          createdNextHops.end());
+            }
+        }
+
+        static void SetUpTestCase()
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+
+        static void TearDownTestCase()
+        {
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+        }
+    };
+
+    TEST_F(NeighOrchTest, NeighborsOfOnePassAreBulked)
+    {
+        createOrchs();
+
+        NeighborBulkObserver observer;
+        gNeighOrch->attach(&observer);
+
+        vector<string> ips = { "10.0.0.1", "10.0.0.2", "10.0.0.3" };
+        addNeighbors(ips);
+
+        ASSERT_EQ(pendingNeighbors(), 0u);
+
+        // One bulk call for the neighbors, then one for their next hops
+        ASSERT_EQ(bulkNeighborCreates, vector<uint32_t>({ 3 }));
+        ASSERT_EQ(bulkNextHopCreates, vector<uint32_t>({ 3 }));
+        ASSERT_EQ(createdNeighbors.size(), 3u);
+        ASSERT_EQ(createdNextHops.size(), 3u);
+
+        for (const auto &neighbor : createdNeighbors)
+        {
+            ASSERT_EQ(neighbor.rif_id, rifId);
+        }
+        checkNeighbors(ips);
+
+        // The observers get all the neighbors of the pass in one notification
+        ASSERT_EQ(observer.bulkUpdates.size(), 1u);
+        const auto &updates = observer.bulkUpdates[0].updates;
+        ASSERT_EQ(updates.size(), 3u);
+        for (size_t i = 0; i < updates.size(); i++)
+        {
+            ASSERT_TRUE(updates[i].add);
+            ASSERT_EQ(updates[i].entry.alias, "Ethernet0");
+            ASSERT_EQ(updates[i].entry.ip_address, IpAddress(ips[i]));
+            ASSERT_EQ(updates[i].mac, MacAddress("00:00:00:00:01:0" + to_string(i + 1)));
+        }
+
+        gNeighOrch->detach(&observer);
+    }
+
+    TEST_F(NeighOrchTest, NeighborsFallBackToSerialCreateWithoutBulkApi)
+    {
+        // The SAI has no bulk neighbor create and doesn't implement the bulk next hop create
+        m_neighbor_api.create_neighbor_entries = nullptr;
+        m_next_hop_api.create_next_hops = createNextHopsNotImplemented;
+
+        createOrchs();
+
+        NeighborBulkObserver observer;
+        gNeighOrch->attach(&observer);
+
+        addNeighbors({ "10.0.0.1", "10.0.0.2" });
+
+        ASSERT_EQ(pendingNeighbors(), 0u);
+        ASSERT_EQ(createdNeighbors.size(), 2u);
+        ASSERT_EQ(createdNextHops.size(), 2u);
+        checkNeighbors({ "10.0.0.1", "10.0.0.2" });
+
+        ASSERT_EQ(observer.bulkUpdates.size(), 1u);
+        ASSERT_EQ(observer.bulkUpdates[0].updates.size(), 2u);
+
+        // The unsupported bulk API is only tried once
+        addNeighbors({ "10.0.0.1", "10.0.0.2", "10.0.0.3" });
+
+        ASSERT_EQ(pendingNeighbors(), 0u);
+        ASSERT_EQ(createdNeighbors.size(), 3u);
+        ASSERT_EQ(createdNextHops.size(), 3u);
+        ASSERT_TRUE(bulkNeighborCreates.empty());
+        ASSERT_EQ(bulkNextHopCreates, vector<uint32_t>({ 2 }));
+        checkNeighbors({ "10.0.0.3" });
+
+        ASSERT_EQ(observer.bulkUpdates.size(), 2u);
+        ASSERT_EQ(observer.bulkUpdates[1].updates.size(), 1u);
+
+        gNeighOrch->detach(&observer);
+    }
+
+    TEST_F(NeighOrchTest, NeighborsFallBackToSerialCreateWhenBulkNotImplemented)
+    {
+        m_neighbor_api.create_neighbor_entries = createNeighborsNotImplemented;
+
+        createOrchs();
+
+        addNeighbors({ "10.0.0.1", "10.0.0.2" });
+
+        ASSERT_EQ(pendingNeighbors(), 0u);
+        ASSERT_EQ(bulkNeighborCreates, vector<uint32_t>({ 2 }));
+        ASSERT_EQ(createdNeighbors.size(), 2u);
+        ASSERT_EQ(createdNextHops.size(), 2u);
+        checkNeighbors({ "10.0.0.1", "10.0.0.2" });
+    }
+}
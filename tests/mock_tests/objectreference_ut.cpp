@@ -0,0 +1,201 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+
+namespace objectreference_test
+{
+    using namespace std;
+
+    const string poolTable = APP_BUFFER_POOL_TABLE_NAME;
+    const string profileTable = APP_BUFFER_PROFILE_TABLE_NAME;
+    const string pgTable = APP_BUFFER_PG_TABLE_NAME;
+    const string queueTable = APP_BUFFER_QUEUE_TABLE_NAME;
+
+    // Same size as a 128 ports buffer config
+    const size_t portCount = 128;
+    const size_t pgCount = 8;
+    const size_t queueCount = 8;
+
+    // Exposes the object reference tracking of Orch
+    class ReferenceOrch : public Orch
+    {
+    public:
+        ReferenceOrch(swss::DBConnector *db) :
+            Orch(db, "REFERENCE_TEST_TABLE")
+        {
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+        }
+
+        using Orch::resolveFieldRefValue;
+        using Orch::resolveFieldRefArray;
+        using Orch::setObjectReference;
+        using Orch::removeObject;
+        using Orch::isObjectBeingReferenced;
+        using Orch::objectReferenceInfo;
+    };
+
+    struct ObjectReferenceTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        unique_ptr<ReferenceOrch> m_orch;
+
+        object_reference_map m_pools;
+        object_reference_map m_profiles;
+        object_reference_map m_pgs;
+        object_reference_map m_queues;
+        type_map m_typeMaps;
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_orch = unique_ptr<ReferenceOrch>(new ReferenceOrch(m_app_db.get()));
+
+            m_typeMaps = {
+                { poolTable, &m_pools },
+                { profileTable, &m_profiles },
+                { pgTable, &m_pgs },
+                { queueTable, &m_queues }
+            };
+
+            m_pools["ingress_pool"].m_saiObjectId = 0x10;
+            m_pools["egress_pool"].m_saiObjectId = 0x11;
+            addProfile("pg_lossless", "ingress_pool", 0x20);
+            addProfile("pg_lossy", "ingress_pool", 0x21);
+            addProfile("q_lossless", "egress_pool", 0x22);
+            addProfile("q_lossy", "egress_pool", 0x23);
+        }
+
+        virtual void TearDown() override
+        {
+            m_orch.reset();
+            ::testing_db::reset();
+        }
+
+        void addProfile(const string &name, const string &pool, sai_object_id_t oid)
+        {
+            m_profiles[name].m_saiObjectId = oid;
+            m_orch->setObjectReference(m_typeMaps, profileTable, name, "pool", poolTable + delimiter + pool);
+        }
+
+        static string objectName(size_t port, size_t index)
+        {
+            return "Ethernet" + to_string(port * 4) + delimiter + to_string(index);
+        }
+
+        void addPortBuffers()
+        {
+            for (size_t port = 0; port < portCount; port++)
+            {
+                for (size_t pg = 0; pg < pgCount; pg++)
+                {
+                    string profile = (pg == 3 || pg == 4) ? "pg_lossless" : "pg_lossy";
+                    m_orch->setObjectReference(m_typeMaps, pgTable, objectName(port, pg), "profile", profileTable + delimiter + profile);
+                }
+
+                for (size_t queue = 0; queue < queueCount; queue++)
+                {
+                    string profile = (queue == 3 || queue == 4) ? "q_lossless" : "q_lossy";
+                    m_orch->setObjectReference(m_typeMaps, queueTable, objectName(port, queue), "profile", profileTable + delimiter + profile);
+                }
+            }
+        }
+
+        size_t referenceCount(const string &table, const string &name)
+        {
+            return (*m_typeMaps[table])[name].m_objsDependingOnMe.size();
+        }
+    };
+
+    TEST_F(ObjectReferenceTest, ResolvesReferences)
+    {
+        KeyOpFieldsValuesTuple tuple("Ethernet0:3", SET_COMMAND, { { "profile", "[BUFFER_PROFILE_TABLE:pg_lossless]" } });
+        sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+        string name;
+
+        ASSERT_EQ(m_orch->resolveFieldRefValue(m_typeMaps, "profile", tuple, oid, name), ref_resolve_status::success);
+        ASSERT_EQ(oid, 0x20);
+        ASSERT_EQ(name, profileTable + delimiter + "pg_lossless");
+
+        // Config DB separator
+        kfvFieldsValues(tuple) = { { "profile", "[BUFFER_PROFILE_TABLE|pg_lossy]" } };
+        ASSERT_EQ(m_orch->resolveFieldRefValue(m_typeMaps, "profile", tuple, oid, name), ref_resolve_status::success);
+        ASSERT_EQ(oid, 0x21);
+
+        kfvFieldsValues(tuple) = { { "profile", "[]" } };
+        ASSERT_EQ(m_orch->resolveFieldRefValue(m_typeMaps, "profile", tuple, oid, name), ref_resolve_status::empty);
+
+        for (auto ref : { "[BUFFER_PROFILE_TABLE:unknown]", "[UNKNOWN_TABLE:pg_lossy]",
+                          "[BUFFER_PROFILE_TABLE:pg_lossy:0]", "[BUFFER_PROFILE_TABLE:]", "BUFFER_PROFILE_TABLE:pg_lossy" })
+        {
+            kfvFieldsValues(tuple) = { { "profile", ref } };
+            ASSERT_EQ(m_orch->resolveFieldRefValue(m_typeMaps, "profile", tuple, oid, name), ref_resolve_status::not_resolved) << ref;
+        }
+
+        kfvFieldsValues(tuple) = { { "profile_list", "[BUFFER_PROFILE_TABLE:q_lossless],[BUFFER_PROFILE_TABLE:q_lossy]" } };
+        vector<sai_object_id_t> oids;
+        string names;
+        ASSERT_EQ(m_orch->resolveFieldRefArray(m_typeMaps, "profile_list", tuple, oids, names), ref_resolve_status::success);
+        ASSERT_EQ(oids, (vector<sai_object_id_t>{ 0x22, 0x23 }));
+        ASSERT_EQ(names, "BUFFER_PROFILE_TABLE:q_lossless,BUFFER_PROFILE_TABLE:q_lossy");
+    }
+
+    TEST_F(ObjectReferenceTest, TracksPortBufferReferences)
+    {
+        addPortBuffers();
+
+        ASSERT_EQ(referenceCount(poolTable, "ingress_pool"), 2);
+        ASSERT_EQ(referenceCount(profileTable, "pg_lossless"), portCount * 2);
+        ASSERT_EQ(referenceCount(profileTable, "pg_lossy"), portCount * (pgCount - 2));
+        ASSERT_EQ(referenceCount(profileTable, "q_lossy"), portCount * (queueCount - 2));
+        ASSERT_TRUE(m_orch->isObjectBeingReferenced(m_typeMaps, profileTable, "q_lossless"));
+
+        // Moving a queue to another profile drops the old reference
+        m_orch->setObjectReference(m_typeMaps, queueTable, objectName(0, 3), "profile", profileTable + delimiter + "q_lossy");
+        ASSERT_EQ(referenceCount(profileTable, "q_lossless"), portCount * 2 - 1);
+        ASSERT_EQ(referenceCount(profileTable, "q_lossy"), portCount * (queueCount - 2) + 1);
+
+        // PGs and queues share their names, removing the PGs leaves the queue references
+        for (size_t port = 0; port < portCount; port++)
+        {
+            for (size_t pg = 0; pg < pgCount; pg++)
+            {
+                m_orch->removeObject(m_typeMaps, pgTable, objectName(port, pg));
+            }
+        }
+
+        ASSERT_TRUE(m_pgs.empty());
+        ASSERT_FALSE(m_orch->isObjectBeingReferenced(m_typeMaps, profileTable, "pg_lossless"));
+        ASSERT_FALSE(m_orch->isObjectBeingReferenced(m_typeMaps, profileTable, "pg_lossy"));
+        ASSERT_EQ(referenceCount(profileTable, "q_lossless"), portCount * 2 - 1);
+
+        // Unreferenced objects can be removed, and unknown ones are not added by the checks
+        m_orch->removeObject(m_typeMaps, profileTable, "pg_lossless");
+        ASSERT_EQ(referenceCount(poolTable, "ingress_pool"), 1);
+        ASSERT_FALSE(m_orch->isObjectBeingReferenced(m_typeMaps, profileTable, "pg_lossless"));
+        ASSERT_EQ(m_orch->objectReferenceInfo(m_typeMaps, profileTable, "pg_lossless"), "reference count: 0");
+        ASSERT_EQ(m_profiles.count("pg_lossless"), 0);
+    }
+
+    TEST_F(ObjectReferenceTest, RemovesReferencedObject)
+    {
+        m_orch->setObjectReference(m_typeMaps, queueTable, objectName(0, 0), "profile", profileTable + delimiter + "q_lossy");
+
+        // The queue drops its reference to the removed profile
+        m_orch->removeObject(m_typeMaps, profileTable, "q_lossy");
+        ASSERT_TRUE(m_queues[objectName(0, 0)].m_objsReferencingByMe["profile"].empty());
+        ASSERT_EQ(referenceCount(poolTable, "egress_pool"), 1);
+
+        m_orch->setObjectReference(m_typeMaps, queueTable, objectName(0, 0), "profile", profileTable + delimiter + "q_lossless");
+        ASSERT_EQ(referenceCount(profileTable, "q_lossless"), 1);
+
+        auto hint = m_orch->objectReferenceInfo(m_typeMaps, profileTable, "q_lossless");
+        ASSERT_EQ(hint, profileTable + " q_lossless one object: " + objectName(0, 0) + " reference count: 1");
+
+        m_orch->removeObject(m_typeMaps, queueTable, objectName(0, 0));
+        ASSERT_FALSE(m_orch->isObjectBeingReferenced(m_typeMaps, profileTable, "q_lossless"));
+    }
+}
@@ -0,0 +1,127 @@
+#include "ut_helper.h"
+#include "pfcwddetector.h"
+
+namespace pfcwddetector_test
+{
+    using namespace std;
+
+    // Poll interval and times are in microseconds, as in the Lua plugins
+    const uint32_t pollTime = 100 * 1000;
+    const uint32_t detectionTime = 400 * 1000;
+    const uint32_t restorationTime = 600 * 1000;
+    const sai_object_id_t queueId = 0x1500000000001;
+    const sai_object_id_t portId = 0x1000000000001;
+
+    struct PfcWdDetectorTest : public ::testing::Test
+    {
+        PfcWdQueueSample sample;
+
+        PfcWdDetectorTest()
+        {
+            sample.valid = true;
+            sample.hasPauseStatus = true;
+        }
+
+        // Traffic flows, no PFC frames received
+        void tickIdle()
+        {
+            sample.packets += 1000;
+            sample.occupancyBytes = 0;
+            sample.pauseStatus = false;
+        }
+
+        // Queue holds data and doesn't transmit while PFC frames keep coming
+        void tickStorm()
+        {
+            sample.occupancyBytes = 9000;
+            sample.pfcRxPackets += 500;
+            sample.pfcAux += pollTime;
+            sample.pauseStatus = true;
+        }
+
+        // Polls until the detector reports an event, returns the number of polls
+        size_t pollUntilEvent(PfcWdDetector &detector, void (PfcWdDetectorTest::*tick)(), const string &expected, size_t maxPolls)
+        {
+            for (size_t i = 1; i <= maxPolls; i++)
+            {
+                (this->*tick)();
+                string event = detector.evaluate(queueId, sample, pollTime);
+                if (!event.empty())
+                {
+                    EXPECT_EQ(event, expected);
+                    return i;
+                }
+            }
+
+            return 0;
+        }
+    };
+
+    TEST_F(PfcWdDetectorTest, DetectAndRestoreStorm)
+    {
+        PfcWdDetectCriteria criteria;
+        ASSERT_TRUE(PfcWdDetector::getCriteria("broadcom", criteria));
+
+        PfcWdDetector detector(criteria);
+        detector.addQueue(queueId, portId, 3, detectionTime, restorationTime, false);
+        ASSERT_EQ(detector.size(), 1u);
+
+        // No storm under normal traffic
+        ASSERT_EQ(pollUntilEvent(detector, &PfcWdDetectorTest::tickIdle, PFC_WD_EVENT_STORM, 20), 0u);
+
+        // Storm is reported after detectionTime of consecutive storm samples
+        size_t polls = pollUntilEvent(detector, &PfcWdDetectorTest::tickStorm, PFC_WD_EVENT_STORM, 20);
+        ASSERT_EQ(polls, detectionTime / pollTime);
+        detector.setStormed(queueId, true);
+
+        // Restoration is not reported while the storm goes on
+        ASSERT_EQ(pollUntilEvent(detector, &PfcWdDetectorTest::tickStorm, PFC_WD_EVENT_RESTORE, 20), 0u);
+
+        polls = pollUntilEvent(detector, &PfcWdDetectorTest::tickIdle, PFC_WD_EVENT_RESTORE, 20);
+        ASSERT_EQ(polls, restorationTime / pollTime);
+    }
+
+    TEST_F(PfcWdDetectorTest, RepeatedSampleDoesNotResetDetection)
+    {
+        PfcWdDetector detector(PfcWdDetectCriteria::PFC_WD_CRITERIA_BROADCOM);
+        detector.addQueue(queueId, portId, 3, detectionTime, restorationTime, false);
+
+        tickIdle();
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), "");
+
+        tickStorm();
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), "");
+        tickStorm();
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), "");
+
+        // The same counters snapshot is read twice
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), "");
+
+        tickStorm();
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), "");
+        tickStorm();
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), PFC_WD_EVENT_STORM);
+    }
+
+    TEST_F(PfcWdDetectorTest, RemoveQueue)
+    {
+        PfcWdDetector detector(PfcWdDetectCriteria::PFC_WD_CRITERIA_MELLANOX);
+        detector.addQueue(queueId, portId, 3, detectionTime, restorationTime, false);
+        detector.addQueue(queueId + 1, portId, 4, detectionTime, restorationTime, false);
+        ASSERT_EQ(detector.size(), 2u);
+
+        detector.removeQueue(queueId);
+        ASSERT_EQ(detector.size(), 1u);
+        ASSERT_EQ(detector.evaluate(queueId, sample, pollTime), "");
+
+        // Storm on the remaining queue is still detected
+        sample.occupancyBytes = 0;
+        for (size_t i = 0; i < 4; i++)
+        {
+            sample.pfcAux += pollTime;
+            ASSERT_EQ(detector.evaluate(queueId + 1, sample, pollTime), "");
+        }
+        sample.pfcAux += pollTime;
+        ASSERT_EQ(detector.evaluate(queueId + 1, sample, pollTime), PFC_WD_EVENT_STORM);
+    }
+}
@@ -5,6 +5,13 @@
 
 #include "aclorch.h"
 #include "crmorch.h"
+#include "portsorch.h"
+#include "neighorch.h"
+#include "fgnhgorch.h"
+#include "tiered_flex_counter_manager.h"
+#include "countersnapshotorch.h"
+#include "vnetorch.h"
+#include "directory.h"
 
 #undef protected
 #undef private
@@ -59,4 +66,104 @@ struct Portal
             crmOrch->getResAvailableCounters();
         }
     };
+
+    struct OrchInternal
+    {
+        static bool isConsumerParked(Orch *orch, Consumer *consumer)
+        {
+            return orch->m_parkedConsumers.find(consumer) != orch->m_parkedConsumers.end();
+        }
+    };
+
+    struct PortsOrchInternal
+    {
+        static void addPort(PortsOrch *portsOrch, const Port &port)
+        {
+            portsOrch->m_portList[port.m_alias] = port;
+        }
+
+        static void setInitDone(PortsOrch *portsOrch)
+        {
+            portsOrch->m_initDone = true;
+        }
+    };
+
+    struct DirectoryInternal
+    {
+        template <typename U>
+        static void remove(Directory<Orch *> &directory)
+        {
+            directory.m_values.erase(typeid(U).name());
+        }
+    };
+
+    struct NeighOrchInternal
+    {
+        static void addSyncdNextHop(NeighOrch *neighOrch, const NextHopKey &nexthop, sai_object_id_t nextHopId)
+        {
+            neighOrch->m_syncdNextHops[nexthop] = { nextHopId, 0, 0 };
+        }
+    };
+
+    struct FgNhgOrchInternal
+    {
+        static bool computeAndSetHashBucketChanges(FgNhgOrch *fgNhgOrch, FGNextHopGroupEntry *syncdFgRouteEntry,
+                                                   FgNhgEntry *fgNhgEntry, std::vector<BankMemberChanges> &bankMemberChanges,
+                                                   std::map<NextHopKey, sai_object_id_t> &nhopgroupMembersSet,
+                                                   const IpPrefix &ipPrefix)
+        {
+            return fgNhgOrch->computeAndSetHashBucketChanges(syncdFgRouteEntry, fgNhgEntry, bankMemberChanges,
+                                                             nhopgroupMembersSet, ipPrefix);
+        }
+    };
+
+    struct VNetOrchInternal
+    {
+        // Adds a VNET without its VXLAN tunnel map, only its virtual router is created
+        static void addVnet(VNetOrch *vnetOrch, const std::string &name, const std::set<std::string> &peers)
+        {
+            VNetInfo vnetInfo = { "", 0, peers, "" };
+            std::vector<sai_attribute_t> attrs;
+            vnetOrch->vnet_table_[name] = VNetObject_T(new VNetVrfObject(name, vnetInfo, attrs));
+        }
+    };
+
+    struct CounterSnapshotOrchInternal
+    {
+        static CounterSnapshotOrch *create(swss::DBConnector *db)
+        {
+            std::vector<std::string> tableNames;
+            return new CounterSnapshotOrch(db, tableNames);
+        }
+
+        static void destroy(CounterSnapshotOrch *orch)
+        {
+            delete orch;
+        }
+
+        // Computes the rates from the counters of the group's objects, [stat][row]
+        static void sample(CounterSnapshotOrch *orch, CounterSnapshotGroup groupType,
+                           const std::vector<std::vector<uint64_t>> &counters, const std::string &alpha)
+        {
+            auto &group = orch->getGroup(groupType);
+            group.counters = counters;
+            orch->computeRates(group, std::vector<bool>(group.oids.size(), true), alpha);
+        }
+    };
+
+    struct TieredFlexCounterManagerInternal
+    {
+        static void applyCounterSums(TieredFlexCounterManager &manager,
+                                     const std::vector<sai_object_id_t> &objectIds,
+                                     const std::vector<uint64_t> &sums,
+                                     std::chrono::steady_clock::time_point now)
+        {
+            manager.applyCounterSums(objectIds, sums, std::vector<bool>(objectIds.size(), true), now);
+        }
+
+        static CounterTier getTier(const TieredFlexCounterManager &manager, sai_object_id_t objectId)
+        {
+            return manager.objects.at(objectId).tier;
+        }
+    };
 };
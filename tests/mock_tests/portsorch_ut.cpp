@@ -589,4 +589,109 @@ namespace portsorch_test
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
 
+    /*
+    * A port moved from one LAG to another in a single batch of LAG member
+    * updates has to be removed from the old LAG before it is added to the
+    * new one, whatever the order of the two keys in the consumer.
+    */
+    TEST_F(PortsOrchTest, LagMemberMovesBetweenLagsInOneBatch)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table lagTable = Table(m_app_db.get(), APP_LAG_TABLE_NAME);
+        Table lagMemberTable = Table(m_app_db.get(), APP_LAG_MEMBER_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Create dependencies ...
+        const int portsorch_base_pri = 40;
+
+        vector<table_name_with_pri_t> ports_tables = {
+            { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+            { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+            { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+            { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+            { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+        };
+
+        ASSERT_EQ(gPortsOrch, nullptr);
+        gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables);
+        vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                         APP_BUFFER_PROFILE_TABLE_NAME,
+                                         APP_BUFFER_QUEUE_TABLE_NAME,
+                                         APP_BUFFER_PG_TABLE_NAME,
+                                         APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                         APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+        ASSERT_EQ(gBufferOrch, nullptr);
+        gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+        // Populate port table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        for (auto lagName: { "PortChannel0001", "PortChannel0002" })
+        {
+            lagTable.set(lagName,
+                {
+                    {"admin_status", "up"},
+                    {"mtu", "9100"}
+                }
+            );
+        }
+
+        // The port starts in the second LAG
+        const auto &memberName = ports.begin()->first;
+        lagMemberTable.set(
+            std::string("PortChannel0002") + lagMemberTable.getTableNameSeparator() + memberName,
+            { {"status", "enabled"} });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&lagTable);
+        gPortsOrch->addExistingData(&lagMemberTable);
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        auto consumer = static_cast<Consumer*>(gPortsOrch->getExecutor(APP_LAG_MEMBER_TABLE_NAME));
+        vector<string> ts;
+        consumer->dumpPendingTasks(ts);
+        ASSERT_TRUE(ts.empty());
+
+        Port lag1, lag2, port;
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0002", lag2));
+        ASSERT_TRUE(gPortsOrch->getPort(memberName, port));
+        ASSERT_EQ(port.m_lag_id, lag2.m_lag_id);
+
+        // Move the port to the first LAG, its SET sorts before the DEL from the second LAG
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({ std::string("PortChannel0002") + lagMemberTable.getTableNameSeparator() + memberName,
+                            DEL_COMMAND, { } });
+        entries.push_back({ std::string("PortChannel0001") + lagMemberTable.getTableNameSeparator() + memberName,
+                            SET_COMMAND, { {"status", "enabled"} } });
+        consumer->addToSync(entries);
+
+        // The old membership is removed on the first pass, the new one created on the second
+        static_cast<Orch *>(gPortsOrch)->doTask();
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ts.clear();
+        consumer->dumpPendingTasks(ts);
+        ASSERT_TRUE(ts.empty());
+
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0001", lag1));
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0002", lag2));
+        ASSERT_TRUE(gPortsOrch->getPort(memberName, port));
+        ASSERT_EQ(port.m_lag_id, lag1.m_lag_id);
+        ASSERT_NE(port.m_lag_member_id, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(lag1.m_members.count(memberName), 1u);
+        ASSERT_TRUE(lag2.m_members.empty());
+    }
+
 }
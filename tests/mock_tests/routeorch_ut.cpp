@@ -0,0 +1,473 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "nhgorch.h"
+#include "sai_serialize.h"
+
+extern NhgOrch *gNhgOrch;
+extern sai_mpls_api_t *sai_mpls_api;
+extern sai_next_hop_group_api_t *sai_next_hop_group_api;
+
+namespace routeorch_test
+{
+    using namespace std;
+
+    const sai_object_id_t nh1Id = 0x4000000000001;
+    const sai_object_id_t nh2Id = 0x4000000000002;
+    const sai_object_id_t nh3Id = 0x4000000000003;
+    const sai_object_id_t nhgIdBase = 0x5000000000000;
+    const sai_object_id_t nhgmIdBase = 0x2d000000000000;
+
+    // Routes, next hop groups and members created through the fake SAI
+    map<string, sai_object_id_t> asicRoutes;
+    uint32_t asicIpv4Routes;
+    set<sai_object_id_t> asicNhgs;
+    set<sai_object_id_t> asicNhgMembers;
+    sai_object_id_t lastNhgId;
+    sai_object_id_t lastNhgmId;
+
+    // Size of the ASIC tables, as reported in the CRM available counters
+    uint32_t ipv4RouteCapacity;
+    uint32_t nhgCapacity;
+    sai_switch_api_t *savedSwitchApi;
+
+    sai_status_t getSwitchAttribute(sai_object_id_t switch_id, uint32_t attr_count, sai_attribute_t *attr_list)
+    {
+        if (attr_count == 1 && attr_list[0].id == SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY)
+        {
+            attr_list[0].value.u32 = ipv4RouteCapacity - asicIpv4Routes;
+            return SAI_STATUS_SUCCESS;
+        }
+
+        if (attr_count == 1 && attr_list[0].id == SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_ENTRY)
+        {
+            attr_list[0].value.u32 = nhgCapacity - static_cast<uint32_t>(asicNhgs.size());
+            return SAI_STATUS_SUCCESS;
+        }
+
+        return savedSwitchApi->get_switch_attribute(switch_id, attr_count, attr_list);
+    }
+
+    sai_status_t createRoute(const sai_route_entry_t *route_entry, uint32_t attr_count,
+                             const sai_attribute_t *attr_list)
+    {
+        sai_object_id_t nextHopId = SAI_NULL_OBJECT_ID;
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID)
+            {
+                nextHopId = attr_list[i].value.oid;
+            }
+        }
+
+        asicRoutes[sai_serialize_ip_prefix(route_entry->destination)] = nextHopId;
+        if (route_entry->destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            asicIpv4Routes++;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeRoute(const sai_route_entry_t *route_entry)
+    {
+        asicRoutes.erase(sai_serialize_ip_prefix(route_entry->destination));
+        if (route_entry->destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            asicIpv4Routes--;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t setRouteAttribute(const sai_route_entry_t *route_entry, const sai_attribute_t *attr)
+    {
+        if (attr->id == SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID)
+        {
+            asicRoutes[sai_serialize_ip_prefix(route_entry->destination)] = attr->value.oid;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createRoutes(uint32_t object_count, const sai_route_entry_t *route_entry,
+                              const uint32_t *attr_count, const sai_attribute_t **attr_list,
+                              sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = createRoute(&route_entry[i], attr_count[i], attr_list[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeRoutes(uint32_t object_count, const sai_route_entry_t *route_entry,
+                              sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = removeRoute(&route_entry[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t setRoutesAttribute(uint32_t object_count, const sai_route_entry_t *route_entry,
+                                    const sai_attribute_t *attr_list, sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = setRouteAttribute(&route_entry[i], &attr_list[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNextHopGroup(sai_object_id_t *next_hop_group_id, sai_object_id_t switch_id,
+                                    uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        *next_hop_group_id = nhgIdBase + ++lastNhgId;
+        asicNhgs.insert(*next_hop_group_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeNextHopGroup(sai_object_id_t next_hop_group_id)
+    {
+        asicNhgs.erase(next_hop_group_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNextHopGroupMember(sai_object_id_t *next_hop_group_member_id, sai_object_id_t switch_id,
+                                          uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        *next_hop_group_member_id = nhgmIdBase + ++lastNhgmId;
+        asicNhgMembers.insert(*next_hop_group_member_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeNextHopGroupMember(sai_object_id_t next_hop_group_member_id)
+    {
+        asicNhgMembers.erase(next_hop_group_member_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    struct RouteOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+        sai_switch_api_t m_switch_api;
+        sai_route_api_t m_route_api;
+        sai_mpls_api_t m_mpls_api;
+        sai_next_hop_group_api_t m_next_hop_group_api;
+        sai_route_api_t *m_saved_route_api;
+        sai_mpls_api_t *m_saved_mpls_api;
+        sai_next_hop_group_api_t *m_saved_next_hop_group_api;
+
+        RouteOrchTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            // The CRM available counters are read from the fake ASIC tables
+            savedSwitchApi = sai_switch_api;
+            m_switch_api = *sai_switch_api;
+            m_switch_api.get_switch_attribute = getSwitchAttribute;
+            sai_switch_api = &m_switch_api;
+
+            // Routes and next hop groups are created through the fake SAI. The
+            // next hop group members have no bulk API and are created one by one.
+            m_saved_route_api = sai_route_api;
+            m_route_api = {};
+            m_route_api.create_route_entry = createRoute;
+            m_route_api.remove_route_entry = removeRoute;
+            m_route_api.set_route_entry_attribute = setRouteAttribute;
+            m_route_api.create_route_entries = createRoutes;
+            m_route_api.remove_route_entries = removeRoutes;
+            m_route_api.set_route_entries_attribute = setRoutesAttribute;
+            sai_route_api = &m_route_api;
+
+            m_saved_mpls_api = sai_mpls_api;
+            m_mpls_api = {};
+            sai_mpls_api = &m_mpls_api;
+
+            m_saved_next_hop_group_api = sai_next_hop_group_api;
+            m_next_hop_group_api = {};
+            m_next_hop_group_api.create_next_hop_group = createNextHopGroup;
+            m_next_hop_group_api.remove_next_hop_group = removeNextHopGroup;
+            m_next_hop_group_api.create_next_hop_group_member = createNextHopGroupMember;
+            m_next_hop_group_api.remove_next_hop_group_member = removeNextHopGroupMember;
+            sai_next_hop_group_api = &m_next_hop_group_api;
+
+            asicRoutes.clear();
+            asicIpv4Routes = 0;
+            asicNhgs.clear();
+            asicNhgMembers.clear();
+            lastNhgId = 0;
+            lastNhgmId = 0;
+            ipv4RouteCapacity = 1000;
+            nhgCapacity = 1000;
+
+            TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+            TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+            TableConnector app_switch_table(m_app_db.get(),  APP_SWITCH_TABLE_NAME);
+
+            vector<TableConnector> switch_tables = {
+                conf_asic_sensors,
+                app_switch_table
+            };
+
+            ASSERT_EQ(gSwitchOrch, nullptr);
+            gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables);
+            Portal::PortsOrchInternal::setInitDone(gPortsOrch);
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            const int fgnhgorch_pri = 15;
+
+            vector<table_name_with_pri_t> fgnhg_tables = {
+                { CFG_FG_NHG,                 fgnhgorch_pri },
+                { CFG_FG_NHG_PREFIX,          fgnhgorch_pri },
+                { CFG_FG_NHG_MEMBER,          fgnhgorch_pri }
+            };
+
+            ASSERT_EQ(gFgNhgOrch, nullptr);
+            gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+            ASSERT_EQ(gNhgOrch, nullptr);
+            gNhgOrch = new NhgOrch(m_app_db.get(), { APP_NEXT_HOP_GROUP_TABLE_NAME, APP_CLASS_BASED_NEXT_HOP_GROUP_TABLE_NAME });
+
+            const int routeorch_pri = 5;
+
+            vector<table_name_with_pri_t> route_tables = {
+                { APP_ROUTE_TABLE_NAME,        routeorch_pri },
+                { APP_LABEL_ROUTE_TABLE_NAME,  routeorch_pri }
+            };
+
+            ASSERT_EQ(gRouteOrch, nullptr);
+            gRouteOrch = new RouteOrch(m_app_db.get(), route_tables, gNeighOrch, gIntfsOrch, gVrfOrch, gFgNhgOrch);
+
+            Portal::NeighOrchInternal::addSyncdNextHop(gNeighOrch, NextHopKey("10.0.0.1@Ethernet0"), nh1Id);
+            Portal::NeighOrchInternal::addSyncdNextHop(gNeighOrch, NextHopKey("10.0.0.2@Ethernet4"), nh2Id);
+            Portal::NeighOrchInternal::addSyncdNextHop(gNeighOrch, NextHopKey("10.0.0.3@Ethernet8"), nh3Id);
+        }
+
+        virtual void TearDown() override
+        {
+            delete gRouteOrch;
+            gRouteOrch = nullptr;
+            delete gNhgOrch;
+            gNhgOrch = nullptr;
+            delete gFgNhgOrch;
+            gFgNhgOrch = nullptr;
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+            delete gSwitchOrch;
+            gSwitchOrch = nullptr;
+
+            sai_switch_api = savedSwitchApi;
+            sai_route_api = m_saved_route_api;
+            sai_mpls_api = m_saved_mpls_api;
+            sai_next_hop_group_api = m_saved_next_hop_group_api;
+
+            ::testing_db::reset();
+        }
+
+        Consumer *routeConsumer()
+        {
+            return dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        }
+
+        // New route updates are handled right away, as Consumer::execute() does
+        void notifyRoutes(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = routeConsumer();
+            consumer->addToSync(entries);
+            consumer->drain();
+        }
+
+        // Pending route updates are retried from the main loop
+        void retryRoutes()
+        {
+            static_cast<Orch *>(gRouteOrch)->doTask();
+        }
+
+        bool isParked()
+        {
+            return Portal::OrchInternal::isConsumerParked(gRouteOrch, routeConsumer());
+        }
+
+        // The periodic CRM poll
+        void pollCrm()
+        {
+            Portal::CrmOrchInternal::getResAvailableCounters(gCrmOrch);
+        }
+
+        static void SetUpTestCase()
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_api_query(SAI_API_MPLS, (void **)&sai_mpls_api);
+            sai_api_query(SAI_API_NEXT_HOP_GROUP, (void **)&sai_next_hop_group_api);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+
+        static void TearDownTestCase()
+        {
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+
+            sai_mpls_api = nullptr;
+            sai_next_hop_group_api = nullptr;
+        }
+    };
+
+    TEST_F(RouteOrchTest, RoutesWaitForFreeRouteEntries)
+    {
+        // Only two more IPv4 routes fit in the ASIC
+        ipv4RouteCapacity = asicIpv4Routes + 2;
+        pollCrm();
+
+        notifyRoutes({
+            { "10.1.0.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } } },
+            { "10.2.0.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } } },
+            { "10.3.0.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } } }
+        });
+
+        ASSERT_EQ(asicRoutes.count("10.1.0.0/24"), 1u);
+        ASSERT_EQ(asicRoutes.count("10.2.0.0/24"), 1u);
+        ASSERT_EQ(asicRoutes.count("10.3.0.0/24"), 0u);
+
+        // The route which doesn't fit waits, without being retried on every loop
+        ASSERT_EQ(routeConsumer()->m_toSync.size(), 1u);
+        ASSERT_TRUE(isParked());
+
+        retryRoutes();
+        ASSERT_EQ(routeConsumer()->m_toSync.size(), 1u);
+        ASSERT_TRUE(isParked());
+        ASSERT_EQ(asicRoutes.count("10.3.0.0/24"), 0u);
+
+        // New updates are still handled, and free a route entry
+        notifyRoutes({
+            { "10.1.0.0/24", DEL_COMMAND, { } }
+        });
+
+        ASSERT_EQ(asicRoutes.count("10.1.0.0/24"), 0u);
+        ASSERT_EQ(routeConsumer()->m_toSync.size(), 1u);
+
+        // The waiting route is added on the next retry
+        retryRoutes();
+        ASSERT_TRUE(routeConsumer()->m_toSync.empty());
+        ASSERT_FALSE(isParked());
+        ASSERT_EQ(asicRoutes["10.3.0.0/24"], nh1Id);
+    }
+
+    TEST_F(RouteOrchTest, NextHopGroupsFreedByPendingRemovalsAreReused)
+    {
+        // A single next hop group fits in the ASIC
+        nhgCapacity = 1;
+        pollCrm();
+
+        notifyRoutes({
+            { "10.1.0.0/24", SET_COMMAND, { { "nexthop", "10.0.0.1,10.0.0.2" }, { "ifname", "Ethernet0,Ethernet4" } } }
+        });
+
+        ASSERT_TRUE(routeConsumer()->m_toSync.empty());
+        ASSERT_EQ(asicNhgs.size(), 1u);
+        auto nhg1Id = asicRoutes["10.1.0.0/24"];
+        ASSERT_EQ(asicNhgs.count(nhg1Id), 1u);
+
+        /*
+         * While the groups are exhausted, the first new route is added with a
+         * temporary next hop and the bulker is flushed, so that the group of
+         * the removed route is freed for the routes which follow.
+         */
+        notifyRoutes({
+            { "10.1.0.0/24", DEL_COMMAND, { } },
+            { "10.2.0.0/24", SET_COMMAND, { { "nexthop", "10.0.0.2,10.0.0.3" }, { "ifname", "Ethernet4,Ethernet8" } } },
+            { "10.3.0.0/24", SET_COMMAND, { { "nexthop", "10.0.0.2,10.0.0.3" }, { "ifname", "Ethernet4,Ethernet8" } } }
+        });
+
+        ASSERT_EQ(asicRoutes.count("10.1.0.0/24"), 0u);
+        ASSERT_EQ(asicNhgs.count(nhg1Id), 0u);
+        ASSERT_EQ(asicNhgs.size(), 1u);
+
+        auto nhg2Id = *asicNhgs.begin();
+        ASSERT_EQ(asicRoutes["10.3.0.0/24"], nhg2Id);
+
+        auto tempNextHopId = asicRoutes["10.2.0.0/24"];
+        ASSERT_TRUE(tempNextHopId == nh2Id || tempNextHopId == nh3Id);
+        ASSERT_EQ(routeConsumer()->m_toSync.size(), 1u);
+        ASSERT_FALSE(isParked());
+
+        // The route on the temporary next hop moves to the group on retry
+        retryRoutes();
+        ASSERT_TRUE(routeConsumer()->m_toSync.empty());
+        ASSERT_EQ(asicRoutes["10.2.0.0/24"], nhg2Id);
+        ASSERT_EQ(asicNhgs.size(), 1u);
+    }
+}
@@ -0,0 +1,129 @@
+#include "ut_helper.h"
+#include "mock_table.h"
+
+namespace tieredflexcounter_test
+{
+    using namespace std;
+
+    const string groupName = "TEST_QUEUE_STAT_COUNTER";
+    const uint hotInterval = 1000;
+
+    // A queue forwarding at line rate, one with a trickle of traffic and an idle one
+    const sai_object_id_t busyQueue = 0x15000000000001;
+    const sai_object_id_t slowQueue = 0x15000000000002;
+    const sai_object_id_t idleQueue = 0x15000000000003;
+
+    struct TieredFlexCounterManagerTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_state_db;
+        unique_ptr<TieredFlexCounterManager> m_manager;
+        vector<sai_object_id_t> m_queues = { busyQueue, slowQueue, idleQueue };
+        vector<uint64_t> m_sums = { 0, 0, 0 };
+        chrono::steady_clock::time_point m_now;
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_manager = make_unique<TieredFlexCounterManager>(groupName, StatsMode::READ, hotInterval, true);
+            m_manager->setCounterIdList(m_queues, CounterType::QUEUE,
+                    { "SAI_QUEUE_STAT_PACKETS", "SAI_QUEUE_STAT_BYTES" });
+
+            // The first sample only records the counters
+            m_now = chrono::steady_clock::now();
+            Portal::TieredFlexCounterManagerInternal::applyCounterSums(*m_manager, m_queues, m_sums, m_now);
+        }
+
+        virtual void TearDown() override
+        {
+            m_manager.reset();
+            ::testing_db::reset();
+        }
+
+        // Sample the queues one second after the previous sample
+        void sample(const vector<uint64_t> &deltas)
+        {
+            for (size_t i = 0; i < m_sums.size(); i++)
+            {
+                m_sums[i] += deltas[i];
+            }
+
+            m_now += chrono::seconds(1);
+            Portal::TieredFlexCounterManagerInternal::applyCounterSums(*m_manager, m_queues, m_sums, m_now);
+        }
+
+        CounterTier getTier(sai_object_id_t queue)
+        {
+            return Portal::TieredFlexCounterManagerInternal::getTier(*m_manager, queue);
+        }
+
+        string getTierStat(const string &field)
+        {
+            Table tierTable(m_state_db.get(), FLEX_COUNTER_TIER_TABLE);
+            string value;
+            tierTable.hget(groupName, field, value);
+            return value;
+        }
+    };
+
+    TEST_F(TieredFlexCounterManagerTest, PollsEachTierAtItsInterval)
+    {
+        ASSERT_EQ(getTierStat("hot_interval"), "1000");
+        ASSERT_EQ(getTierStat("warm_interval"), "6000");
+        ASSERT_EQ(getTierStat("cold_interval"), "30000");
+
+        // The WARM and COLD tiers follow the group interval
+        m_manager->updateGroupPollingInterval(2000);
+
+        ASSERT_EQ(getTierStat("hot_interval"), "2000");
+        ASSERT_EQ(getTierStat("warm_interval"), "12000");
+        ASSERT_EQ(getTierStat("cold_interval"), "60000");
+    }
+
+    TEST_F(TieredFlexCounterManagerTest, PlacesObjectsByActivity)
+    {
+        // New objects are polled in the HOT tier
+        ASSERT_EQ(m_manager->getTierObjectCount(CounterTier::HOT), 3u);
+
+        sample({ 200000, 10, 0 });
+        ASSERT_EQ(getTier(busyQueue), CounterTier::HOT);
+        ASSERT_EQ(getTier(slowQueue), CounterTier::WARM);
+        ASSERT_EQ(getTier(idleQueue), CounterTier::WARM);
+
+        // An idle object only goes COLD after several samples without change
+        sample({ 200000, 10, 0 });
+        ASSERT_EQ(getTier(idleQueue), CounterTier::WARM);
+
+        sample({ 200000, 10, 0 });
+        ASSERT_EQ(getTier(busyQueue), CounterTier::HOT);
+        ASSERT_EQ(getTier(slowQueue), CounterTier::WARM);
+        ASSERT_EQ(getTier(idleQueue), CounterTier::COLD);
+
+        ASSERT_EQ(m_manager->getTierObjectCount(CounterTier::HOT), 1u);
+        ASSERT_EQ(m_manager->getTierObjectCount(CounterTier::WARM), 1u);
+        ASSERT_EQ(m_manager->getTierObjectCount(CounterTier::COLD), 1u);
+        ASSERT_DOUBLE_EQ(m_manager->getPollsPerSecond(), 1.0 + 1.0 / 6 + 1.0 / 30);
+
+        // A busy object is promoted straight back to HOT, a quiet one drops to WARM
+        sample({ 0, 0, 200000 });
+        ASSERT_EQ(getTier(busyQueue), CounterTier::WARM);
+        ASSERT_EQ(getTier(slowQueue), CounterTier::WARM);
+        ASSERT_EQ(getTier(idleQueue), CounterTier::HOT);
+    }
+
+    TEST_F(TieredFlexCounterManagerTest, ForgetsClearedObjects)
+    {
+        sample({ 200000, 10, 0 });
+        sample({ 200000, 10, 0 });
+        sample({ 200000, 10, 0 });
+        ASSERT_EQ(getTier(idleQueue), CounterTier::COLD);
+
+        m_manager->clearCounterIdList(idleQueue);
+        ASSERT_EQ(m_manager->getTierObjectCount(CounterTier::COLD), 0u);
+
+        // A recreated object starts over in the HOT tier
+        m_manager->setCounterIdList(idleQueue, CounterType::QUEUE, { "SAI_QUEUE_STAT_PACKETS" });
+        ASSERT_EQ(getTier(idleQueue), CounterTier::HOT);
+    }
+}
@@ -0,0 +1,294 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "sai_serialize.h"
+
+namespace vnetorch_test
+{
+    using namespace std;
+
+    const sai_object_id_t rifId = 0x6000000000001;
+    const sai_object_id_t vrIdBase = 0x3000000000000;
+
+    // Routes created through the fake SAI, by virtual router and prefix
+    set<pair<sai_object_id_t, string>> asicRoutes;
+    vector<uint32_t> bulkRouteCreates;
+    vector<uint32_t> bulkRouteRemoves;
+    pair<sai_object_id_t, string> failingRoute;
+    sai_object_id_t lastVrId;
+
+    sai_status_t createVirtualRouter(sai_object_id_t *vr_id, sai_object_id_t switch_id, uint32_t attr_count,
+                                     const sai_attribute_t *attr_list)
+    {
+        *vr_id = vrIdBase + ++lastVrId;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeVirtualRouter(sai_object_id_t vr_id)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createRoute(const sai_route_entry_t *route_entry, uint32_t attr_count,
+                             const sai_attribute_t *attr_list)
+    {
+        auto route = make_pair(route_entry->vr_id, sai_serialize_ip_prefix(route_entry->destination));
+        if (route == failingRoute)
+        {
+            return SAI_STATUS_FAILURE;
+        }
+
+        asicRoutes.insert(route);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeRoute(const sai_route_entry_t *route_entry)
+    {
+        asicRoutes.erase(make_pair(route_entry->vr_id, sai_serialize_ip_prefix(route_entry->destination)));
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createRoutes(uint32_t object_count, const sai_route_entry_t *route_entry,
+                              const uint32_t *attr_count, const sai_attribute_t **attr_list,
+                              sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkRouteCreates.push_back(object_count);
+
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = createRoute(&route_entry[i], attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t removeRoutes(uint32_t object_count, const sai_route_entry_t *route_entry,
+                              sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkRouteRemoves.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = removeRoute(&route_entry[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    struct VNetRouteOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+
+        sai_route_api_t m_route_api;
+        sai_virtual_router_api_t m_virtual_router_api;
+        sai_route_api_t *m_saved_route_api;
+        sai_virtual_router_api_t *m_saved_virtual_router_api;
+
+        VNetOrch *m_vnet_orch = nullptr;
+        VNetRouteOrch *m_vnet_route_orch = nullptr;
+
+        sai_object_id_t m_vnet1VrId;
+        sai_object_id_t m_vnet2VrId;
+
+        VNetRouteOrchTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+        }
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+
+            // Virtual routers and routes are created through the fake SAI
+            m_saved_virtual_router_api = sai_virtual_router_api;
+            m_virtual_router_api = {};
+            m_virtual_router_api.create_virtual_router = createVirtualRouter;
+            m_virtual_router_api.remove_virtual_router = removeVirtualRouter;
+            sai_virtual_router_api = &m_virtual_router_api;
+
+            m_saved_route_api = sai_route_api;
+            m_route_api = {};
+            m_route_api.create_route_entry = createRoute;
+            m_route_api.remove_route_entry = removeRoute;
+            m_route_api.create_route_entries = createRoutes;
+            m_route_api.remove_route_entries = removeRoutes;
+            sai_route_api = &m_route_api;
+
+            asicRoutes.clear();
+            bulkRouteCreates.clear();
+            bulkRouteRemoves.clear();
+            failingRoute = {};
+            lastVrId = 0;
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables);
+
+            // A routed port for the subnet routes
+            Port port("Ethernet0", Port::PHY);
+            port.m_rif_id = rifId;
+            Portal::PortsOrchInternal::addPort(gPortsOrch, port);
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            m_vnet_orch = new VNetOrch(m_app_db.get(), APP_VNET_TABLE_NAME, VNET_EXEC::VNET_EXEC_VRF);
+
+            // Routes of Vnet1 are also installed in its peer Vnet2
+            Portal::VNetOrchInternal::addVnet(m_vnet_orch, "Vnet1", { "Vnet2" });
+            Portal::VNetOrchInternal::addVnet(m_vnet_orch, "Vnet2", { });
+            m_vnet1VrId = m_vnet_orch->getTypePtr<VNetVrfObject>("Vnet1")->getVRidIngress();
+            m_vnet2VrId = m_vnet_orch->getTypePtr<VNetVrfObject>("Vnet2")->getVRidIngress();
+
+            vector<string> vnet_route_tables = {
+                APP_VNET_RT_TABLE_NAME,
+                APP_VNET_RT_TUNNEL_TABLE_NAME
+            };
+
+            m_vnet_route_orch = new VNetRouteOrch(m_app_db.get(), vnet_route_tables, m_vnet_orch);
+        }
+
+        virtual void TearDown() override
+        {
+            delete m_vnet_route_orch;
+            m_vnet_route_orch = nullptr;
+            delete m_vnet_orch;
+            m_vnet_orch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+
+            sai_route_api = m_saved_route_api;
+            sai_virtual_router_api = m_saved_virtual_router_api;
+
+            ::testing_db::reset();
+        }
+
+        Consumer *routeConsumer()
+        {
+            return dynamic_cast<Consumer *>(m_vnet_route_orch->getExecutor(APP_VNET_RT_TABLE_NAME));
+        }
+
+        void notifyRoutes(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = routeConsumer();
+            consumer->addToSync(entries);
+            consumer->drain();
+        }
+
+        bool hasVnetRoute(const string &vnet, const string &prefix)
+        {
+            IpPrefix ipPrefix(prefix);
+            return m_vnet_orch->getTypePtr<VNetVrfObject>(vnet)->hasRoute(ipPrefix);
+        }
+
+        uint32_t usedIpv4Routes()
+        {
+            const auto &resources = Portal::CrmOrchInternal::getResourceMap(gCrmOrch);
+            return resources.at(CrmResourceType::CRM_IPV4_ROUTE).countersMap.at("STATS").usedCounter;
+        }
+
+        static void SetUpTestCase()
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+
+        static void TearDownTestCase()
+        {
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+        }
+    };
+
+    TEST_F(VNetRouteOrchTest, RoutesOfOnePassAreBulked)
+    {
+        notifyRoutes({
+            { "Vnet1:10.1.0.0/24", SET_COMMAND, { { "ifname", "Ethernet0" } } },
+            { "Vnet1:10.2.0.0/24", SET_COMMAND, { { "ifname", "Ethernet0" } } },
+            { "Vnet2:10.3.0.0/24", SET_COMMAND, { { "ifname", "Ethernet0" } } }
+        });
+
+        // One bulk call for the routes of all the requests, in each of their VRFs
+        ASSERT_TRUE(routeConsumer()->m_toSync.empty());
+        ASSERT_EQ(bulkRouteCreates, vector<uint32_t>({ 5 }));
+        ASSERT_EQ(asicRoutes, set<pair<sai_object_id_t, string>>({
+            { m_vnet1VrId, "10.1.0.0/24" }, { m_vnet2VrId, "10.1.0.0/24" },
+            { m_vnet1VrId, "10.2.0.0/24" }, { m_vnet2VrId, "10.2.0.0/24" },
+            { m_vnet2VrId, "10.3.0.0/24" }
+        }));
+        ASSERT_EQ(usedIpv4Routes(), 5u);
+
+        // The routes are recorded once the bulker is flushed
+        ASSERT_TRUE(hasVnetRoute("Vnet1", "10.1.0.0/24"));
+        ASSERT_TRUE(hasVnetRoute("Vnet1", "10.2.0.0/24"));
+        ASSERT_TRUE(hasVnetRoute("Vnet2", "10.3.0.0/24"));
+
+        notifyRoutes({
+            { "Vnet1:10.1.0.0/24", DEL_COMMAND, { } },
+            { "Vnet1:10.2.0.0/24", DEL_COMMAND, { } }
+        });
+
+        ASSERT_TRUE(routeConsumer()->m_toSync.empty());
+        ASSERT_EQ(bulkRouteRemoves, vector<uint32_t>({ 4 }));
+        ASSERT_EQ(asicRoutes, set<pair<sai_object_id_t, string>>({ { m_vnet2VrId, "10.3.0.0/24" } }));
+        ASSERT_EQ(usedIpv4Routes(), 1u);
+        ASSERT_FALSE(hasVnetRoute("Vnet1", "10.1.0.0/24"));
+        ASSERT_FALSE(hasVnetRoute("Vnet1", "10.2.0.0/24"));
+    }
+
+    TEST_F(VNetRouteOrchTest, FailedRouteEntriesAreNotCounted)
+    {
+        // The route of Vnet1 can't be installed in its peer's VRF
+        failingRoute = { m_vnet2VrId, "10.1.0.0/24" };
+
+        notifyRoutes({
+            { "Vnet1:10.1.0.0/24", SET_COMMAND, { { "ifname", "Ethernet0" } } },
+            { "Vnet1:10.2.0.0/24", SET_COMMAND, { { "ifname", "Ethernet0" } } }
+        });
+
+        ASSERT_EQ(bulkRouteCreates, vector<uint32_t>({ 4 }));
+        ASSERT_EQ(asicRoutes, set<pair<sai_object_id_t, string>>({
+            { m_vnet1VrId, "10.1.0.0/24" },
+            { m_vnet1VrId, "10.2.0.0/24" }, { m_vnet2VrId, "10.2.0.0/24" }
+        }));
+
+        // Only the entries which were created are accounted in CRM
+        ASSERT_EQ(usedIpv4Routes(), 3u);
+
+        // Failed routes other than tunnel routes are not retried, as before bulking
+        ASSERT_TRUE(routeConsumer()->m_toSync.empty());
+        ASSERT_TRUE(hasVnetRoute("Vnet1", "10.1.0.0/24"));
+        ASSERT_TRUE(hasVnetRoute("Vnet1", "10.2.0.0/24"));
+    }
+}
@@ -905,6 +905,8 @@ class VxlanTunnel(object):
 
     def check_del_tunnel_nexthop(self, dvs, vrf_name, endpoint, tunnel, mac="", vni=0):
         asic_db = swsscommon.DBConnector(swsscommon.ASIC_DB, dvs.redis_sock, 0)
+        # Unused tunnel next hops are removed after a hold down
+        dvs.get_asic_db().wait_for_n_keys(self.ASIC_NEXT_HOP, len(self.nhops) - 1)
 
         del_nh_ids = get_deleted_entries(asic_db, self.ASIC_NEXT_HOP, self.nhops, 1)
         check_deleted_object(asic_db, self.ASIC_NEXT_HOP, del_nh_ids[0])
@@ -1307,8 +1309,8 @@ class TestL3Vxlan(object):
         print ("\tTest VRF IPv4 Route with ECMP Tunnel Nexthop [7.7.7.7 , 8.8.8.8] Delete")
         vxlan_obj.fetch_exist_entries(dvs)
         delete_vrf_routes(dvs, "80.80.1.0/24", 'Vrf-RED')
-        check_deleted_object(self.adb, vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[0])
-        check_deleted_object(self.adb, vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[1])
+        dvs.get_asic_db().wait_for_deleted_entry(vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[0])
+        dvs.get_asic_db().wait_for_deleted_entry(vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[1])
         
         vxlan_obj.check_vrf_routes_ecmp_nexthop_grp_del(dvs, 2)
         vxlan_obj.check_del_vrf_routes(dvs, "80.80.1.0/24", 'Vrf-RED')
@@ -1513,8 +1515,8 @@ class TestL3Vxlan(object):
         print ("\tTest VRF IPv6 Route with ECMP Tunnel Nexthop [7.7.7.7 , 8.8.8.8] Delete")
         vxlan_obj.fetch_exist_entries(dvs)
         delete_vrf_routes(dvs, "2002::8/64", 'Vrf-RED')
-        check_deleted_object(self.adb, vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[0])
-        check_deleted_object(self.adb, vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[1])
+        dvs.get_asic_db().wait_for_deleted_entry(vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[0])
+        dvs.get_asic_db().wait_for_deleted_entry(vxlan_obj.ASIC_NEXT_HOP, ecmp_nhid_list[1])
         
         vxlan_obj.check_vrf_routes_ecmp_nexthop_grp_del(dvs, 2)
         vxlan_obj.check_del_vrf_routes(dvs, "2002::8/64", 'Vrf-RED')
@@ -1591,6 +1593,71 @@ class TestL3Vxlan(object):
         remove_vlan(dvs, "100")
 
 
+#    Test 5 - Remove the last DIP tunnel user and the SIP tunnel while the overlay nexthop is still cached
+    def test_dip_tunnel_delete_with_cached_nexthop(self, dvs, testlog):
+        vxlan_obj = self.get_vxlan_obj()
+
+        self.setup_db(dvs)
+        tunnel_name = 'tunnel_2'
+        map_name = 'map_1000_100'
+        vlanlist = ['100']
+        vnilist = ['1000']
+        vxlan_obj.fetch_exist_entries(dvs)
+
+        print ("\n\nTesting DIP and SIP Tunnel Deletion with a cached Overlay Nexthop")
+        create_vlan1(dvs,"Vlan100")
+        create_vxlan_tunnel(dvs, tunnel_name, '6.6.6.6')
+        create_evpn_nvo(dvs, 'nvo1', tunnel_name)
+        create_vxlan_tunnel_map(dvs, tunnel_name, map_name, '1000', 'Vlan100')
+
+        vxlan_obj.create_vrf(dvs, "Vrf-RED")
+        create_vxlan_vrf_tunnel_map(dvs, 'Vrf-RED', '1000')
+        vxlan_obj.check_vxlan_sip_tunnel(dvs, tunnel_name, '6.6.6.6', vlanlist, vnilist)
+
+        create_evpn_remote_vni(dvs, 'Vlan100', '7.7.7.7', '1000')
+        vxlan_obj.check_vxlan_dip_tunnel(dvs, tunnel_name, '6.6.6.6', '7.7.7.7')
+
+        create_vlan_interface(dvs, "Vlan100", "Ethernet24", "Vrf-RED", "100.100.3.1/24")
+        vxlan_obj.check_router_interface(dvs, 'Vrf-RED', vxlan_obj.vlan_id_map['100'], 2)
+
+        print ("\tTest VRF IPv4 Route with Tunnel Nexthop 7.7.7.7 Add and Delete")
+        vxlan_obj.fetch_exist_entries(dvs)
+        create_vrf_routes(dvs, "80.80.1.0/24", 'Vrf-RED', '7.7.7.7', "Vlan100", "00:11:11:11:11:11", '1000')
+        vxlan_obj.check_vrf_routes(dvs, "80.80.1.0/24", 'Vrf-RED', '7.7.7.7', tunnel_name, "00:11:11:11:11:11", '1000')
+        nh_id = vxlan_obj.nh_ids['7.7.7.7']
+
+        delete_vrf_routes(dvs, "80.80.1.0/24", 'Vrf-RED')
+        vxlan_obj.check_del_vrf_routes(dvs, "80.80.1.0/24", 'Vrf-RED')
+
+        # The nexthop is held down in the tunnel cache, the tunnels are removed once it is swept
+        print ("\tTesting Last DIP tunnel user removal with the nexthop cached")
+        remove_vxlan_vrf_tunnel_map(dvs, 'Vrf-RED')
+        remove_evpn_remote_vni(dvs, 'Vlan100', '7.7.7.7')
+        vxlan_obj.check_vlan_extension_delete(dvs, '100', '7.7.7.7')
+
+        delete_vlan_interface(dvs, "Vlan100", "100.100.3.1/24")
+        remove_vxlan_tunnel_map(dvs, tunnel_name, map_name, '1000', 'Vlan100')
+
+        print ("\tTesting SIP Tunnel Deletion with the nexthop cached")
+        remove_vxlan_tunnel(dvs, tunnel_name)
+        remove_evpn_nvo(dvs, 'nvo1')
+
+        asic_db = dvs.get_asic_db()
+        asic_db.wait_for_deleted_entry(vxlan_obj.ASIC_NEXT_HOP, nh_id)
+        vxlan_obj.nh_ids.pop('7.7.7.7')
+        vxlan_obj.nhops.discard(nh_id)
+
+        asic_db.wait_for_deleted_entry(vxlan_obj.ASIC_TUNNEL_TABLE, vxlan_obj.diptunnel_map['7.7.7.7'])
+        vxlan_obj.check_vxlan_dip_tunnel_delete(dvs, '7.7.7.7')
+
+        asic_db.wait_for_deleted_entry(vxlan_obj.ASIC_TUNNEL_TABLE, vxlan_obj.tunnel[tunnel_name])
+        vxlan_obj.check_vxlan_sip_tunnel_delete(dvs, tunnel_name)
+
+        vxlan_obj.remove_vrf(dvs, "Vrf-RED")
+        remove_vlan_member(dvs, "100", "Ethernet24")
+        remove_vlan(dvs, "100")
+
+
 # Add Dummy always-pass test at end as workaroud
 # for issue when Flaky fail on final test it invokes module tear-down before retrying
 def test_nonflaky_dummy():
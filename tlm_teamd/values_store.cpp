@@ -1,3 +1,4 @@
+#include <time.h>
 #include <jansson.h>
 
 #include <logger.h>
@@ -5,6 +6,19 @@
 
 #include "values_store.h"
 
+///
+/// Constructor. Compiles the LAG and LAG member paths once, so they are not
+/// split again for every value of every poll.
+/// @param db a pointer to the STATE_DB connector
+///
+ValuesStore::ValuesStore(const swss::DBConnector * db)
+    : m_db(db)
+    , m_pipeline(db)
+    , m_compiled_lag_paths(compile_paths(m_lag_paths))
+    , m_compiled_member_paths(compile_paths(m_member_paths))
+{
+}
+
 ///
 /// Extract port names from teamd status json dump.
 /// @return vector of LAG member port names from the dump
@@ -48,6 +62,23 @@ std::pair<std::vector<std::string>, std::string> ValuesStore::convert_path(const
     return { result,  path.substr(last) };
 }
 
+///
+/// Convert the list of canonical paths to the internal format
+/// @param paths list of pairs. Each pair has a canonical path and a type of the value
+/// @return list of compiled paths
+///
+ValuesStore::CompiledPaths ValuesStore::compile_paths(const std::vector<std::pair<std::string, ValuesStore::json_type>> & paths)
+{
+    CompiledPaths result;
+    for (const auto & p: paths)
+    {
+        auto path_pair = convert_path(p.first);
+        result.push_back({ path_pair.first, path_pair.second, p.first, p.second });
+    }
+
+    return result;
+}
+
 ///
 /// Traverse parsed json structure to find correct object to extract the value
 /// @param root parsed json structure
@@ -59,9 +90,8 @@ json_t * ValuesStore::traverse(json_t * root, const std::vector<std::string> & p
     json_t * cur_root = root;
     for (const auto & key: path_array)
     {
-        json_t * cur = nullptr;
-        int err = json_unpack(cur_root, "{s:o}", key.c_str(), &cur);
-        if (err != 0)
+        json_t * cur = json_is_object(cur_root) ? json_object_get(cur_root, key.c_str()) : nullptr;
+        if (cur == nullptr)
         {
             throw std::runtime_error("Can't traverse through the path '" + path + "'. not found key = " + key);
         }
@@ -77,14 +107,12 @@ json_t * ValuesStore::traverse(json_t * root, const std::vector<std::string> & p
 ///
 std::string ValuesStore::unpack_string(json_t * root, const std::string & key, const std::string & path)
 {
-    const auto & c_key = key.c_str();
-    const char * str = nullptr;
-    int err = json_unpack(root, "{s:s}", c_key, &str);
-    if (err != 0)
+    json_t * value = json_object_get(root, key.c_str());
+    if (!json_is_string(value))
     {
         throw std::runtime_error("Can't unpack a string. key='" + path + "' json='" + json_dumps(root, 0) + "'");
     }
-    return std::string(str);
+    return std::string(json_string_value(value));
 }
 
 ///
@@ -93,14 +121,12 @@ std::string ValuesStore::unpack_string(json_t * root, const std::string & key, c
 ///
 std::string ValuesStore::unpack_boolean(json_t * root, const std::string & key, const std::string & path)
 {
-    const auto & c_key = key.c_str();
-    int value;
-    int err = json_unpack(root, "{s:b}", c_key, &value);
-    if (err != 0)
+    json_t * value = json_object_get(root, key.c_str());
+    if (!json_is_boolean(value))
     {
         throw std::runtime_error("Can't unpack a boolean. key='" + path + "' json='" + json_dumps(root, 0) + "'");
     }
-    return std::string(value ? "true" : "false");
+    return std::string(json_is_true(value) ? "true" : "false");
 }
 
 ///
@@ -109,39 +135,32 @@ std::string ValuesStore::unpack_boolean(json_t * root, const std::string & key,
 ///
 std::string ValuesStore::unpack_integer(json_t * root, const std::string & key, const std::string & path)
 {
-    const auto & c_key = key.c_str();
-    int value;
-    int err = json_unpack(root, "{s:i}", c_key, &value);
-    if (err != 0)
+    json_t * value = json_object_get(root, key.c_str());
+    if (!json_is_integer(value))
     {
         throw std::runtime_error("Can't unpack an integer. key='" + path + "' json='" + json_dumps(root, 0) + "'");
     }
-    return std::to_string(value);
+    return std::to_string(json_integer_value(value));
 }
 
 ///
-/// Extract a value from the parsed json. Path to the value is defined by path, and type of the value
-/// is defined by type.
+/// Extract a value from the parsed json. Path to the value and type of the value
+/// are defined by the compiled path.
 /// @param root a pointer to parsed json structure
-/// @param path a canonical path to the value
-/// @param type a type of the value
+/// @param path a compiled path to the value
 ///
-std::string ValuesStore::get_value(json_t * root, const std::string & path, ValuesStore::json_type type)
+std::string ValuesStore::get_value(json_t * root, const CompiledPath & path)
 {
-    auto path_pair = convert_path(path);
-
-    json_t * found_object = traverse(root, path_pair.first, path);
+    json_t * found_object = traverse(root, path.parents, path.path);
 
-    const auto & key = path_pair.second;
-
-    switch (type)
+    switch (path.type)
     {
-        case ValuesStore::json_type::string:  return unpack_string(found_object, key, path);
-        case ValuesStore::json_type::boolean: return unpack_boolean(found_object, key, path);
-        case ValuesStore::json_type::integer: return unpack_integer(found_object, key, path);
+        case ValuesStore::json_type::string:  return unpack_string(found_object, path.key, path.path);
+        case ValuesStore::json_type::boolean: return unpack_boolean(found_object, path.key, path.path);
+        case ValuesStore::json_type::integer: return unpack_integer(found_object, path.key, path.path);
     }
 
-    throw std::runtime_error("Reach the end of the ValuesStore::get_value. Path=" + path);
+    throw std::runtime_error("Reach the end of the ValuesStore::get_value. Path=" + path.path);
 }
 
 ///
@@ -155,12 +174,9 @@ void ValuesStore::extract_values(const std::string & lag_name, json_t * root, Ha
 
     const std::string key = "LAG_TABLE|" + lag_name;
     Records lag_values;
-    for (const auto & p: m_lag_paths)
+    for (const auto & p: m_compiled_lag_paths)
     {
-        const auto & path = p.first;
-        const auto & type = p.second;
-        const auto & value = get_value(root, path, type);
-        lag_values.emplace(path, value);
+        lag_values.emplace(p.path, get_value(root, p));
     }
     storage.emplace(key, lag_values);
 
@@ -168,14 +184,11 @@ void ValuesStore::extract_values(const std::string & lag_name, json_t * root, Ha
     for (const auto & port: ports)
     {
         const std::string key = "LAG_MEMBER_TABLE|" + lag_name + "|" + port;
+        json_t * port_root = traverse(root, { "ports", port }, "ports." + port);
         Records member_values;
-        for (const auto & p: m_member_paths)
+        for (const auto & p: m_compiled_member_paths)
         {
-            const auto & path = p.first;
-            const auto & type = p.second;
-            const std::string full_path = "ports." + port + "." + path;
-            const auto & value = get_value(root, full_path, type);
-            member_values.emplace(path, value);
+            member_values.emplace(p.path, get_value(port_root, p));
         }
         storage.emplace(key, member_values);
     }
@@ -203,20 +216,40 @@ json_t * ValuesStore::load_json(const std::string & data)
 
 ///
 /// Convert json input from all teamds to the temporary storage
+/// Dumps which are identical to the previously processed dump of the same LAG
+/// are not parsed, the values for such LAGs are kept in the storage as is.
 /// @param dumps dumps from all teamds. It is a vector of pairs. Each pair
 ///              has a first element - name of the LAG and a second element
 ///              - json dump
-/// @return temporary storage
+/// @param hashes output. Hash of the dump for every LAG presented in dumps
+/// @return temporary storage with values of the LAGs which dumps were changed
 ///
-HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps)
+HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps, std::unordered_map<std::string, size_t> & hashes)
 {
     HashOfRecords storage;
     for (const auto & p: dumps)
     {
         const auto & lag_name = p.first;
         const auto & json_dump = p.second;
+        const size_t hash = std::hash<std::string>{}(json_dump);
+        hashes.emplace(lag_name, hash);
+
+        const auto & found = m_dump_hashes.find(lag_name);
+        if (found != m_dump_hashes.end() && found->second == hash)
+        {
+            continue;
+        }
+
         json_t * root = load_json(json_dump);
-        extract_values(lag_name, root, storage);
+        try
+        {
+            extract_values(lag_name, root, storage);
+        }
+        catch (...)
+        {
+            json_decref(root);
+            throw;
+        }
         json_decref(root);
     }
 
@@ -225,18 +258,30 @@ HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps)
 
 ///
 /// Extract a list of stale keys from the storage.
-/// The stale key is a key which a presented in the storage, but not presented
-/// in the temporary storage. That means that the key must be removed
+/// The stale key is a key of a LAG which is not presented in the dumps anymore,
+/// or a key of a LAG which dump was changed, which is not presented in
+/// the temporary storage. That means that the key must be removed
 /// @param storage a reference to the temporary storage
+/// @param hashes a reference to the hashes of the current dumps
 /// @return list of stale keys
 ///
-std::vector<std::string> ValuesStore::get_old_keys(const HashOfRecords & storage)
+std::vector<std::string> ValuesStore::get_old_keys(const HashOfRecords & storage, const std::unordered_map<std::string, size_t> & hashes)
 {
     std::vector<std::string> old_keys;
     for (const auto & p: m_storage)
     {
         const auto & db_key = p.first;
-        if (storage.find(db_key) == storage.end())
+        const auto & lag_name = get_lag_name(db_key);
+        const auto & found = hashes.find(lag_name);
+        if (found == hashes.end())
+        {
+            old_keys.push_back(db_key);
+            continue;
+        }
+
+        const auto & old_hash = m_dump_hashes.find(lag_name);
+        bool is_changed = old_hash == m_dump_hashes.end() || old_hash->second != found->second;
+        if (is_changed && storage.find(db_key) == storage.end())
         {
             old_keys.push_back(db_key);
         }
@@ -270,6 +315,34 @@ StringPair ValuesStore::split_key(const std::string & key)
     return std::make_pair(key.substr(0, sep_pos), key.substr(sep_pos + 1));
 }
 
+///
+/// Extract the LAG name from a database key
+/// For example "LAG_MEMBER_TABLE|PortChannel1|Ethernet0" would return "PortChannel1"
+/// @param key a database key.
+/// @return the LAG name
+///
+std::string ValuesStore::get_lag_name(const std::string & key)
+{
+    const auto & entry_key = split_key(key).second;
+    return entry_key.substr(0, entry_key.find('|'));
+}
+
+///
+/// Get a buffered table, which writes to the db through the pipeline
+/// @param table_name a name of the table
+/// @return a reference to the table
+///
+swss::Table & ValuesStore::get_table(const std::string & table_name)
+{
+    auto & table = m_tables[table_name];
+    if (!table)
+    {
+        table.reset(new swss::Table(&m_pipeline, table_name, true));
+    }
+
+    return *table;
+}
+
 ///
 /// Remove keys from the db
 /// @param keys a list of keys to remove
@@ -281,8 +354,7 @@ void ValuesStore::remove_keys_db(const std::vector<std::string> & keys)
         const auto & p = split_key(key);
         const auto & table_name = p.first;
         const auto & table_key = p.second;
-        swss::Table table(m_db, table_name);
-        table.del(table_key);
+        get_table(table_name).del(table_key);
     }
 }
 
@@ -351,25 +423,36 @@ void ValuesStore::update_db(const HashOfRecords & storage, const std::vector<std
             fvp.emplace_back(row_pair);
         }
         const auto & table_pair = split_key(key);
-        swss::Table table(m_db, table_pair.first);
-        table.set(table_pair.second, fvp);
+        get_table(table_pair.first).set(table_pair.second, fvp);
     }
 }
 
 
 ///
 /// Update the storage with json dumps for every registered LAG interface.
+/// Only the changed values are written to the db, in one pipelined batch.
 ///
 void ValuesStore::update(const std::vector<StringPair> & dumps)
 {
+    struct timespec cpu_start, cpu_end;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+
     try
     {
-        const auto & storage = from_json(dumps);
-        const auto & old_keys = get_old_keys(storage);
+        std::unordered_map<std::string, size_t> hashes;
+        const auto & storage = from_json(dumps, hashes);
+        const auto & old_keys = get_old_keys(storage, hashes);
         remove_keys_db(old_keys);
         remove_keys_storage(old_keys);
         const auto & keys_to_refresh = update_storage(storage);
         update_db(storage, keys_to_refresh);
+        m_pipeline.flush();
+        m_dump_hashes.swap(hashes);
+
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+        long cpu_usec = (cpu_end.tv_sec - cpu_start.tv_sec) * 1000000L + (cpu_end.tv_nsec - cpu_start.tv_nsec) / 1000L;
+        SWSS_LOG_INFO("Polled %zu LAGs: %zu keys changed, %zu keys removed, cpu %ld usec",
+                      dumps.size(), keys_to_refresh.size(), old_keys.size(), cpu_usec);
     }
     catch (const std::exception & e)
     {
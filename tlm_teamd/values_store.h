@@ -2,10 +2,15 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <jansson.h>
 
 #include <dbconnector.h>
+#include <redispipeline.h>
+#include <table.h>
 
 using StringPair = std::pair<std::string, std::string>;
 using Records = std::unordered_map<std::string, std::string>;
@@ -14,7 +19,7 @@ using HashOfRecords = std::unordered_map<std::string, Records>;
 class ValuesStore
 {
 public:
-    ValuesStore(const swss::DBConnector * db) : m_db(db) {};
+    ValuesStore(const swss::DBConnector * db);
     void update(const std::vector<StringPair> & dumps);
 
 private:
@@ -25,25 +30,41 @@ private:
         integer,
     };
 
+    struct CompiledPath
+    {
+        std::vector<std::string> parents; // all path elements except the last one
+        std::string key;                  // the last path element
+        std::string path;                 // canonical path, used as a field name
+        json_type type;
+    };
+
+    using CompiledPaths = std::vector<CompiledPath>;
+
     json_t * load_json(const std::string & data);
     std::vector<std::string> get_ports(json_t * root);
     std::pair<std::vector<std::string>, std::string> convert_path(const std::string & path);
+    CompiledPaths compile_paths(const std::vector<std::pair<std::string, ValuesStore::json_type>> & paths);
     json_t * traverse(json_t * root, const std::vector<std::string> & path_array, const std::string & path);
     std::string unpack_string(json_t * root, const std::string & key, const std::string & path);
     std::string unpack_boolean(json_t * root, const std::string & key, const std::string & path);
     std::string unpack_integer(json_t * root, const std::string & key, const std::string & path);
-    std::string get_value(json_t * root, const std::string & path, ValuesStore::json_type type);
-    HashOfRecords from_json(const std::vector<StringPair> & dumps);
-    std::vector<std::string> get_old_keys(const HashOfRecords & storage);
+    std::string get_value(json_t * root, const CompiledPath & path);
+    HashOfRecords from_json(const std::vector<StringPair> & dumps, std::unordered_map<std::string, size_t> & hashes);
+    std::vector<std::string> get_old_keys(const HashOfRecords & storage, const std::unordered_map<std::string, size_t> & hashes);
     void remove_keys_storage(const std::vector<std::string> & keys);
     void remove_keys_db(const std::vector<std::string> & keys);
     StringPair split_key(const std::string & key);
+    std::string get_lag_name(const std::string & key);
+    swss::Table & get_table(const std::string & table_name);
     std::vector<std::string> update_storage(const HashOfRecords & storage);
     void update_db(const HashOfRecords & storage, const std::vector<std::string> & keys_to_refresh);
     void extract_values(const std::string & lag_name, json_t * root, HashOfRecords & storage);
 
     HashOfRecords m_storage;  // our main storage
+    std::unordered_map<std::string, size_t> m_dump_hashes; // hash of the last processed dump for every LAG
     const swss::DBConnector * m_db;
+    swss::RedisPipeline m_pipeline;
+    std::unordered_map<std::string, std::unique_ptr<swss::Table>> m_tables;
 
     const std::vector<std::pair<std::string, ValuesStore::json_type>> m_lag_paths = {
         { "setup.kernel_team_mode_name", ValuesStore::json_type::string  },
@@ -70,4 +91,7 @@ private:
         { "runner.selected",                   ValuesStore::json_type::boolean },
         { "runner.state",                      ValuesStore::json_type::string  },
     };
+
+    const CompiledPaths m_compiled_lag_paths;
+    const CompiledPaths m_compiled_member_paths;
 };